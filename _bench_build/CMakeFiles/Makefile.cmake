@@ -0,0 +1,74 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/benchmark/CMakeLists.txt"
+  "/root/repo/test/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "test/CMakeFiles/foonathan_array_test.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_bitmap_set.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_chunked_reader.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_compressed_integer_set.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_flat_hash_map.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_flat_map_layout.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_flat_string_set.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_gap_buffer.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_non_temporal_copy.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_ordered_insert.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_parallel_copy.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_prefix_search.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_raw_storage.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_search_policy.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_serialization.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_small_map.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/foonathan_array_benchmark_uninitialized_growth.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_benchmark_chunked_reader.dir/chunked_reader.cpp.o"
+  "CMakeFiles/foonathan_array_benchmark_chunked_reader.dir/chunked_reader.cpp.o.d"
+  "foonathan_array_benchmark_chunked_reader"
+  "foonathan_array_benchmark_chunked_reader.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_benchmark_chunked_reader.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_benchmark_compressed_integer_set.dir/compressed_integer_set.cpp.o"
+  "CMakeFiles/foonathan_array_benchmark_compressed_integer_set.dir/compressed_integer_set.cpp.o.d"
+  "foonathan_array_benchmark_compressed_integer_set"
+  "foonathan_array_benchmark_compressed_integer_set.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_benchmark_compressed_integer_set.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_benchmark_flat_map_layout.dir/flat_map_layout.cpp.o"
+  "CMakeFiles/foonathan_array_benchmark_flat_map_layout.dir/flat_map_layout.cpp.o.d"
+  "foonathan_array_benchmark_flat_map_layout"
+  "foonathan_array_benchmark_flat_map_layout.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_benchmark_flat_map_layout.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_benchmark_flat_string_set.dir/flat_string_set.cpp.o"
+  "CMakeFiles/foonathan_array_benchmark_flat_string_set.dir/flat_string_set.cpp.o.d"
+  "foonathan_array_benchmark_flat_string_set"
+  "foonathan_array_benchmark_flat_string_set.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_benchmark_flat_string_set.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_benchmark_gap_buffer.dir/gap_buffer.cpp.o"
+  "CMakeFiles/foonathan_array_benchmark_gap_buffer.dir/gap_buffer.cpp.o.d"
+  "foonathan_array_benchmark_gap_buffer"
+  "foonathan_array_benchmark_gap_buffer.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_benchmark_gap_buffer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
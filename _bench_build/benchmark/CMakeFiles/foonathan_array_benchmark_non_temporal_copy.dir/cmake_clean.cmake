@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_benchmark_non_temporal_copy.dir/non_temporal_copy.cpp.o"
+  "CMakeFiles/foonathan_array_benchmark_non_temporal_copy.dir/non_temporal_copy.cpp.o.d"
+  "foonathan_array_benchmark_non_temporal_copy"
+  "foonathan_array_benchmark_non_temporal_copy.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_benchmark_non_temporal_copy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_benchmark_ordered_insert.dir/ordered_insert.cpp.o"
+  "CMakeFiles/foonathan_array_benchmark_ordered_insert.dir/ordered_insert.cpp.o.d"
+  "foonathan_array_benchmark_ordered_insert"
+  "foonathan_array_benchmark_ordered_insert.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_benchmark_ordered_insert.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
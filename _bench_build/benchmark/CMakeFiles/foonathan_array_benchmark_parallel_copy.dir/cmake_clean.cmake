@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_benchmark_parallel_copy.dir/parallel_copy.cpp.o"
+  "CMakeFiles/foonathan_array_benchmark_parallel_copy.dir/parallel_copy.cpp.o.d"
+  "foonathan_array_benchmark_parallel_copy"
+  "foonathan_array_benchmark_parallel_copy.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_benchmark_parallel_copy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
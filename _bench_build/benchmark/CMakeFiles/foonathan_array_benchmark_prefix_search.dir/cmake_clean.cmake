@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_benchmark_prefix_search.dir/prefix_search.cpp.o"
+  "CMakeFiles/foonathan_array_benchmark_prefix_search.dir/prefix_search.cpp.o.d"
+  "foonathan_array_benchmark_prefix_search"
+  "foonathan_array_benchmark_prefix_search.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_benchmark_prefix_search.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_benchmark_raw_storage.dir/raw_storage.cpp.o"
+  "CMakeFiles/foonathan_array_benchmark_raw_storage.dir/raw_storage.cpp.o.d"
+  "foonathan_array_benchmark_raw_storage"
+  "foonathan_array_benchmark_raw_storage.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_benchmark_raw_storage.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_benchmark_search_policy.dir/search_policy.cpp.o"
+  "CMakeFiles/foonathan_array_benchmark_search_policy.dir/search_policy.cpp.o.d"
+  "foonathan_array_benchmark_search_policy"
+  "foonathan_array_benchmark_search_policy.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_benchmark_search_policy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
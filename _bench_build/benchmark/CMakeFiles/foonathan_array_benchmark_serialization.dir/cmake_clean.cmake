@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_benchmark_serialization.dir/serialization.cpp.o"
+  "CMakeFiles/foonathan_array_benchmark_serialization.dir/serialization.cpp.o.d"
+  "foonathan_array_benchmark_serialization"
+  "foonathan_array_benchmark_serialization.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_benchmark_serialization.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
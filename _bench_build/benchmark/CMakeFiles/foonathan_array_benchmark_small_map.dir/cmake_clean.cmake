@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_benchmark_small_map.dir/small_map.cpp.o"
+  "CMakeFiles/foonathan_array_benchmark_small_map.dir/small_map.cpp.o.d"
+  "foonathan_array_benchmark_small_map"
+  "foonathan_array_benchmark_small_map.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_benchmark_small_map.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_benchmark_uninitialized_growth.dir/uninitialized_growth.cpp.o"
+  "CMakeFiles/foonathan_array_benchmark_uninitialized_growth.dir/uninitialized_growth.cpp.o.d"
+  "foonathan_array_benchmark_uninitialized_growth"
+  "foonathan_array_benchmark_uninitialized_growth.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_benchmark_uninitialized_growth.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
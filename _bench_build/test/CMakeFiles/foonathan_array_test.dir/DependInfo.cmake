@@ -0,0 +1,52 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/array.cpp" "test/CMakeFiles/foonathan_array_test.dir/array.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/array.cpp.o.d"
+  "/root/repo/test/array_view.cpp" "test/CMakeFiles/foonathan_array_test.dir/array_view.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/array_view.cpp.o.d"
+  "/root/repo/test/bag.cpp" "test/CMakeFiles/foonathan_array_test.dir/bag.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/bag.cpp.o.d"
+  "/root/repo/test/bitmap_set.cpp" "test/CMakeFiles/foonathan_array_test.dir/bitmap_set.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/bitmap_set.cpp.o.d"
+  "/root/repo/test/block_storage.cpp" "test/CMakeFiles/foonathan_array_test.dir/block_storage.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/block_storage.cpp.o.d"
+  "/root/repo/test/block_storage_allocator.cpp" "test/CMakeFiles/foonathan_array_test.dir/block_storage_allocator.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/block_storage_allocator.cpp.o.d"
+  "/root/repo/test/block_storage_embedded.cpp" "test/CMakeFiles/foonathan_array_test.dir/block_storage_embedded.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/block_storage_embedded.cpp.o.d"
+  "/root/repo/test/block_storage_external.cpp" "test/CMakeFiles/foonathan_array_test.dir/block_storage_external.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/block_storage_external.cpp.o.d"
+  "/root/repo/test/block_storage_instrumented.cpp" "test/CMakeFiles/foonathan_array_test.dir/block_storage_instrumented.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/block_storage_instrumented.cpp.o.d"
+  "/root/repo/test/block_storage_malloc.cpp" "test/CMakeFiles/foonathan_array_test.dir/block_storage_malloc.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/block_storage_malloc.cpp.o.d"
+  "/root/repo/test/block_storage_new.cpp" "test/CMakeFiles/foonathan_array_test.dir/block_storage_new.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/block_storage_new.cpp.o.d"
+  "/root/repo/test/block_storage_sbo.cpp" "test/CMakeFiles/foonathan_array_test.dir/block_storage_sbo.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/block_storage_sbo.cpp.o.d"
+  "/root/repo/test/block_view.cpp" "test/CMakeFiles/foonathan_array_test.dir/block_view.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/block_view.cpp.o.d"
+  "/root/repo/test/byte_view.cpp" "test/CMakeFiles/foonathan_array_test.dir/byte_view.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/byte_view.cpp.o.d"
+  "/root/repo/test/chunked_reader.cpp" "test/CMakeFiles/foonathan_array_test.dir/chunked_reader.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/chunked_reader.cpp.o.d"
+  "/root/repo/test/compressed_integer_set.cpp" "test/CMakeFiles/foonathan_array_test.dir/compressed_integer_set.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/compressed_integer_set.cpp.o.d"
+  "/root/repo/test/contiguous_iterator.cpp" "test/CMakeFiles/foonathan_array_test.dir/contiguous_iterator.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/contiguous_iterator.cpp.o.d"
+  "/root/repo/test/flat_hash_map.cpp" "test/CMakeFiles/foonathan_array_test.dir/flat_hash_map.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/flat_hash_map.cpp.o.d"
+  "/root/repo/test/flat_hash_set.cpp" "test/CMakeFiles/foonathan_array_test.dir/flat_hash_set.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/flat_hash_set.cpp.o.d"
+  "/root/repo/test/flat_map.cpp" "test/CMakeFiles/foonathan_array_test.dir/flat_map.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/flat_map.cpp.o.d"
+  "/root/repo/test/flat_set.cpp" "test/CMakeFiles/foonathan_array_test.dir/flat_set.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/flat_set.cpp.o.d"
+  "/root/repo/test/flat_string_set.cpp" "test/CMakeFiles/foonathan_array_test.dir/flat_string_set.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/flat_string_set.cpp.o.d"
+  "/root/repo/test/gap_buffer.cpp" "test/CMakeFiles/foonathan_array_test.dir/gap_buffer.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/gap_buffer.cpp.o.d"
+  "/root/repo/test/growth_policy.cpp" "test/CMakeFiles/foonathan_array_test.dir/growth_policy.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/growth_policy.cpp.o.d"
+  "/root/repo/test/input_view.cpp" "test/CMakeFiles/foonathan_array_test.dir/input_view.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/input_view.cpp.o.d"
+  "/root/repo/test/key_compare.cpp" "test/CMakeFiles/foonathan_array_test.dir/key_compare.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/key_compare.cpp.o.d"
+  "/root/repo/test/memory_block.cpp" "test/CMakeFiles/foonathan_array_test.dir/memory_block.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/memory_block.cpp.o.d"
+  "/root/repo/test/non_temporal_copy.cpp" "test/CMakeFiles/foonathan_array_test.dir/non_temporal_copy.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/non_temporal_copy.cpp.o.d"
+  "/root/repo/test/parallel_copy.cpp" "test/CMakeFiles/foonathan_array_test.dir/parallel_copy.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/parallel_copy.cpp.o.d"
+  "/root/repo/test/pointer_iterator.cpp" "test/CMakeFiles/foonathan_array_test.dir/pointer_iterator.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/pointer_iterator.cpp.o.d"
+  "/root/repo/test/prefix_search.cpp" "test/CMakeFiles/foonathan_array_test.dir/prefix_search.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/prefix_search.cpp.o.d"
+  "/root/repo/test/raw_storage.cpp" "test/CMakeFiles/foonathan_array_test.dir/raw_storage.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/raw_storage.cpp.o.d"
+  "/root/repo/test/serialization.cpp" "test/CMakeFiles/foonathan_array_test.dir/serialization.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/serialization.cpp.o.d"
+  "/root/repo/test/test.cpp" "test/CMakeFiles/foonathan_array_test.dir/test.cpp.o" "gcc" "test/CMakeFiles/foonathan_array_test.dir/test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
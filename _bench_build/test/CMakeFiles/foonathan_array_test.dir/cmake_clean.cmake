@@ -0,0 +1,77 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/foonathan_array_test.dir/array.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/array.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/array_view.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/array_view.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/bag.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/bag.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/bitmap_set.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/bitmap_set.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/block_storage.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/block_storage.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/block_storage_allocator.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/block_storage_allocator.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/block_storage_embedded.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/block_storage_embedded.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/block_storage_external.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/block_storage_external.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/block_storage_instrumented.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/block_storage_instrumented.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/block_storage_malloc.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/block_storage_malloc.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/block_storage_new.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/block_storage_new.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/block_storage_sbo.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/block_storage_sbo.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/block_view.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/block_view.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/byte_view.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/byte_view.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/chunked_reader.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/chunked_reader.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/compressed_integer_set.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/compressed_integer_set.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/contiguous_iterator.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/contiguous_iterator.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/flat_hash_map.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/flat_hash_map.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/flat_hash_set.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/flat_hash_set.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/flat_map.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/flat_map.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/flat_set.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/flat_set.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/flat_string_set.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/flat_string_set.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/gap_buffer.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/gap_buffer.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/growth_policy.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/growth_policy.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/input_view.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/input_view.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/key_compare.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/key_compare.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/memory_block.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/memory_block.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/non_temporal_copy.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/non_temporal_copy.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/parallel_copy.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/parallel_copy.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/pointer_iterator.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/pointer_iterator.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/prefix_search.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/prefix_search.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/raw_storage.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/raw_storage.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/serialization.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/serialization.cpp.o.d"
+  "CMakeFiles/foonathan_array_test.dir/test.cpp.o"
+  "CMakeFiles/foonathan_array_test.dir/test.cpp.o.d"
+  "foonathan_array_test"
+  "foonathan_array_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/foonathan_array_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
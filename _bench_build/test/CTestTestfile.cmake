@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_bench_build/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test "/root/repo/_bench_build/test/foonathan_array_test")
+set_tests_properties(test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;67;add_test;/root/repo/test/CMakeLists.txt;0;")
@@ -0,0 +1,64 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_BENCHMARK_HPP_INCLUDED
+#define FOONATHAN_ARRAY_BENCHMARK_HPP_INCLUDED
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace benchmark
+{
+    // prevents the compiler from optimizing the computation of the value away
+    template <typename T>
+    void do_not_optimize(const T& value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r"(&value) : "memory");
+#else
+        static volatile T sink;
+        sink = value;
+#endif
+    }
+
+    // returns n keys in [0, 2 * n) in random order
+    inline std::vector<std::uint32_t> random_keys(std::size_t n, std::uint32_t seed = 42u)
+    {
+        std::vector<std::uint32_t> keys;
+        keys.reserve(n);
+        for (auto i = 0u; i != n; ++i)
+            keys.push_back(2u * i);
+
+        std::mt19937 engine(seed);
+        std::shuffle(keys.begin(), keys.end(), engine);
+        return keys;
+    }
+
+    // calls f(i) for i in [0, iterations), takes the best of several runs
+    // and prints the time per call in nanoseconds
+    template <typename Func>
+    void run(const char* name, std::size_t iterations, Func f)
+    {
+        using clock = std::chrono::steady_clock;
+
+        auto best = std::chrono::nanoseconds::max();
+        for (auto run = 0; run != 5; ++run)
+        {
+            auto start = clock::now();
+            for (std::size_t i = 0u; i != iterations; ++i)
+                f(i);
+            auto duration =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+            best = std::min(best, duration);
+        }
+
+        std::printf("%-48s %8.2f ns\n", name, double(best.count()) / double(iterations));
+    }
+} // namespace benchmark
+
+#endif // FOONATHAN_ARRAY_BENCHMARK_HPP_INCLUDED
@@ -0,0 +1,103 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares ways of reading a large input in chunks
+
+#include <foonathan/array/chunked_reader.hpp>
+
+#include <cstring>
+#include <string>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    // reads from memory, like a file already in the page cache
+    struct memory_source
+    {
+        const byte* data;
+        size_type   remaining;
+
+        size_type operator()(byte* dest, size_type size)
+        {
+            auto n = std::min(size, remaining);
+            std::memcpy(dest, data, n);
+            data += n;
+            remaining -= n;
+            return n;
+        }
+    };
+
+    // some work for each element
+    std::uint64_t process(array_view<const std::uint64_t> chunk)
+    {
+        auto result = std::uint64_t(0);
+        for (auto value : chunk)
+            for (auto i = 0; i != 8; ++i)
+                result = (result ^ value) * 0x100000001b3u;
+        return result;
+    }
+
+    void run_all(std::size_t size, std::size_t chunk_size)
+    {
+        std::vector<std::uint64_t> input(size);
+        for (auto i = 0u; i != size; ++i)
+            input[i] = i;
+        auto source = [&] {
+            return memory_source{reinterpret_cast<const byte*>(input.data()),
+                                 size * sizeof(std::uint64_t)};
+        };
+
+        // each call reads the entire input, so the time is per input
+        auto suffix = "/" + std::to_string(size) + "/" + std::to_string(chunk_size);
+        benchmark::run(("intermediate buffer" + suffix).c_str(), 1u, [&](std::size_t) {
+            auto                       read = source();
+            std::vector<std::uint64_t> buffer(chunk_size);
+            array<std::uint64_t>       result;
+            while (auto bytes = read(reinterpret_cast<byte*>(buffer.data()),
+                                     chunk_size * sizeof(std::uint64_t)))
+                result.append_range(buffer.begin(),
+                                    buffer.begin() + std::ptrdiff_t(bytes / sizeof(std::uint64_t)));
+            benchmark::do_not_optimize(result.size());
+        });
+        benchmark::run(("read_chunked" + suffix).c_str(), 1u, [&](std::size_t) {
+            array<std::uint64_t> result;
+            read_chunked(result, make_byte_chunk_source<std::uint64_t>(source()), chunk_size);
+            benchmark::do_not_optimize(result.size());
+        });
+
+        benchmark::run(("read then process" + suffix).c_str(), 1u, [&](std::size_t) {
+            auto                 chunks = make_byte_chunk_source<std::uint64_t>(source());
+            array<std::uint64_t> buffer;
+            auto                 hash = std::uint64_t(0);
+            while (true)
+            {
+                buffer.clear();
+                buffer.append_in_place(chunk_size,
+                                       [&](partially_constructed_range<std::uint64_t>& range) {
+                                           chunks(range, chunk_size);
+                                       });
+                if (buffer.empty())
+                    break;
+                hash ^= process(buffer);
+            }
+            benchmark::do_not_optimize(hash);
+        });
+        benchmark::run(("read_chunked_double_buffered" + suffix).c_str(), 1u, [&](std::size_t) {
+            auto hash = std::uint64_t(0);
+            read_chunked_double_buffered<std::uint64_t>(
+                make_byte_chunk_source<std::uint64_t>(source()), chunk_size,
+                [&](array_view<std::uint64_t> chunk) { hash ^= process(chunk); });
+            benchmark::do_not_optimize(hash);
+        });
+    }
+} // namespace
+
+int main()
+{
+    for (auto chunk_size : {1u << 12, 1u << 16})
+        run_all(8000000u, chunk_size);
+}
@@ -0,0 +1,72 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares compressed_integer_set with flat_set
+
+#include <foonathan/array/compressed_integer_set.hpp>
+#include <foonathan/array/flat_set.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    void benchmark_sets(std::size_t size)
+    {
+        // keys are even, so the odd keys are misses
+        auto keys = benchmark::random_keys(size);
+
+        flat_set<std::uint32_t> sorted;
+        sorted.insert_range(keys.begin(), keys.end());
+        compressed_integer_set<std::uint32_t> compressed(sorted);
+
+        // every third key
+        flat_set<std::uint32_t> other;
+        for (auto i = 0u; i < 2u * size; i += 3u)
+            other.insert(i);
+        compressed_integer_set<std::uint32_t> other_compressed(other);
+
+        auto suffix = "/" + std::to_string(size);
+        std::printf("%-48s %zu bytes\n", ("flat_set memory" + suffix).c_str(),
+                    sorted.size() * sizeof(std::uint32_t));
+        std::printf("%-48s %zu bytes\n", ("compressed_integer_set memory" + suffix).c_str(),
+                    compressed.memory_size());
+
+        benchmark::run(("flat_set contains" + suffix).c_str(), 1u << 20, [&](std::size_t i) {
+            benchmark::do_not_optimize(sorted.contains(std::uint32_t(i % (2u * size))));
+        });
+        benchmark::run(("compressed_integer_set contains" + suffix).c_str(), 1u << 20,
+                       [&](std::size_t i) {
+                           benchmark::do_not_optimize(
+                               compressed.contains(std::uint32_t(i % (2u * size))));
+                       });
+
+        std::vector<std::uint32_t> result;
+        result.reserve(size);
+        benchmark::run(("flat_set intersection" + suffix).c_str(), 1u, [&](std::size_t) {
+            result.clear();
+            std::set_intersection(sorted.begin(), sorted.end(), other.begin(), other.end(),
+                                  std::back_inserter(result));
+            benchmark::do_not_optimize(result.size());
+        });
+        benchmark::run(("compressed_integer_set intersection" + suffix).c_str(), 1u,
+                       [&](std::size_t) {
+                           result.clear();
+                           compressed.intersection(other_compressed, std::back_inserter(result));
+                           benchmark::do_not_optimize(result.size());
+                       });
+    }
+} // namespace
+
+int main()
+{
+    for (auto size : {4096u, 1048576u})
+        benchmark_sets(size);
+}
@@ -0,0 +1,94 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares flat_hash_map with flat_map and std::unordered_map
+
+#include <foonathan/array/block_storage_new.hpp>
+#include <foonathan/array/flat_hash_map.hpp>
+#include <foonathan/array/flat_map.hpp>
+
+#include <string>
+#include <unordered_map>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    using hash_map = flat_hash_map<std::uint32_t, std::uint32_t>;
+    using sorted   = flat_map<std::uint32_t, std::uint32_t>;
+    using std_map  = std::unordered_map<std::uint32_t, std::uint32_t>;
+
+    void insert(hash_map& map, std::uint32_t key)
+    {
+        map.try_emplace(key, key);
+    }
+    void insert(sorted& map, std::uint32_t key)
+    {
+        map.try_emplace(key, key);
+    }
+    void insert(std_map& map, std::uint32_t key)
+    {
+        map.emplace(key, key);
+    }
+
+    template <class Map>
+    bool contains(const Map& map, std::uint32_t key)
+    {
+        return map.contains(key);
+    }
+    bool contains(const std_map& map, std::uint32_t key)
+    {
+        return map.find(key) != map.end();
+    }
+
+    template <class Map>
+    void benchmark_map(const char* name, std::size_t size)
+    {
+        // the keys are even, so odd keys are misses
+        auto keys = benchmark::random_keys(size);
+
+        Map map;
+        map.reserve(size);
+        for (auto key : keys)
+            insert(map, key);
+
+        auto full_name = std::string(name) + "/" + std::to_string(size);
+        benchmark::run((full_name + " hit").c_str(), 1u << 22, [&](std::size_t i) {
+            benchmark::do_not_optimize(contains(map, keys[i % size]));
+        });
+        benchmark::run((full_name + " miss").c_str(), 1u << 22, [&](std::size_t i) {
+            benchmark::do_not_optimize(contains(map, keys[i % size] + 1u));
+        });
+    }
+
+    template <class Map>
+    void benchmark_insert(const char* name, std::size_t size)
+    {
+        auto keys = benchmark::random_keys(size);
+
+        auto full_name = std::string(name) + "/" + std::to_string(size) + " insert";
+        benchmark::run(full_name.c_str(), 1u, [&](std::size_t) {
+            Map map;
+            for (auto key : keys)
+                insert(map, key);
+            benchmark::do_not_optimize(map.size());
+        });
+    }
+} // namespace
+
+int main()
+{
+    for (auto size : {16u, 1024u, 65536u})
+    {
+        benchmark_map<hash_map>("flat_hash_map", size);
+        benchmark_map<sorted>("flat_map", size);
+        benchmark_map<std_map>("std::unordered_map", size);
+    }
+
+    // flat_map would insert in random order, which is quadratic
+    benchmark_insert<hash_map>("flat_hash_map", 1u << 20);
+    benchmark_insert<std_map>("std::unordered_map", 1u << 20);
+}
@@ -0,0 +1,68 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares the layouts of flat_map for a lookup immediately followed by reading the value
+
+#include <foonathan/array/flat_map.hpp>
+
+#include <cstdio>
+#include <string>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    template <std::size_t Size>
+    struct value
+    {
+        std::uint32_t data[Size / sizeof(std::uint32_t)];
+
+        explicit value(std::uint32_t i)
+        {
+            for (auto& d : data)
+                d = i;
+        }
+    };
+
+    template <class Layout, std::size_t ValueSize>
+    void lookup_then_read(const char* layout, const std::vector<std::uint32_t>& keys)
+    {
+        flat_map<std::uint32_t, value<ValueSize>, key_compare_default, block_storage_default,
+                 false, Layout>
+            map;
+        map.reserve(keys.size());
+        for (auto i = 0u; i != keys.size(); ++i)
+            // insert in sorted order, so each insertion is at the end
+            map.try_emplace(2u * i, i);
+
+        auto name = std::string(layout) + "/" + std::to_string(keys.size()) + "/"
+                    + std::to_string(ValueSize) + "B";
+        benchmark::run(name.c_str(), 1u << 20, [&](std::size_t i) {
+            // look up existing keys in random order
+            auto ptr = map.try_lookup(keys[i % keys.size()]);
+            benchmark::do_not_optimize(ptr->data[0]);
+        });
+    }
+
+    template <std::size_t ValueSize>
+    void run_all(std::size_t size)
+    {
+        auto keys = benchmark::random_keys(size);
+        lookup_then_read<separate_arrays_layout, ValueSize>("separate_arrays", keys);
+        lookup_then_read<single_block_layout, ValueSize>("single_block", keys);
+        lookup_then_read<array_of_structs_layout, ValueSize>("array_of_structs", keys);
+    }
+} // namespace
+
+int main()
+{
+    for (auto size : {64u, 4096u, 1u << 20})
+    {
+        run_all<4>(size);
+        run_all<16>(size);
+        run_all<64>(size);
+    }
+}
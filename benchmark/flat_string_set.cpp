@@ -0,0 +1,90 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares flat_string_set with flat_set<std::string>
+
+#include <foonathan/array/flat_set.hpp>
+#include <foonathan/array/flat_string_set.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    std::size_t allocated_bytes = 0u;
+    std::size_t allocations     = 0u;
+} // namespace
+
+// count the allocations on the heap
+void* operator new(std::size_t size)
+{
+    allocated_bytes += size;
+    ++allocations;
+    if (auto ptr = std::malloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+    std::vector<std::string> make_strings(std::size_t size)
+    {
+        std::vector<std::string> result;
+        for (auto key : benchmark::random_keys(size))
+            // long enough to not use the small string optimization
+            result.push_back("key/" + std::to_string(key) + "/with/some/suffix");
+        return result;
+    }
+
+    template <class Set>
+    void benchmark_set(const char* name, const std::vector<std::string>& strings)
+    {
+        auto before_bytes       = allocated_bytes;
+        auto before_allocations = allocations;
+
+        Set set;
+        set.assign_range(strings.begin(), strings.end());
+
+        auto full_name = std::string(name) + "/" + std::to_string(strings.size());
+        std::printf("%-40s %zu bytes in %zu allocations\n", (full_name + " memory").c_str(),
+                    allocated_bytes - before_bytes, allocations - before_allocations);
+
+        benchmark::run((full_name + " build").c_str(), 1u, [&](std::size_t) {
+            Set set;
+            set.assign_range(strings.begin(), strings.end());
+            benchmark::do_not_optimize(set.size());
+        });
+        benchmark::run((full_name + " insert").c_str(), 1u, [&](std::size_t) {
+            Set set;
+            for (auto& str : strings)
+                set.insert(str);
+            benchmark::do_not_optimize(set.size());
+        });
+        benchmark::run((full_name + " lookup").c_str(), 1u << 20, [&](std::size_t i) {
+            benchmark::do_not_optimize(set.contains(strings[i % strings.size()]));
+        });
+    }
+} // namespace
+
+int main()
+{
+    for (auto size : {1024u, 65536u})
+    {
+        auto strings = make_strings(size);
+        benchmark_set<flat_set<std::string>>("flat_set<std::string>", strings);
+        benchmark_set<flat_string_set<>>("flat_string_set", strings);
+    }
+}
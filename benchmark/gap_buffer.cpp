@@ -0,0 +1,57 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares array and gap_buffer for text editing, where edits are clustered around a cursor
+
+#include <foonathan/array/array.hpp>
+#include <foonathan/array/gap_buffer.hpp>
+
+#include <string>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    // types a character at the cursor and occasionally deletes one or jumps somewhere else
+    template <class Buffer>
+    void edit(const char* container, std::size_t size)
+    {
+        Buffer buffer;
+        for (auto i = 0u; i != size; ++i)
+            buffer.push_back(char('a' + i % 26u));
+
+        auto cursor = size / 2u;
+        auto jumps  = benchmark::random_keys(1024u);
+
+        auto name = std::string(container) + "/" + std::to_string(size);
+        benchmark::run(name.c_str(), 1u << 16, [&](std::size_t i) {
+            if (i % 1024u == 0u)
+                // jump to a different position, the keys are in [0, 2048)
+                cursor = jumps[i / 1024u % jumps.size()] * buffer.size() / 2048u;
+
+            if (i % 8u == 7u && cursor > 0u)
+            {
+                --cursor;
+                buffer.erase(buffer.begin() + std::ptrdiff_t(cursor));
+            }
+            else
+            {
+                buffer.insert(buffer.begin() + std::ptrdiff_t(cursor), char('a' + i % 26u));
+                ++cursor;
+            }
+        });
+        benchmark::do_not_optimize(buffer.size());
+    }
+} // namespace
+
+int main()
+{
+    for (auto size : {4096u, 1u << 20})
+    {
+        edit<array<char>>("array", size);
+        edit<gap_buffer<char>>("gap_buffer", size);
+    }
+}
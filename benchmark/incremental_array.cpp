@@ -0,0 +1,72 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares array and incremental_array for the average and the worst push_back() latency
+
+#include <foonathan/array/array.hpp>
+#include <foonathan/array/incremental_array.hpp>
+
+#include <string>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    // prints the time of the slowest push_back() into an empty container,
+    // the best of several runs, so outliers from the system don't count
+    template <class Container>
+    void worst_push_back(const char* name, std::size_t size)
+    {
+        using clock = std::chrono::steady_clock;
+
+        auto best = std::chrono::nanoseconds::max();
+        for (auto run = 0; run != 5; ++run)
+        {
+            Container container;
+            auto      worst = std::chrono::nanoseconds::zero();
+            for (auto i = 0u; i != size; ++i)
+            {
+                auto start = clock::now();
+                container.push_back(i);
+                auto duration =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+                worst = std::max(worst, duration);
+            }
+            benchmark::do_not_optimize(container.back());
+            best = std::min(best, worst);
+        }
+
+        std::printf("%-48s %8.2f ns\n", name, double(best.count()));
+    }
+
+    template <class Container>
+    void run_all(const char* container, std::size_t size)
+    {
+        auto suffix = "/" + std::to_string(size);
+
+        // each call fills an empty container, so the time is per element
+        Container c;
+        benchmark::run((std::string(container) + " push_back" + suffix).c_str(), size,
+                       [&](std::size_t i) {
+                           if (i == 0u)
+                               c = Container();
+                           c.push_back(i);
+                       });
+        benchmark::do_not_optimize(c.back());
+
+        worst_push_back<Container>((std::string(container) + " worst push_back" + suffix).c_str(),
+                                   size);
+    }
+} // namespace
+
+int main()
+{
+    for (auto size : {1u << 16, 1u << 23})
+    {
+        run_all<array<std::uint64_t>>("array", size);
+        run_all<incremental_array<std::uint64_t>>("incremental_array", size);
+    }
+}
@@ -0,0 +1,105 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares relocating a big block with std::memcpy() and non-temporal stores,
+// and their effect on a workload that needs its data in the cache
+
+#include <foonathan/array/non_temporal_copy.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    // random lookups in a table that fits into the cache
+    struct hot_workload
+    {
+        std::vector<std::uint32_t> table;
+        std::vector<std::uint32_t> indices;
+
+        explicit hot_workload(std::size_t table_size)
+        : table(benchmark::random_keys(table_size)), indices(benchmark::random_keys(1u << 16, 7u))
+        {
+            for (auto& index : indices)
+                index = static_cast<std::uint32_t>(index % table_size);
+        }
+
+        std::uint32_t run() const
+        {
+            auto result = std::uint32_t(0);
+            for (auto index : indices)
+                result += table[(index + result) % table.size()];
+            return result;
+        }
+    };
+
+    template <typename Copy>
+    void run_all(const char* name, std::size_t size, const hot_workload& workload, Copy copy)
+    {
+        std::vector<char> source(size, 'a'), dest(size);
+        auto              suffix = std::string("/") + std::to_string(size >> 20) + "MiB";
+
+        // the copy alone, once the destination pages exist
+        benchmark::run((std::string(name) + suffix).c_str(), 1u, [&](std::size_t) {
+            copy(dest.data(), source.data(), size);
+            benchmark::do_not_optimize(dest.back());
+        });
+
+        // the workload right after the copy, which may have evicted its table
+        auto best = std::chrono::nanoseconds::max();
+        for (auto run = 0; run != 5; ++run)
+        {
+            benchmark::do_not_optimize(workload.run());
+            copy(dest.data(), source.data(), size);
+
+            auto start = std::chrono::steady_clock::now();
+            benchmark::do_not_optimize(workload.run());
+            best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                      std::chrono::steady_clock::now() - start));
+        }
+        std::printf("%-48s %8.2f ns\n", (std::string(name) + ", then workload" + suffix).c_str(),
+                    double(best.count()));
+
+        if (std::thread::hardware_concurrency() > 1u)
+        {
+            // the workload on another thread while copying
+            std::atomic<bool> done(false);
+            std::atomic<int>  runs(0);
+            std::thread       other([&] {
+                while (!done)
+                {
+                    benchmark::do_not_optimize(workload.run());
+                    ++runs;
+                }
+            });
+            for (auto i = 0; i != 20; ++i)
+                copy(dest.data(), source.data(), size);
+            done = true;
+            other.join();
+            auto label = std::string(name) + ", concurrent workload" + suffix;
+            std::printf("%-48s %8d runs\n", label.c_str(), runs.load());
+        }
+    }
+} // namespace
+
+int main()
+{
+    hot_workload workload(1u << 18);
+    benchmark::run("workload alone", 1u,
+                   [&](std::size_t) { benchmark::do_not_optimize(workload.run()); });
+
+    for (auto size : {std::size_t(64) << 20, std::size_t(256) << 20})
+    {
+        run_all("std::memcpy", size, workload,
+                [](void* dest, const void* src, size_type size) { std::memcpy(dest, src, size); });
+        run_all("non_temporal_copy_bytes", size, workload, &detail::non_temporal_copy_bytes);
+    }
+}
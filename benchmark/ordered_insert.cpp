@@ -0,0 +1,66 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares the ways of filling a flat_map with keys that arrive in increasing order
+
+#include <foonathan/array/flat_map.hpp>
+
+#include <algorithm>
+#include <string>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    using map_type = flat_map<std::uint32_t, std::uint64_t>;
+
+    template <typename Func>
+    void ingest(const char* method, std::size_t size, Func insert)
+    {
+        map_type map;
+        map.reserve(size);
+
+        auto name = std::string(method) + "/" + std::to_string(size);
+        benchmark::run(name.c_str(), size, [&](std::size_t i) {
+            if (i == 0u)
+                map.clear();
+            insert(map, std::uint32_t(i));
+        });
+        benchmark::do_not_optimize(map.size());
+    }
+
+    void run_all(std::size_t size)
+    {
+        ingest("try_emplace", size,
+               [](map_type& map, std::uint32_t key) { map.try_emplace(key, key); });
+        ingest("try_emplace_hint/end", size, [](map_type& map, std::uint32_t key) {
+            map.try_emplace_hint(map.end(), key, key);
+        });
+        // the hint is far away, so this does a search
+        ingest("try_emplace_hint/begin", size, [](map_type& map, std::uint32_t key) {
+            map.try_emplace_hint(map.begin(), key, key);
+        });
+
+        std::vector<std::uint32_t> keys;
+        for (auto i = 0u; i != size; ++i)
+            keys.push_back(i);
+        // appends batches of 256 keys, the time is still per key
+        ingest("append_sorted_range", size, [&](map_type& map, std::uint32_t key) {
+            if (key % 256u == 0u)
+            {
+                auto begin = keys.begin() + std::ptrdiff_t(key);
+                auto end   = begin + std::ptrdiff_t(std::min(256u, std::uint32_t(size) - key));
+                map.append_sorted_range(begin, end, begin, end);
+            }
+        });
+    }
+} // namespace
+
+int main()
+{
+    for (auto size : {4096u, 1u << 20})
+        run_all(size);
+}
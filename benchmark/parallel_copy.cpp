@@ -0,0 +1,61 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares copying a large array on one thread and split across the worker pool
+
+#define FOONATHAN_ARRAY_PARALLEL_COPY_THRESHOLD (1u << 20)
+
+#include <foonathan/array/array.hpp>
+
+#include <cstring>
+#include <string>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    struct record
+    {
+        std::uint64_t id;
+        double        values[7];
+    };
+
+    void run_all(std::size_t size)
+    {
+        array<record> source;
+        source.resize_for_overwrite(size);
+        for (auto i = 0u; i != size; ++i)
+            source[i] = record{i, {}};
+        array<record> dest;
+        dest.resize_for_overwrite(size);
+
+        // each call copies the entire array, so the time is per copy
+        auto suffix  = "/" + std::to_string(size * sizeof(record) >> 20) + "MiB";
+        auto threads = detail::worker_pool::global().no_workers() + 1u;
+        benchmark::run(("std::memcpy" + suffix).c_str(), 1u, [&](std::size_t) {
+            std::memcpy(iterator_to_pointer(dest.begin()), iterator_to_pointer(source.begin()),
+                        size * sizeof(record));
+            benchmark::do_not_optimize(dest.back());
+        });
+        benchmark::run(("copy assignment/" + std::to_string(threads) + " threads" + suffix)
+                           .c_str(),
+                       1u, [&](std::size_t) {
+                           dest = source;
+                           benchmark::do_not_optimize(dest.back());
+                       });
+        benchmark::run(("assign_range/" + std::to_string(threads) + " threads" + suffix).c_str(),
+                       1u, [&](std::size_t) {
+                           dest.assign_range(source.begin(), source.end());
+                           benchmark::do_not_optimize(dest.back());
+                       });
+    }
+} // namespace
+
+int main()
+{
+    for (auto size : {1u << 14, 1u << 20})
+        run_all(size);
+}
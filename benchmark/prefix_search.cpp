@@ -0,0 +1,63 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares prefix_search with binary_search for string keys
+
+#include <foonathan/array/flat_set.hpp>
+#include <foonathan/array/prefix_search.hpp>
+
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    template <class SearchPolicy>
+    using string_set =
+        flat_set<std::string, key_compare_default, block_storage_default, false, SearchPolicy>;
+
+    std::vector<std::string> make_strings(std::size_t size, const std::string& prefix)
+    {
+        std::vector<std::string> result;
+        for (auto key : benchmark::random_keys(size))
+        {
+            // spell the key out in letters, so the strings differ early
+            std::string str = prefix;
+            for (auto i = 0; i != 8; ++i, key >>= 4u)
+                str += char('a' + (key & 0xF));
+            result.push_back(str);
+        }
+        return result;
+    }
+
+    template <class SearchPolicy>
+    void benchmark_lookup(const char* name, const std::vector<std::string>& strings)
+    {
+        string_set<SearchPolicy> set;
+        set.insert_range(strings.begin(), strings.end());
+
+        auto full_name = std::string(name) + "/" + std::to_string(strings.size());
+        benchmark::run(full_name.c_str(), 1u << 20, [&](std::size_t i) {
+            benchmark::do_not_optimize(set.contains(strings[i % strings.size()]));
+        });
+    }
+} // namespace
+
+int main()
+{
+    for (auto size : {64u, 4096u, 65536u})
+    {
+        auto strings = make_strings(size, "");
+        benchmark_lookup<binary_search>("binary_search", strings);
+        benchmark_lookup<prefix_search<>>("prefix_search", strings);
+
+        // the prefix is the same for all keys, so every search falls back to binary search
+        auto shared = make_strings(size, "https://example.com/");
+        benchmark_lookup<binary_search>("binary_search shared prefix", shared);
+        benchmark_lookup<prefix_search<>>("prefix_search shared prefix", shared);
+    }
+}
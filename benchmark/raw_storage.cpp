@@ -0,0 +1,111 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares the uninitialized_* algorithms with constructing one element at a time
+
+#include <foonathan/array/raw_storage.hpp>
+
+#include <memory>
+#include <string>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    // a trivial type that isn't optimized by the algorithms, only by the compiler
+    struct opaque
+    {
+        std::uint32_t value;
+
+        opaque() noexcept : value(0u) {}
+        opaque(std::uint32_t value) noexcept : value(value) {}
+        opaque(const opaque& other) noexcept : value(other.value) {}
+
+        opaque& operator=(const opaque& other) noexcept
+        {
+            value = other.value;
+            return *this;
+        }
+    };
+
+    template <typename T>
+    struct buffer
+    {
+        std::unique_ptr<T[]> memory;
+        memory_block         block;
+
+        explicit buffer(std::size_t n)
+        : memory(new T[n]), block(to_raw_pointer(memory.get()), n * sizeof(T))
+        {
+        }
+    };
+
+    template <typename T, typename Source>
+    void run_all(const char* type_name, std::size_t n)
+    {
+        buffer<Source> source(n);
+        for (auto i = 0u; i != n; ++i)
+            source.memory[i] = Source(i);
+        buffer<T> dest(n);
+
+        // each call creates all n objects, so the time is per call
+        auto suffix = std::string("/") + type_name + "/" + std::to_string(n);
+        auto run    = [&](const char* name, raw_pointer (*f)(const buffer<Source>&,
+                                                             const memory_block&, std::size_t)) {
+            benchmark::run((name + suffix).c_str(), 100u, [&](std::size_t) {
+                benchmark::do_not_optimize(f(source, dest.block, n));
+            });
+        };
+
+        run("uninitialized_default_construct",
+            [](const buffer<Source>&, const memory_block& block, std::size_t n) {
+                return uninitialized_default_construct<T>(block, n);
+            });
+        run("uninitialized_value_construct",
+            [](const buffer<Source>&, const memory_block& block, std::size_t n) {
+                return uninitialized_value_construct<T>(block, n);
+            });
+        run("uninitialized_fill",
+            [](const buffer<Source>&, const memory_block& block, std::size_t n) {
+                return uninitialized_fill(block, n, T(42u));
+            });
+        run("uninitialized_copy",
+            [](const buffer<Source>& source, const memory_block& block, std::size_t n) {
+                auto begin = source.memory.get();
+                return uninitialized_copy(begin, begin + n, block);
+            });
+        run("uninitialized_move",
+            [](const buffer<Source>& source, const memory_block& block, std::size_t n) {
+                auto begin = source.memory.get();
+                return uninitialized_move(begin, begin + n, block);
+            });
+        run("uninitialized_copy_convert",
+            [](const buffer<Source>& source, const memory_block& block, std::size_t n) {
+                auto begin = source.memory.get();
+                return uninitialized_copy_convert<T>(begin, begin + n, block);
+            });
+        run("uninitialized_move_convert",
+            [](const buffer<Source>& source, const memory_block& block, std::size_t n) {
+                auto begin = source.memory.get();
+                return uninitialized_move_convert<T>(begin, begin + n, block);
+            });
+        run("uninitialized_destructive_move",
+            [](const buffer<Source>& source, const memory_block& block, std::size_t n) {
+                auto begin = source.memory.get();
+                return uninitialized_destructive_move(begin, begin + n, block);
+            });
+    }
+} // namespace
+
+int main()
+{
+    for (auto n : {1u << 10, 1u << 16})
+    {
+        run_all<std::uint32_t, std::uint32_t>("uint32", n);
+        run_all<double, std::int32_t>("int32->double", n);
+        run_all<opaque, opaque>("opaque", n);
+    }
+}
@@ -0,0 +1,111 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares the search policies of flat_set for different key distributions and access patterns
+
+#include <foonathan/array/flat_set.hpp>
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    template <class SearchPolicy>
+    using set = flat_set<std::uint64_t, key_compare_default, block_storage_default, false,
+                         SearchPolicy>;
+
+    // roughly evenly spaced timestamps with some jitter
+    std::vector<std::uint64_t> make_uniform(std::size_t size)
+    {
+        std::mt19937_64                              engine(42u);
+        std::uniform_int_distribution<std::uint64_t> jitter(1u, 1000u);
+
+        std::vector<std::uint64_t> result;
+        auto                       cur = std::uint64_t(1500000000000u);
+        for (auto i = 0u; i != size; ++i)
+            result.push_back(cur += jitter(engine));
+        return result;
+    }
+
+    // ids whose gaps grow, so most of the keys are at the beginning of the range
+    std::vector<std::uint64_t> make_skewed(std::size_t size)
+    {
+        std::vector<std::uint64_t> result;
+        for (auto i = 0u; i != size; ++i)
+            result.push_back(std::uint64_t(std::pow(double(i), 3.)) + i);
+        return result;
+    }
+
+    template <class SearchPolicy, class Query>
+    void benchmark_policy(const std::string& name, const std::vector<std::uint64_t>& keys,
+                          Query query)
+    {
+        set<SearchPolicy> s;
+        s.assign_range(keys.begin(), keys.end());
+
+        benchmark::run(name.c_str(), 1u << 20, [&](std::size_t i) {
+            benchmark::do_not_optimize(s.lower_bound(query(i)));
+        });
+    }
+
+    template <class Query>
+    void benchmark_policies(const std::string& name, const std::vector<std::uint64_t>& keys,
+                            Query query)
+    {
+        auto suffix = " " + name + "/" + std::to_string(keys.size());
+        benchmark_policy<binary_search>("binary_search" + suffix, keys, query);
+        benchmark_policy<branchless_search>("branchless_search" + suffix, keys, query);
+        benchmark_policy<interpolation_search<>>("interpolation_search" + suffix, keys, query);
+        benchmark_policy<exponential_search>("exponential_search" + suffix, keys, query);
+    }
+
+    void benchmark_hint(const std::vector<std::uint64_t>& keys)
+    {
+        set<binary_search> s;
+        s.assign_range(keys.begin(), keys.end());
+
+        // look up every key in increasing order, like a merge
+        auto suffix = " scan/" + std::to_string(keys.size());
+        benchmark::run(("lower_bound" + suffix).c_str(), 1u, [&](std::size_t) {
+            for (auto key : keys)
+                benchmark::do_not_optimize(s.lower_bound(key + 1u));
+        });
+        benchmark::run(("lower_bound hint" + suffix).c_str(), 1u, [&](std::size_t) {
+            auto hint = s.begin();
+            for (auto key : keys)
+            {
+                hint = s.lower_bound(hint, key + 1u);
+                benchmark::do_not_optimize(hint);
+            }
+        });
+    }
+} // namespace
+
+int main()
+{
+    for (auto size : {1024u, 65536u, 4194304u})
+    {
+        auto uniform = make_uniform(size);
+        auto skewed  = make_skewed(size);
+
+        // query in a scrambled order, so the cache doesn't help
+        benchmark_policies("uniform", uniform, [&](std::size_t i) {
+            return uniform[(i * 7919u) % size] + 1u;
+        });
+        benchmark_policies("skewed", skewed,
+                           [&](std::size_t i) { return skewed[(i * 7919u) % size] + 1u; });
+        // recently appended keys
+        benchmark_policies("recent", uniform, [&](std::size_t i) {
+            return uniform[size - 1u - (i * 7919u) % 16u];
+        });
+
+        benchmark_hint(uniform);
+    }
+}
@@ -0,0 +1,87 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares reloading serialized containers with a plain memcpy of the same bytes
+
+#include <foonathan/array/serialization.hpp>
+
+#include <cstring>
+#include <string>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    using map_type = flat_map<std::uint32_t, std::uint64_t>;
+
+    void run_all(std::size_t size)
+    {
+        auto suffix = "/" + std::to_string(size);
+
+        array<std::uint64_t> arr;
+        map_type             map;
+        for (auto key : benchmark::random_keys(size))
+            arr.push_back(key);
+        for (auto key = 0u; key != size; ++key)
+            map.try_emplace(2u * key, key);
+
+        memory_writer<> arr_writer, map_writer;
+        serialize(arr_writer, arr);
+        serialize(map_writer, map);
+
+        // each call reloads the entire container, so the time is per container
+        auto bytes = array_view<const byte>(arr_writer.bytes());
+        auto copy  = array<byte>(bytes);
+        benchmark::run(("memcpy" + suffix).c_str(), 1u, [&](std::size_t) {
+            std::memcpy(iterator_to_pointer(copy.begin()), bytes.data(), bytes.size());
+            benchmark::do_not_optimize(copy[size]);
+        });
+
+        benchmark::run(("array/per element" + suffix).c_str(), 1u, [&](std::size_t) {
+            memory_reader reader(bytes);
+
+            serialization_header header;
+            reader.read(reinterpret_cast<byte*>(&header), sizeof(header));
+
+            array<std::uint64_t> result;
+            for (auto i = std::uint64_t(0); i != header.size; ++i)
+                result.push_back(codec_default::read<std::uint64_t>(reader));
+            benchmark::do_not_optimize(result.size());
+        });
+        benchmark::run(("array/deserialize" + suffix).c_str(), 1u, [&](std::size_t) {
+            memory_reader reader(bytes);
+            auto          result = deserialize<array<std::uint64_t>>(reader);
+            benchmark::do_not_optimize(result.size());
+        });
+
+        benchmark::run(("flat_map/per element" + suffix).c_str(), 1u, [&](std::size_t) {
+            memory_reader reader(map_writer.bytes());
+
+            serialization_header header;
+            reader.read(reinterpret_cast<byte*>(&header), sizeof(header));
+            array<std::uint32_t> keys;
+            for (auto i = std::uint64_t(0); i != header.size; ++i)
+                keys.push_back(codec_default::read<std::uint32_t>(reader));
+
+            reader.read(reinterpret_cast<byte*>(&header), sizeof(header));
+            map_type result;
+            for (auto key : keys)
+                result.try_emplace(key, codec_default::read<std::uint64_t>(reader));
+            benchmark::do_not_optimize(result.size());
+        });
+        benchmark::run(("flat_map/deserialize" + suffix).c_str(), 1u, [&](std::size_t) {
+            memory_reader reader(map_writer.bytes());
+            auto          result = deserialize<map_type>(reader);
+            benchmark::do_not_optimize(result.size());
+        });
+    }
+} // namespace
+
+int main()
+{
+    for (auto size : {4096u, 1u << 20})
+        run_all(size);
+}
@@ -0,0 +1,106 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares the search policies of small flat_maps using a small buffer with std::unordered_map
+
+#include <foonathan/array/block_storage_new.hpp>
+#include <foonathan/array/block_storage_sbo.hpp>
+#include <foonathan/array/flat_map.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <unordered_map>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    std::size_t allocated_bytes = 0u;
+} // namespace
+
+// count the bytes allocated on the heap
+void* operator new(std::size_t size)
+{
+    allocated_bytes += size;
+    if (auto ptr = std::malloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+    using small_storage = block_storage_sbo<16 * sizeof(std::uint32_t), block_storage_new<>>;
+
+    template <class SearchPolicy>
+    using small_map = flat_map<std::uint32_t, std::uint32_t, key_compare_default, small_storage,
+                               false, separate_arrays_layout, SearchPolicy>;
+
+    template <class SearchPolicy>
+    void insert(small_map<SearchPolicy>& map, std::uint32_t key)
+    {
+        map.try_emplace(key, key);
+    }
+
+    void insert(std::unordered_map<std::uint32_t, std::uint32_t>& map, std::uint32_t key)
+    {
+        map.emplace(key, key);
+    }
+
+    template <class SearchPolicy>
+    std::uint32_t read_value(const small_map<SearchPolicy>& map, std::uint32_t key)
+    {
+        return *map.try_lookup(key);
+    }
+
+    std::uint32_t read_value(const std::unordered_map<std::uint32_t, std::uint32_t>& map,
+                             std::uint32_t                                           key)
+    {
+        return map.find(key)->second;
+    }
+
+    template <class Map>
+    void lookup(const char* name, std::size_t size)
+    {
+        auto keys = benchmark::random_keys(size);
+
+        auto before = allocated_bytes;
+        Map  map;
+        for (auto key : keys)
+            insert(map, key);
+        auto memory = sizeof(Map) + allocated_bytes - before;
+
+        auto full_name = std::string(name) + "/" + std::to_string(size) + " ("
+                         + std::to_string(memory) + " bytes)";
+        benchmark::run((full_name + " throughput").c_str(), 1u << 22, [&](std::size_t i) {
+            // look up existing keys in random order
+            benchmark::do_not_optimize(read_value(map, keys[i % size]));
+        });
+
+        auto index = std::uint32_t(0);
+        benchmark::run((full_name + " latency").c_str(), 1u << 22, [&](std::size_t) {
+            // the next key depends on the value, so the lookups can't overlap
+            index = static_cast<std::uint32_t>((index + read_value(map, keys[index]) + 1u) % size);
+        });
+        benchmark::do_not_optimize(index);
+    }
+} // namespace
+
+int main()
+{
+    for (auto size : {4u, 8u, 16u, 32u, 64u})
+    {
+        lookup<small_map<linear_search>>("linear_search", size);
+        lookup<small_map<binary_search>>("binary_search", size);
+        lookup<small_map<adaptive_search<>>>("adaptive_search", size);
+        lookup<std::unordered_map<std::uint32_t, std::uint32_t>>("std::unordered_map", size);
+    }
+}
@@ -0,0 +1,69 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// compares ways of growing a buffer that is overwritten right away, like when reading from a socket
+
+#include <foonathan/array/array.hpp>
+
+#include <cstring>
+#include <string>
+
+#include "benchmark.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    // "receives" a packet of the given size
+    void receive(void* dest, const std::vector<char>& packet)
+    {
+        std::memcpy(dest, packet.data(), packet.size());
+    }
+
+    void run_all(std::size_t packet_size)
+    {
+        std::vector<char> packet(packet_size, 'a');
+        auto              packets = (1u << 24) / packet_size;
+
+        // each call receives 16MiB into a buffer with enough capacity, so the time is per packet
+        auto suffix = "/" + std::to_string(packet_size);
+        std::vector<char> vector;
+        vector.reserve(1u << 24);
+        benchmark::run(("std::vector::resize" + suffix).c_str(), packets, [&](std::size_t i) {
+            if (i == 0u)
+                vector.clear();
+            auto old_size = vector.size();
+            vector.resize(old_size + packet_size);
+            receive(vector.data() + old_size, packet);
+        });
+        benchmark::do_not_optimize(vector.back());
+
+        array<char> arr;
+        arr.reserve(1u << 24);
+        benchmark::run(("resize_for_overwrite" + suffix).c_str(), packets, [&](std::size_t i) {
+            if (i == 0u)
+                arr.clear();
+            auto old_size = arr.size();
+            arr.resize_for_overwrite(old_size + packet_size);
+            receive(iterator_to_pointer(arr.begin()) + old_size, packet);
+        });
+        benchmark::do_not_optimize(arr.back());
+
+        benchmark::run(("grow_uninitialized" + suffix).c_str(), packets, [&](std::size_t i) {
+            if (i == 0u)
+                arr.clear();
+            arr.grow_uninitialized(packet_size, [&](const memory_block& block) {
+                receive(block.begin(), packet);
+                return packet.size();
+            });
+        });
+        benchmark::do_not_optimize(arr.back());
+    }
+} // namespace
+
+int main()
+{
+    for (auto packet_size : {1500u, 1u << 16})
+        run_all(packet_size);
+}
@@ -326,6 +326,69 @@ namespace foonathan
                                          begin, end);
             }
 
+            /// \effects Reserves memory for `n` more elements,
+            /// then calls `f(range)` with an [array::partially_constructed_range]() to that memory.
+            /// The up to `n` elements it creates are appended.
+            /// \returns The number of elements that were appended.
+            /// \throws Anything thrown by the allocation or `f`, in which case no elements are appended.
+            /// \notes This allows filling the array directly, e.g. from a file, without an intermediate buffer.
+            template <typename Func>
+            size_type append_in_place(size_type n, Func f)
+            {
+                reserve(size() + n);
+
+                partially_constructed_range<T> range(memory_block(end_, n * sizeof(T)));
+                f(range);
+
+                auto new_end = std::move(range).release();
+                auto count   = size_type(new_end - end_) / sizeof(T);
+                end_         = new_end;
+                return count;
+            }
+
+            /// \effects Changes the number of elements to `n`.
+            /// If the array is bigger, destroys the elements at the end,
+            /// otherwise appends elements created using default initialization.
+            /// \throws Anything thrown by the allocation or default constructor,
+            /// in which case no elements are appended.
+            /// \notes Unlike value initialization, default initialization leaves trivial types like `char` or `float` uninitialized,
+            /// so this does no work besides the allocation if the elements are going to be overwritten anyway.
+            void resize_for_overwrite(size_type n)
+            {
+                if (n <= size())
+                    erase_range(begin() + std::ptrdiff_t(n), end());
+                else
+                {
+                    auto count = n - size();
+                    reserve(n);
+                    end_ = uninitialized_default_construct<T>(memory_block(end_, count * sizeof(T)),
+                                                              count);
+                }
+            }
+
+            /// \effects Reserves memory for `n` more elements,
+            /// then calls `f(block)` with the [array::memory_block]() of the memory after the last element.
+            /// It writes the bytes of up to `n` elements to the beginning of the block,
+            /// and returns the number of elements it has written, which are then appended.
+            /// \returns The number of elements that were appended.
+            /// \throws Anything thrown by the allocation or `f`, in which case no elements are appended.
+            /// \requires `T` must be trivially copyable, so writing the bytes is enough to create the elements.
+            /// \notes This allows reading from a socket or decoding directly into the array,
+            /// without initializing the memory first.
+            /// Use `append_in_place()` to create other types.
+            template <typename Func>
+            size_type grow_uninitialized(size_type n, Func f)
+            {
+                static_assert(std::is_trivially_copyable<T>::value,
+                              "T must be trivially copyable, use append_in_place()");
+                reserve(size() + n);
+
+                auto count = size_type(f(memory_block(end_, n * sizeof(T))));
+                assert(count <= n);
+                end_ += count * sizeof(T);
+                return count;
+            }
+
             /// \effects Same as `insert_range(pos, block.begin(), block.end())`.
             iterator insert(const_iterator pos, array_view<const T> block)
             {
@@ -394,6 +457,49 @@ namespace foonathan
                 return iterator(iterator_tag{}, mut_begin);
             }
 
+            /// \effects Destroys and removes all elements where `pred(element)` returns `true`,
+            /// keeping the order of the remaining elements.
+            /// \returns The number of elements that were removed.
+            /// \notes `pred` is called exactly once for each element, in order.
+            /// Unlike repeated calls to `erase()`, each remaining element is moved at most once.
+            /// If `pred` or a move throws, the elements already erased are removed,
+            /// as is the element whose move threw, and the order of the others is kept.
+            template <typename Predicate>
+            size_type erase_if(Predicate pred)
+            {
+                auto view   = this->view();
+                auto dest   = view.data();
+                auto cur    = view.data();
+                auto moving = false;
+                try
+                {
+                    for (; cur != view.data_end(); ++cur)
+                    {
+                        if (pred(*cur))
+                            continue;
+
+                        if (dest != cur)
+                        {
+                            moving = true;
+                            *dest  = std::move(*cur);
+                            moving = false;
+                        }
+                        ++dest;
+                    }
+                }
+                catch (...)
+                {
+                    // [dest, cur) only contains moved-from or erased elements
+                    erase_range(iterator(iterator_tag{}, dest),
+                                iterator(iterator_tag{}, moving ? cur + 1 : cur));
+                    throw;
+                }
+
+                auto count = size_type(view.data_end() - dest);
+                erase_range(iterator(iterator_tag{}, dest), end());
+                return count;
+            }
+
             /// \effects Conceptually the same as `*this = array<T>(block)`.
             void assign(input_view<T, BlockStorage>&& block)
             {
@@ -185,6 +185,14 @@ namespace foonathan
                                 iterator_to_pointer(array_.append_range(begin, end)));
             }
 
+            /// \effects Inserts up to `n` elements created by `f` by calling `append_in_place()` on the array.
+            /// \returns The number of elements that were inserted.
+            template <typename Func>
+            size_type insert_in_place(size_type n, Func f)
+            {
+                return array_.append_in_place(n, std::move(f));
+            }
+
             /// \effects Destroys all elements.
             void clear() noexcept
             {
@@ -253,6 +261,49 @@ namespace foonathan
                 return iterator(iterator_tag{}, begin_ptr);
             }
 
+            /// \effects Destroys and removes all elements where `pred(element)` returns `true`.
+            /// \returns The number of elements that were removed.
+            /// \notes `pred` is called exactly once for each element.
+            /// Like `erase()`, a removed element is replaced by the last one,
+            /// so the order of the remaining elements changes.
+            /// If `pred` or a move throws, the elements already erased are removed.
+            template <typename Predicate>
+            size_type erase_if(Predicate pred)
+            {
+                auto view = block_view<T>(*this);
+                auto cur  = view.data();
+                auto last = view.data_end();
+                try
+                {
+                    while (cur != last)
+                    {
+                        if (pred(*cur))
+                        {
+                            // replace it by the last element, which is checked next
+                            --last;
+                            if (cur != last)
+                                *cur = std::move(*last);
+                        }
+                        else
+                            ++cur;
+                    }
+                }
+                catch (...)
+                {
+                    // [last, end) only contains moved-from or erased elements
+                    array_.erase_range(pointer_to_iterator<
+                                           typename array<T, BlockStorage>::iterator>(last),
+                                       array_.end());
+                    throw;
+                }
+
+                auto count = size_type(view.data_end() - last);
+                array_.erase_range(pointer_to_iterator<typename array<T, BlockStorage>::iterator>(
+                                       last),
+                                   array_.end());
+                return count;
+            }
+
             /// \effects Conceptually the same as `*this = bag<T>(block)`.
             void assign(input_view<T, BlockStorage>&& block)
             {
@@ -0,0 +1,567 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_BITMAP_SET_HPP_INCLUDED
+#define FOONATHAN_ARRAY_BITMAP_SET_HPP_INCLUDED
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#include <foonathan/array/array.hpp>
+#include <foonathan/array/bits.hpp>
+#include <foonathan/array/key_compare.hpp>
+
+namespace foonathan
+{
+    namespace array
+    {
+        namespace detail
+        {
+            template <class Set>
+            class bitmap_set_iterator
+            {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type        = typename Set::value_type;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = const value_type*;
+                using reference         = value_type; // keys are computed on the fly
+
+                bitmap_set_iterator() noexcept
+                : words_(nullptr), size_(0u), index_(0u), bits_(0u)
+                {
+                }
+
+                reference operator*() const noexcept
+                {
+                    return value_type(index_ * 64u + count_trailing_zeros(bits_));
+                }
+
+                bitmap_set_iterator& operator++() noexcept
+                {
+                    bits_ &= bits_ - 1u;
+                    skip_empty();
+                    return *this;
+                }
+                bitmap_set_iterator operator++(int) noexcept
+                {
+                    auto save = *this;
+                    ++*this;
+                    return save;
+                }
+
+                friend bool operator==(const bitmap_set_iterator& lhs,
+                                       const bitmap_set_iterator& rhs) noexcept
+                {
+                    return lhs.index_ == rhs.index_ && lhs.bits_ == rhs.bits_;
+                }
+                friend bool operator!=(const bitmap_set_iterator& lhs,
+                                       const bitmap_set_iterator& rhs) noexcept
+                {
+                    return !(lhs == rhs);
+                }
+
+            private:
+                // bits are the remaining keys of the word at the index
+                explicit bitmap_set_iterator(const std::uint64_t* words, size_type size,
+                                             size_type index, std::uint64_t bits) noexcept
+                : words_(words), size_(size), index_(index), bits_(bits)
+                {
+                    skip_empty();
+                }
+
+                // either points to a key or is the end iterator,
+                // where the index is the size and there are no bits
+                void skip_empty() noexcept
+                {
+                    while (bits_ == 0u && index_ != size_)
+                    {
+                        ++index_;
+                        if (index_ != size_)
+                            bits_ = words_[index_];
+                    }
+                }
+
+                const std::uint64_t* words_;
+                size_type            size_, index_;
+                std::uint64_t        bits_;
+
+                friend Set;
+            };
+        } // namespace detail
+
+        /// A set of unsigned integers stored as a bitmap.
+        ///
+        /// The key `i` is in the set if the bit `i` is set,
+        /// the bits are stored in an `array<std::uint64_t, BlockStorage>`.
+        /// This makes `contains()`, `insert()` and `erase_all()` `O(1)`
+        /// and union, intersection and difference are bitwise operations on whole words.
+        ///
+        /// It is intended for dense sets of small keys, like ids less than `2^20`,
+        /// where it requires a lot less memory than a [array::flat_set]().
+        /// The memory it requires depends on the maximal key, not the number of keys,
+        /// so it shouldn't be used for sparse sets or big keys.
+        template <typename T, class BlockStorage = block_storage_default>
+        class bitmap_set
+        {
+            static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value,
+                          "keys must be unsigned integers");
+
+        public:
+            using key_type   = T;
+            using value_type = key_type;
+
+            using block_storage = BlockStorage;
+
+            using iterator       = detail::bitmap_set_iterator<bitmap_set>;
+            using const_iterator = iterator;
+
+            //=== constructors/destructors ===//
+            /// Default constructor.
+            /// \effects Creates a set without any elements.
+            /// The block storage is initialized with default constructed arguments.
+            bitmap_set() : size_(0u) {}
+
+            /// \effects Creates a set without any elements.
+            /// The block storage is initialized with the given arguments.
+            explicit bitmap_set(typename block_storage::arg_type args) noexcept
+            : words_(std::move(args)), size_(0u)
+            {
+            }
+
+            /// \effects Creates a set containing the keys of the sorted view,
+            /// for example a [array::flat_set]().
+            /// The block storage is initialized with the given arguments.
+            explicit bitmap_set(sorted_view<const T> keys, typename block_storage::arg_type args = {})
+            : bitmap_set(std::move(args))
+            {
+                assign(keys);
+            }
+
+            bitmap_set(const bitmap_set&) = default;
+
+            bitmap_set(bitmap_set&& other) noexcept(
+                block_storage_nothrow_move<BlockStorage, std::uint64_t>{})
+            : words_(std::move(other.words_)), size_(other.size_)
+            {
+                other.size_ = 0u;
+            }
+
+            ~bitmap_set() noexcept = default;
+
+            bitmap_set& operator=(const bitmap_set&) = default;
+
+            bitmap_set& operator=(bitmap_set&& other) noexcept(
+                block_storage_nothrow_move<BlockStorage, std::uint64_t>{})
+            {
+                words_      = std::move(other.words_);
+                size_       = other.size_;
+                other.size_ = 0u;
+                return *this;
+            }
+
+            /// Swap.
+            friend void swap(bitmap_set& lhs, bitmap_set& rhs) noexcept(
+                block_storage_nothrow_move<BlockStorage, std::uint64_t>{})
+            {
+                swap(lhs.words_, rhs.words_);
+                std::swap(lhs.size_, rhs.size_);
+            }
+
+            //=== access ===//
+            const_iterator begin() const noexcept
+            {
+                return cbegin();
+            }
+            const_iterator cbegin() const noexcept
+            {
+                return words_.empty() ? end() : make_iterator(0u, words_[0u]);
+            }
+
+            const_iterator end() const noexcept
+            {
+                return cend();
+            }
+            const_iterator cend() const noexcept
+            {
+                return make_iterator(words_.size(), 0u);
+            }
+
+            /// \returns The minimal key.
+            T min() const noexcept
+            {
+                assert(!empty());
+                return *begin();
+            }
+
+            /// \returns The maximal key.
+            T max() const noexcept
+            {
+                assert(!empty());
+                auto index = words_.size() - 1u;
+                while (words_[index] == 0u)
+                    --index;
+                return T(index * 64u + 63u - detail::count_leading_zeros(words_[index]));
+            }
+
+            //=== capacity ===//
+            /// \returns Whether or not the set is empty.
+            bool empty() const noexcept
+            {
+                return size_ == 0u;
+            }
+
+            /// \returns The number of keys in the set.
+            size_type size() const noexcept
+            {
+                return size_;
+            }
+
+            /// \returns The number of keys that have a bit,
+            /// i.e. all keys less than it can be inserted without growing.
+            size_type universe() const noexcept
+            {
+                return words_.size() * 64u;
+            }
+
+            /// \returns The number of bytes used to store the keys.
+            size_type memory_size() const noexcept
+            {
+                return words_.size() * sizeof(std::uint64_t);
+            }
+
+            /// \effects Grows the bitmap, so that all keys less than `new_universe` can be inserted without growing.
+            void reserve(size_type new_universe)
+            {
+                grow((new_universe + 63u) / 64u);
+            }
+
+            /// \effects Removes the bits after the maximal key and shrinks the memory.
+            void shrink_to_fit()
+            {
+                auto last = words_.end();
+                while (last != words_.begin() && last[-1] == 0u)
+                    --last;
+                words_.erase_range(last, words_.end());
+                words_.shrink_to_fit();
+            }
+
+            //=== modifiers ===//
+            /// The result of an insert operation.
+            class insert_result
+            {
+            public:
+                /// \returns An iterator to the given key.
+                iterator iter() const noexcept
+                {
+                    return iter_;
+                }
+
+                /// \returns Whether or not the key was already present in the set.
+                bool was_duplicate() const noexcept
+                {
+                    return was_duplicate_;
+                }
+
+                /// \returns Whether or not the key was inserted into the set,
+                /// this is `!was_duplicate()`.
+                bool was_inserted() const noexcept
+                {
+                    return !was_duplicate_;
+                }
+
+            private:
+                insert_result(iterator iter, bool dup) : iter_(iter), was_duplicate_(dup) {}
+
+                iterator iter_;
+                bool     was_duplicate_;
+
+                friend bitmap_set;
+            };
+
+            /// \effects Sets the bit of the key, growing the bitmap if necessary.
+            /// \returns The result of the insert operation.
+            insert_result insert(T key)
+            {
+                grow(word_of(key) + 1u);
+
+                auto& word = words_[word_of(key)];
+                auto  dup  = (word & mask_of(key)) != 0u;
+                if (!dup)
+                {
+                    word |= mask_of(key);
+                    ++size_;
+                }
+                return {make_iterator(word_of(key), word & ~(mask_of(key) - 1u)), dup};
+            }
+
+            /// \effects Same as `insert_range(view.begin(), view.end())`.
+            void insert(const block_view<const T>& view)
+            {
+                insert_range(view.begin(), view.end());
+            }
+
+            /// \effects Inserts all keys in the range `[begin, end)`.
+            template <typename InputIt>
+            void insert_range(InputIt begin, InputIt end)
+            {
+                for (auto cur = begin; cur != end; ++cur)
+                    insert(*cur);
+            }
+
+            /// \effects Removes all keys.
+            /// \notes This does not shrink the bitmap.
+            void clear() noexcept
+            {
+                std::fill(words_.begin(), words_.end(), std::uint64_t(0));
+                size_ = 0u;
+            }
+
+            /// \effects Removes the key at the given position.
+            /// \returns An iterator after the key that was removed.
+            iterator erase(iterator pos) noexcept
+            {
+                erase_all(*pos);
+                return ++pos;
+            }
+
+            /// \effects Removes all keys in the range `[begin, end)`.
+            /// \returns An iterator after the last key that was removed.
+            iterator erase_range(iterator begin, iterator end) noexcept
+            {
+                if (begin == end)
+                    return end;
+
+                auto first = size_type(*begin);
+                auto last  = end == this->end() ? universe() : size_type(*end);
+                for (auto index = word_of(first); index * 64u < last; ++index)
+                {
+                    auto mask = ~std::uint64_t(0);
+                    if (index == word_of(first))
+                        mask &= ~(mask_of(first) - 1u);
+                    if (index == word_of(last))
+                        mask &= mask_of(last) - 1u;
+
+                    size_ -= detail::popcount(words_[index] & mask);
+                    words_[index] &= ~mask;
+                }
+                return end;
+            }
+
+            /// \effects Clears the bit of the key.
+            /// \returns Whether or not the key was removed.
+            bool erase_all(T key) noexcept
+            {
+                if (word_of(key) >= words_.size())
+                    return false;
+
+                auto& word = words_[word_of(key)];
+                if ((word & mask_of(key)) == 0u)
+                    return false;
+
+                word &= ~mask_of(key);
+                --size_;
+                return true;
+            }
+
+            /// \effects Replaces the keys with the keys of the sorted view.
+            /// As the maximal key is the last one, the bitmap is only allocated once.
+            void assign(sorted_view<const T> keys)
+            {
+                clear();
+                if (keys.empty())
+                    return;
+
+                grow(word_of(keys.back()) + 1u);
+                for (auto key : keys)
+                    words_[word_of(key)] |= mask_of(key);
+                size_ = count_bits();
+            }
+
+            //=== lookup ===//
+            /// \returns Whether or not the key is contained in the set.
+            bool contains(T key) const noexcept
+            {
+                return word_of(key) < words_.size() && (words_[word_of(key)] & mask_of(key)) != 0u;
+            }
+
+            /// \returns The number of occurences of `key` in the set, either `0` or `1`.
+            size_type count(T key) const noexcept
+            {
+                return contains(key) ? 1u : 0u;
+            }
+
+            /// \returns An iterator to the key or `end()` if there is none.
+            const_iterator find(T key) const noexcept
+            {
+                return contains(key) ? lower_bound(key) : end();
+            }
+
+            /// \returns An iterator to the first key that is not less than the given key.
+            const_iterator lower_bound(T key) const noexcept
+            {
+                if (word_of(key) >= words_.size())
+                    return end();
+                return make_iterator(word_of(key), words_[word_of(key)] & ~(mask_of(key) - 1u));
+            }
+
+            /// \returns An iterator to the first key that is greater than the given key.
+            const_iterator upper_bound(T key) const noexcept
+            {
+                if (key == std::numeric_limits<T>::max())
+                    return end();
+                return lower_bound(T(key + 1u));
+            }
+
+            /// \returns The number of keys that are less than the given key.
+            /// \notes This counts the bits of all words before it, so it is linear in the key,
+            /// but it only needs one popcount for 64 keys.
+            size_type rank(T key) const noexcept
+            {
+                auto index  = std::min(word_of(key), words_.size());
+                auto result = size_type(0);
+                for (auto i = size_type(0); i != index; ++i)
+                    result += detail::popcount(words_[i]);
+                if (index < words_.size())
+                    result += detail::popcount(words_[index] & (mask_of(key) - 1u));
+                return result;
+            }
+
+            //=== set operations ===//
+            /// \effects Inserts all keys of the other set.
+            bitmap_set& operator|=(const bitmap_set& other)
+            {
+                grow(other.words_.size());
+
+                // simple loops over the words, so the compiler can vectorize them
+                auto lhs = iterator_to_pointer(words_.begin());
+                auto rhs = iterator_to_pointer(other.words_.begin());
+                for (auto i = size_type(0); i != other.words_.size(); ++i)
+                    lhs[i] |= rhs[i];
+                size_ = count_bits();
+                return *this;
+            }
+
+            /// \effects Removes all keys that are not in the other set.
+            bitmap_set& operator&=(const bitmap_set& other) noexcept
+            {
+                auto size = std::min(words_.size(), other.words_.size());
+                auto lhs  = iterator_to_pointer(words_.begin());
+                auto rhs  = iterator_to_pointer(other.words_.begin());
+                for (auto i = size_type(0); i != size; ++i)
+                    lhs[i] &= rhs[i];
+                std::fill(words_.begin() + std::ptrdiff_t(size), words_.end(), std::uint64_t(0));
+                size_ = count_bits();
+                return *this;
+            }
+
+            /// \effects Removes all keys that are in the other set.
+            bitmap_set& operator-=(const bitmap_set& other) noexcept
+            {
+                auto size = std::min(words_.size(), other.words_.size());
+                auto lhs  = iterator_to_pointer(words_.begin());
+                auto rhs  = iterator_to_pointer(other.words_.begin());
+                for (auto i = size_type(0); i != size; ++i)
+                    lhs[i] &= ~rhs[i];
+                size_ = count_bits();
+                return *this;
+            }
+
+            /// \returns The union of both sets.
+            friend bitmap_set operator|(bitmap_set lhs, const bitmap_set& rhs)
+            {
+                lhs |= rhs;
+                return lhs;
+            }
+
+            /// \returns The intersection of both sets.
+            friend bitmap_set operator&(bitmap_set lhs, const bitmap_set& rhs)
+            {
+                lhs &= rhs;
+                return lhs;
+            }
+
+            /// \returns The keys of the first set that are not in the second set.
+            friend bitmap_set operator-(bitmap_set lhs, const bitmap_set& rhs)
+            {
+                lhs -= rhs;
+                return lhs;
+            }
+
+            /// \returns Whether or not both sets contain the same keys.
+            friend bool operator==(const bitmap_set& lhs, const bitmap_set& rhs) noexcept
+            {
+                if (lhs.size_ != rhs.size_)
+                    return false;
+
+                // the bits after the common words are all zero, as the sizes are equal
+                auto size = std::min(lhs.words_.size(), rhs.words_.size());
+                return std::equal(lhs.words_.begin(), lhs.words_.begin() + std::ptrdiff_t(size),
+                                  rhs.words_.begin());
+            }
+
+            /// \returns Whether or not both sets contain different keys.
+            friend bool operator!=(const bitmap_set& lhs, const bitmap_set& rhs) noexcept
+            {
+                return !(lhs == rhs);
+            }
+
+            //=== bulk operations ===//
+            /// \effects Writes all keys in order to the output iterator.
+            /// \returns The output iterator after the last key.
+            template <typename OutputIt>
+            OutputIt decode(OutputIt out) const
+            {
+                for (auto index = size_type(0); index != words_.size(); ++index)
+                    for (auto bits = words_[index]; bits != 0u; bits &= bits - 1u)
+                        *out++ = T(index * 64u + detail::count_trailing_zeros(bits));
+                return out;
+            }
+
+        private:
+            static size_type word_of(size_type key) noexcept
+            {
+                return key / 64u;
+            }
+
+            static std::uint64_t mask_of(size_type key) noexcept
+            {
+                return std::uint64_t(1) << (key % 64u);
+            }
+
+            const_iterator make_iterator(size_type index, std::uint64_t bits) const noexcept
+            {
+                return const_iterator(iterator_to_pointer(words_.begin()), words_.size(), index,
+                                      bits);
+            }
+
+            void grow(size_type word_count)
+            {
+                if (word_count <= words_.size())
+                    return;
+
+                words_.reserve(word_count);
+                while (words_.size() != word_count)
+                    words_.push_back(0u);
+            }
+
+            size_type count_bits() const noexcept
+            {
+                auto result = size_type(0);
+                for (auto word : words_)
+                    result += detail::popcount(word);
+                return result;
+            }
+
+            array<std::uint64_t, BlockStorage> words_;
+            size_type                          size_;
+        };
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_BITMAP_SET_HPP_INCLUDED
@@ -0,0 +1,66 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_BITS_HPP_INCLUDED
+#define FOONATHAN_ARRAY_BITS_HPP_INCLUDED
+
+#include <cassert>
+#include <cstdint>
+
+#include <foonathan/array/memory_block.hpp>
+
+namespace foonathan
+{
+    namespace array
+    {
+        namespace detail
+        {
+            inline size_type count_trailing_zeros(std::uint64_t x) noexcept
+            {
+                assert(x != 0u);
+#if defined(__GNUC__)
+                return size_type(__builtin_ctzll(x));
+#else
+                size_type result = 0u;
+                while ((x & 1u) == 0u)
+                {
+                    x >>= 1u;
+                    ++result;
+                }
+                return result;
+#endif
+            }
+
+            inline size_type count_leading_zeros(std::uint64_t x) noexcept
+            {
+                assert(x != 0u);
+#if defined(__GNUC__)
+                return size_type(__builtin_clzll(x));
+#else
+                size_type result = 0u;
+                while ((x & (std::uint64_t(1) << 63u)) == 0u)
+                {
+                    x <<= 1u;
+                    ++result;
+                }
+                return result;
+#endif
+            }
+
+            inline size_type popcount(std::uint64_t x) noexcept
+            {
+#if defined(__GNUC__)
+                return size_type(__builtin_popcountll(x));
+#else
+                x = x - ((x >> 1u) & 0x5555555555555555u);
+                x = (x & 0x3333333333333333u) + ((x >> 2u) & 0x3333333333333333u);
+                x = (x + (x >> 4u)) & 0x0F0F0F0F0F0F0F0Fu;
+                return size_type((x * 0x0101010101010101u) >> 56u);
+#endif
+            }
+        } // namespace detail
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_BITS_HPP_INCLUDED
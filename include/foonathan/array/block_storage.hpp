@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <tuple>
 
 #include <foonathan/array/block_view.hpp>
@@ -213,19 +214,53 @@ namespace foonathan
 
         namespace detail
         {
+            // assigning trivially copyable objects is the same as copying their bytes
+            template <typename T, class FwdIter>
+            using can_assign_bytes = std::integral_constant<
+                bool,
+                can_memcpy<FwdIter, T>::value
+                    && std::is_same<typename std::iterator_traits<FwdIter>::value_type, T>::value>;
+
+            template <bool Move, class ContIter, typename T>
+            auto copy_or_move_assign_impl(std::integral_constant<bool, Move>, std::true_type,
+                                          ContIter begin, ContIter end,
+                                          const block_view<T>& dest) noexcept ->
+                typename block_view<T>::iterator
+            {
+                auto src  = iterator_to_pointer(begin);
+                auto n    = end - begin;
+                auto size = size_type(n) * sizeof(T);
+                if (src + n <= dest.data() || dest.data() + n <= src)
+                    // can be done in parallel
+                    copy_bytes(dest.data(), src, size);
+                else
+                    std::memmove(dest.data(), src, size);
+                return dest.begin() + n;
+            }
             template <class FwdIter, typename T>
-            auto copy_or_move_assign(std::true_type, FwdIter begin, FwdIter end,
-                                     const block_view<T>& dest) -> typename block_view<T>::iterator
+            auto copy_or_move_assign_impl(std::true_type, std::false_type, FwdIter begin,
+                                          FwdIter end, const block_view<T>& dest) ->
+                typename block_view<T>::iterator
             {
                 return std::move(begin, end, dest.begin());
             }
             template <class FwdIter, typename T>
-            auto copy_or_move_assign(std::false_type, FwdIter begin, FwdIter end,
-                                     const block_view<T>& dest) -> typename block_view<T>::iterator
+            auto copy_or_move_assign_impl(std::false_type, std::false_type, FwdIter begin,
+                                          FwdIter end, const block_view<T>& dest) ->
+                typename block_view<T>::iterator
             {
                 return std::copy(begin, end, dest.begin());
             }
 
+            template <bool Move, class FwdIter, typename T>
+            auto copy_or_move_assign(std::integral_constant<bool, Move> move, FwdIter begin,
+                                     FwdIter end, const block_view<T>& dest) ->
+                typename block_view<T>::iterator
+            {
+                return copy_or_move_assign_impl(move, can_assign_bytes<T, FwdIter>{}, begin, end,
+                                                dest);
+            }
+
             template <typename T, class FwdIter>
             raw_pointer copy_or_move_construct(std::true_type, FwdIter begin, FwdIter end,
                                                const memory_block& dest)
@@ -291,6 +326,32 @@ namespace foonathan
             return detail::assign_impl(std::true_type{}, dest, dest_constructed, begin, end);
         }
 
+        namespace detail
+        {
+            template <typename T>
+            T* fill_assign_impl(std::true_type, T* dest, size_type n, const T& obj) noexcept
+            {
+                // trivially copyable objects can be overwritten by new ones
+                fill_trivial(dest, n, obj);
+                return dest + n;
+            }
+            template <typename T>
+            T* fill_assign_impl(std::false_type, T* dest, size_type n, const T& obj)
+            {
+                return std::fill_n(dest, std::size_t(n), obj);
+            }
+
+            template <typename T>
+            T* fill_assign(T* dest, size_type n, const T& obj)
+            {
+                return fill_assign_impl(
+                    std::integral_constant<bool,
+                                           std::is_trivially_copyable<T>::value
+                                               && std::is_trivially_copy_constructible<T>::value>{},
+                    dest, n, obj);
+            }
+        } // namespace detail
+
         /// \effects Increases the size of the block to be at least `n`,
         /// then fills it by copy constructing/assigning `obj`.
         /// \returns A view to the objects now constructed in `dest`.
@@ -305,13 +366,13 @@ namespace foonathan
             auto cur_size = dest_constructed.size();
             if (n <= cur_size)
             {
-                auto new_end = std::fill_n(dest_constructed.begin(), std::size_t(n), obj);
-                destroy_range(new_end, dest_constructed.end());
+                auto new_end = detail::fill_assign(dest_constructed.data(), n, obj);
+                destroy_range(new_end, dest_constructed.data_end());
                 return block_view<T>(dest_constructed.data(), n);
             }
             else if (n * sizeof(T) <= dest.block().size())
             {
-                std::fill_n(dest_constructed.begin(), cur_size, obj);
+                detail::fill_assign(dest_constructed.data(), cur_size, obj);
                 auto new_end =
                     uninitialized_fill(memory_block(to_raw_pointer(dest_constructed.data_end()),
                                                     dest.block().end()),
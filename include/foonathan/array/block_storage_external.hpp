@@ -0,0 +1,214 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_BLOCK_STORAGE_EXTERNAL_HPP_INCLUDED
+#define FOONATHAN_ARRAY_BLOCK_STORAGE_EXTERNAL_HPP_INCLUDED
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+#include <foonathan/array/block_storage.hpp>
+
+namespace foonathan
+{
+    namespace array
+    {
+        /// A `BlockStorage` that uses a memory block given at runtime for allocations,
+        /// then uses the `BigBlockStorage` for dynamic allocations.
+        ///
+        /// The arguments are the external [array::memory_block]() followed by the arguments of the `BigBlockStorage`.
+        /// The block can be anything like a stack array or a part of an arena,
+        /// but it is only used by one storage at a time:
+        /// The arguments returned by `arguments()` contain an empty block,
+        /// so copies of a container, moved-from containers and containers cleared with [array::clear_and_shrink]()
+        /// use the `BigBlockStorage` only.
+        ///
+        /// As the objects are not stored inside, moving a container only swaps pointers,
+        /// so **the block follows the move**:
+        /// A container move constructed, move assigned or swapped from one that uses the block
+        /// uses the block afterwards, even if it was never given to it.
+        /// Returning such a container from the scope of a stack array leaves it dangling,
+        /// copy it instead, or call `shrink_to_fit()` after it grew beyond the block.
+        /// \requires The external block must be aligned for the objects stored in it,
+        /// and outlive every container it ends up in.
+        template <class BigBlockStorage>
+        class block_storage_external
+        {
+            static_assert(!BigBlockStorage::embedded_storage::value,
+                          "BigBlockStorage must never embedded objects");
+
+        public:
+            using embedded_storage = std::false_type;
+            using arg_type = block_storage_args_t<memory_block, typename BigBlockStorage::arg_type>;
+
+            //=== constructors/destructors ===//
+            explicit block_storage_external(const arg_type& args) noexcept
+            : buffer_(std::get<0>(args.args)), big_(std::get<1>(args.args)), block_(buffer_)
+            {
+            }
+
+            block_storage_external(const block_storage_external&) = delete;
+            block_storage_external& operator=(const block_storage_external&) = delete;
+
+            ~block_storage_external() noexcept = default;
+
+            template <typename T>
+            static void swap(block_storage_external& lhs, block_view<T>& lhs_constructed,
+                             block_storage_external& rhs, block_view<T>& rhs_constructed) noexcept
+            {
+                // swap the big storages, only views of objects in them are passed
+                auto lhs_big = lhs.is_small() ? block_view<T>() : lhs_constructed;
+                auto rhs_big = rhs.is_small() ? block_view<T>() : rhs_constructed;
+                BigBlockStorage::swap(lhs.big_, lhs_big, rhs.big_, rhs_big);
+
+                // the external blocks aren't owned either, so just swap them
+                std::swap(lhs.buffer_, rhs.buffer_);
+                lhs.block_ = lhs.is_big_owning() ? lhs.big_.block() : lhs.buffer_;
+                rhs.block_ = rhs.is_big_owning() ? rhs.big_.block() : rhs.buffer_;
+
+                // no objects have been moved
+                std::swap(lhs_constructed, rhs_constructed);
+            }
+
+            //=== reserve/shrink_to_fit ===//
+            template <typename T>
+            raw_pointer reserve(size_type min_additional_bytes, const block_view<T>& constructed)
+            {
+                auto new_min_size = block_.size() + min_additional_bytes;
+                if (is_big())
+                {
+                    // make the big storage even bigger
+                    auto new_end = big_.reserve(min_additional_bytes, constructed);
+                    block_       = big_.block();
+                    return new_end;
+                }
+                else if (new_min_size <= buffer_.size())
+                {
+                    // the external block is big enough, so only move the elements to the front
+                    assert(is_aligned<T>());
+                    return move_to_front(*this, constructed).block().end();
+                }
+                else
+                    return transfer_to_big(new_min_size, constructed);
+            }
+
+            template <typename T>
+            raw_pointer shrink_to_fit(const block_view<T>& constructed)
+            {
+                if (is_small())
+                    // only moves the elements to the front
+                    return move_to_front(*this, constructed).block().end();
+                else if (constructed.size() * sizeof(T) <= buffer_.size())
+                {
+                    assert(is_aligned<T>());
+                    return transfer_to_small(constructed);
+                }
+                else
+                {
+                    // forward to the big storage
+                    auto new_end = big_.shrink_to_fit(constructed);
+                    block_       = big_.block();
+                    return new_end;
+                }
+            }
+
+            //=== accessors ===//
+            memory_block empty_block() const noexcept
+            {
+                return buffer_;
+            }
+
+            const memory_block& block() const noexcept
+            {
+                return block_;
+            }
+
+            /// \returns The arguments, but with an empty external block,
+            /// so the block isn't shared with another storage.
+            arg_type arguments() const noexcept
+            {
+                return arg_type(std::make_tuple(memory_block(), big_.arguments()));
+            }
+
+            static size_type max_size(const arg_type& args) noexcept
+            {
+                return BigBlockStorage::max_size(std::get<1>(args.args));
+            }
+
+        private:
+            // if it returns true, block_ is the external block,
+            // otherwise it is the block of the big storage
+            bool is_small() const noexcept
+            {
+                return block_.begin() == buffer_.begin();
+            }
+            bool is_big() const noexcept
+            {
+                return !is_small();
+            }
+
+            bool is_big_owning() const noexcept
+            {
+                return big_.block().begin() != big_.empty_block().begin();
+            }
+
+            template <typename T>
+            bool is_aligned() const noexcept
+            {
+                return reinterpret_cast<std::uintptr_t>(buffer_.begin()) % alignof(T) == 0u;
+            }
+
+            template <typename T>
+            raw_pointer transfer_to_big(size_type new_min_size, const block_view<T>& constructed)
+            {
+                assert(is_small());
+
+                // first we need a temporary owner for the new memory block
+                BigBlockStorage temp(big_.arguments());
+                temp.reserve(new_min_size, block_view<T>());
+
+                // then we move the elements into the temporary owner
+                auto          new_end = uninitialized_destructive_move(constructed.begin(),
+                                                              constructed.end(), temp.block());
+                block_view<T> temp_constructed(memory_block(temp.block().begin(), new_end));
+                // if anything up to this point throws, we haven't changed anything
+
+                // transfer ownership to the big storage
+                // note: this is cheap and nothrow, as it only does pointer swaps, not elements
+                block_view<T> big_constructed;
+                BigBlockStorage::swap(big_, big_constructed, temp, temp_constructed);
+
+                block_ = big_.block();
+                return to_raw_pointer(big_constructed.data_end());
+            }
+
+            template <typename T>
+            raw_pointer transfer_to_small(const block_view<T>& constructed)
+            {
+                assert(is_big());
+
+                // move the elements into the external block
+                auto new_end =
+                    uninitialized_destructive_move(constructed.begin(), constructed.end(), buffer_);
+                // if it throws, nothing has changed
+
+                // release the memory of the big storage by transferring it to a temporary
+                BigBlockStorage temp(big_.arguments());
+                block_view<T>   temp_constructed;
+                block_view<T>   big_constructed(empty, big_.block().begin());
+                BigBlockStorage::swap(big_, big_constructed, temp, temp_constructed);
+
+                block_ = buffer_;
+                return new_end;
+            }
+
+            memory_block    buffer_;
+            BigBlockStorage big_;
+            memory_block    block_; // to avoid branches
+        };
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_BLOCK_STORAGE_EXTERNAL_HPP_INCLUDED
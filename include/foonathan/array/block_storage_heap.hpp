@@ -5,6 +5,8 @@
 #ifndef FOONATHAN_ARRAY_BLOCK_STORAGE_HEAP_HPP_INCLUDED
 #define FOONATHAN_ARRAY_BLOCK_STORAGE_HEAP_HPP_INCLUDED
 
+#include <cassert>
+#include <type_traits>
 #include <utility>
 
 #include <foonathan/array/block_storage.hpp>
@@ -14,16 +16,64 @@ namespace foonathan
 {
     namespace array
     {
+        namespace detail
+        {
+            // the arguments are the handle, followed by the growth configuration, if there is one
+            template <class Heap, class GrowthPolicy,
+                      bool HasConfig = has_growth_config<GrowthPolicy>::value>
+            struct heap_args
+            {
+                using type = block_storage_args_t<typename Heap::handle_type>;
+
+                static growth_policy_config<GrowthPolicy> config(const type&) noexcept
+                {
+                    return {};
+                }
+            };
+
+            template <class Heap, class GrowthPolicy>
+            struct heap_args<Heap, GrowthPolicy, true>
+            {
+                using type = block_storage_args_t<typename Heap::handle_type,
+                                                  growth_policy_config<GrowthPolicy>>;
+
+                static growth_policy_config<GrowthPolicy> config(const type& args) noexcept
+                {
+                    return std::get<1>(args.args);
+                }
+            };
+
+            template <class Heap>
+            auto heap_try_shrink(int, typename Heap::handle_type& handle, memory_block& block,
+                                 size_type new_size, bool relocatable) noexcept
+                -> decltype(Heap::try_shrink(handle, block, new_size, relocatable))
+            {
+                return Heap::try_shrink(handle, block, new_size, relocatable);
+            }
+            template <class Heap>
+            bool heap_try_shrink(short, typename Heap::handle_type&, memory_block&, size_type,
+                                 bool) noexcept
+            {
+                return false;
+            }
+        } // namespace detail
+
         /// A `BlockStorage` that uses the given `Heap` for (de-)allocation and the given `GrowthPolicy` to control the size.
         ///
         /// It does not have a small buffer optimization.
+        /// If the `Heap` returns a bigger block than requested, the additional memory is used as well.
+        /// If the `Heap` provides `try_shrink()`, `shrink_to_fit()` uses it to avoid allocating a new block
+        /// and moving the objects one by one.
+        /// It updates the block, which may have a new address if the objects can be relocated bitwise.
+        /// The arguments are the handle of the `Heap`,
+        /// followed by the runtime configuration of the `GrowthPolicy`, if it has one.
         template <class Heap, class GrowthPolicy>
         class block_storage_heap
-        : block_storage_args_storage<block_storage_args_t<typename Heap::handle_type>>
+        : block_storage_args_storage<typename detail::heap_args<Heap, GrowthPolicy>::type>
         {
         public:
             using embedded_storage = std::false_type;
-            using arg_type         = block_storage_args_t<typename Heap::handle_type>;
+            using arg_type         = typename detail::heap_args<Heap, GrowthPolicy>::type;
 
             //=== constructors/destructors ===//
             explicit block_storage_heap(const arg_type& arg) noexcept
@@ -53,17 +103,34 @@ namespace foonathan
             template <typename T>
             raw_pointer reserve(size_type min_additional_bytes, const block_view<T>& constructed)
             {
-                auto new_size  = GrowthPolicy::growth_size(block_.size(), min_additional_bytes,
-                                                          max_size(arguments()));
-                auto new_block = allocate_block(new_size, alignof(T));
+                auto new_block = allocate_block(growth_size<T>(min_additional_bytes), alignof(T));
                 return change_block(constructed, std::move(new_block));
             }
 
+            /// \returns The size of the block `reserve()` would allocate, as determined by the `GrowthPolicy`.
+            template <typename T>
+            size_type growth_size(size_type min_additional_bytes) const noexcept
+            {
+                return grow_block_size<GrowthPolicy>(make_context<T>(), block_.size(),
+                                                     min_additional_bytes);
+            }
+
             template <typename T>
             raw_pointer shrink_to_fit(const block_view<T>& constructed)
             {
                 auto byte_size = constructed.size() * sizeof(T);
-                auto new_size  = GrowthPolicy::shrink_size(block_.size(), byte_size);
+                auto new_size =
+                    shrink_block_size<GrowthPolicy>(make_context<T>(), block_.size(), byte_size);
+
+                auto at_front = to_raw_pointer(constructed.data()) == block_.begin();
+                if (at_front && new_size >= block_.size())
+                    // nothing to do
+                    return to_raw_pointer(constructed.data_end());
+                else if (at_front && new_size != 0u && try_shrink<T>(new_size))
+                    // the heap resized the block in place or relocated the bytes,
+                    // either way block_ is the new block and the objects are at its front
+                    return block_.begin() + byte_size;
+
                 auto new_block = allocate_block(new_size, alignof(T));
                 return change_block(constructed, std::move(new_block));
             }
@@ -91,6 +158,23 @@ namespace foonathan
             }
 
         private:
+            template <typename T>
+            growth_context<Heap, GrowthPolicy> make_context() const noexcept
+            {
+                auto&& args   = this->stored_arguments();
+                auto   config = detail::heap_args<Heap, GrowthPolicy>::config(args);
+                return growth_context<Heap, GrowthPolicy>(std::get<0>(args.args), std::move(config),
+                                                          sizeof(T), alignof(T));
+            }
+
+            template <typename T>
+            bool try_shrink(size_type new_size) noexcept
+            {
+                auto&& handle = std::get<0>(this->stored_arguments().args);
+                return detail::heap_try_shrink<Heap>(0, handle, block_, new_size,
+                                                     std::is_trivially_copyable<T>::value);
+            }
+
             void deallocate_block(memory_block&& block) noexcept
             {
                 auto&& handle = std::get<0>(this->stored_arguments().args);
@@ -105,7 +189,10 @@ namespace foonathan
                 else
                 {
                     auto&& handle = std::get<0>(this->stored_arguments().args);
-                    return Heap::allocate(handle, size, alignment);
+                    auto   block  = Heap::allocate(handle, size, alignment);
+                    // the heap may return more memory, which is then used as well
+                    assert(block.size() >= size);
+                    return block;
                 }
             }
 
@@ -0,0 +1,368 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_BLOCK_STORAGE_INSTRUMENTED_HPP_INCLUDED
+#define FOONATHAN_ARRAY_BLOCK_STORAGE_INSTRUMENTED_HPP_INCLUDED
+
+#include <atomic>
+#include <utility>
+
+#include <foonathan/array/block_storage.hpp>
+#include <foonathan/array/config.hpp>
+
+namespace foonathan
+{
+    namespace array
+    {
+        //=== block_storage_event ===//
+        /// The operation of a `BlockStorage` that was instrumented.
+        enum class block_storage_operation
+        {
+            reserve,       //< A call to `reserve()`.
+            shrink_to_fit, //< A call to `shrink_to_fit()`.
+            release,       //< The destructor released a block.
+        };
+
+        /// Information about a single operation of a `BlockStorage`.
+        ///
+        /// All sizes are in bytes.
+        struct block_storage_event
+        {
+            block_storage_operation operation;
+            size_type old_capacity, new_capacity;
+            /// The additional bytes requested by `reserve()`,
+            /// or the bytes needed by the constructed objects for `shrink_to_fit()`.
+            size_type requested_bytes;
+            /// The bytes occupied by constructed objects.
+            size_type used_bytes;
+            /// The bytes of the newly allocated block, or zero if the block was reused.
+            size_type allocated_bytes;
+            /// The bytes that were released.
+            size_type freed_bytes;
+            /// The number of objects that have been moved into another block.
+            size_type relocated_objects;
+            size_type relocated_bytes;
+
+            /// \returns The capacity that isn't used by constructed objects.
+            size_type wasted_bytes() const noexcept
+            {
+                return new_capacity - used_bytes;
+            }
+        };
+
+        //=== block_storage_instrumented ===//
+        /// A `BlockStorage` that forwards to the given `BlockStorage`,
+        /// but reports each reserve, shrink and release as a [array::block_storage_event]() to the `Sink`.
+        ///
+        /// A `Sink` is a type with a `static void on_event(const block_storage_event&) noexcept` function.
+        /// The library provides [array::counting_sink](), [array::histogram_sink]() and [array::callback_sink](),
+        /// they are templated on a tag type to collect statistics per call site.
+        /// \notes Use [array::maybe_instrumented]() to only instrument if `FOONATHAN_ARRAY_INSTRUMENTATION` is enabled.
+        template <class BlockStorage, class Sink>
+        class block_storage_instrumented
+        {
+        public:
+            using embedded_storage = typename BlockStorage::embedded_storage;
+            using arg_type         = typename BlockStorage::arg_type;
+
+            //=== constructors/destructors ===//
+            explicit block_storage_instrumented(const arg_type& args) noexcept(
+                noexcept(BlockStorage(args)))
+            : storage_(args)
+            {
+            }
+
+            ~block_storage_instrumented() noexcept
+            {
+                auto& block = storage_.block();
+                if (block.begin() != storage_.empty_block().begin())
+                    Sink::on_event({block_storage_operation::release, block.size(), 0u, 0u, 0u, 0u,
+                                    block.size(), 0u, 0u});
+            }
+
+            block_storage_instrumented(const block_storage_instrumented&) = delete;
+            block_storage_instrumented& operator=(const block_storage_instrumented&) = delete;
+
+            template <typename T>
+            static void swap(block_storage_instrumented& lhs, block_view<T>& lhs_constructed,
+                             block_storage_instrumented& rhs,
+                             block_view<T>& rhs_constructed) noexcept(noexcept(
+                BlockStorage::swap(lhs.storage_, lhs_constructed, rhs.storage_, rhs_constructed)))
+            {
+                BlockStorage::swap(lhs.storage_, lhs_constructed, rhs.storage_, rhs_constructed);
+            }
+
+            //=== reserve/shrink_to_fit ===//
+            template <typename T>
+            raw_pointer reserve(size_type min_additional_bytes, const block_view<T>& constructed)
+            {
+                auto old_block = storage_.block();
+                auto result    = storage_.reserve(min_additional_bytes, constructed);
+                report(block_storage_operation::reserve, old_block, min_additional_bytes,
+                       constructed);
+                return result;
+            }
+
+            /// \returns The result of `growth_size()` of the `BlockStorage`, if it has one.
+            template <typename T>
+            auto growth_size(size_type min_additional_bytes) const noexcept
+                -> decltype(std::declval<const BlockStorage&>().template growth_size<T>(
+                    min_additional_bytes))
+            {
+                return storage_.template growth_size<T>(min_additional_bytes);
+            }
+
+            template <typename T>
+            raw_pointer shrink_to_fit(const block_view<T>& constructed)
+            {
+                auto old_block = storage_.block();
+                auto result    = storage_.shrink_to_fit(constructed);
+                report(block_storage_operation::shrink_to_fit, old_block,
+                       constructed.size() * sizeof(T), constructed);
+                return result;
+            }
+
+            //=== accessors ===//
+            memory_block empty_block() const noexcept
+            {
+                return storage_.empty_block();
+            }
+
+            const memory_block& block() const noexcept
+            {
+                return storage_.block();
+            }
+
+            auto arguments() const noexcept
+                -> decltype(std::declval<const BlockStorage&>().arguments())
+            {
+                return storage_.arguments();
+            }
+
+            static size_type max_size(const arg_type& args) noexcept
+            {
+                return BlockStorage::max_size(args);
+            }
+
+        private:
+            template <typename T>
+            void report(block_storage_operation op, const memory_block& old_block,
+                        size_type requested, const block_view<T>& constructed) noexcept
+            {
+                auto& new_block = storage_.block();
+                auto  used      = constructed.size() * sizeof(T);
+
+                block_storage_event event{op,   old_block.size(), new_block.size(), requested, used,
+                                          0u,   0u,               0u,               0u};
+                if (new_block.begin() != old_block.begin())
+                {
+                    // the objects have been moved into a different block
+                    if (new_block.begin() != storage_.empty_block().begin())
+                        event.allocated_bytes = new_block.size();
+                    if (old_block.begin() != storage_.empty_block().begin())
+                        event.freed_bytes = old_block.size();
+                    event.relocated_objects = constructed.size();
+                    event.relocated_bytes   = used;
+                }
+                else if (new_block.size() < old_block.size())
+                    // the block was shrunk in place
+                    event.freed_bytes = old_block.size() - new_block.size();
+
+                Sink::on_event(event);
+            }
+
+            BlockStorage storage_;
+        };
+
+#if FOONATHAN_ARRAY_INSTRUMENTATION
+        /// [array::block_storage_instrumented]() if `FOONATHAN_ARRAY_INSTRUMENTATION` is enabled,
+        /// `BlockStorage` itself otherwise, so there is no overhead.
+        template <class BlockStorage, class Sink>
+        using maybe_instrumented = block_storage_instrumented<BlockStorage, Sink>;
+#else
+        template <class BlockStorage, class Sink>
+        using maybe_instrumented = BlockStorage;
+#endif
+
+        //=== sinks ===//
+        /// Statistics of the operations of a `BlockStorage`.
+        ///
+        /// All sizes are in bytes.
+        struct block_storage_statistics
+        {
+            size_type reserve_calls, shrink_calls;
+            size_type allocated_bytes, freed_bytes;
+            size_type relocated_objects, relocated_bytes;
+            size_type peak_capacity, peak_wasted_bytes;
+        };
+
+        namespace detail
+        {
+            inline void atomic_max(std::atomic<size_type>& value, size_type new_value) noexcept
+            {
+                auto cur = value.load(std::memory_order_relaxed);
+                while (cur < new_value
+                       && !value.compare_exchange_weak(cur, new_value, std::memory_order_relaxed))
+                {
+                }
+            }
+        } // namespace detail
+
+        /// A `Sink` that accumulates the [array::block_storage_statistics]() in global atomic counters.
+        ///
+        /// Each `Tag` has its own counters.
+        template <class Tag = void>
+        class counting_sink
+        {
+        public:
+            static void on_event(const block_storage_event& event) noexcept
+            {
+                auto& c = get_counters();
+                if (event.operation == block_storage_operation::reserve)
+                    c.reserve_calls.fetch_add(1u, std::memory_order_relaxed);
+                else if (event.operation == block_storage_operation::shrink_to_fit)
+                    c.shrink_calls.fetch_add(1u, std::memory_order_relaxed);
+
+                c.allocated_bytes.fetch_add(event.allocated_bytes, std::memory_order_relaxed);
+                c.freed_bytes.fetch_add(event.freed_bytes, std::memory_order_relaxed);
+                c.relocated_objects.fetch_add(event.relocated_objects, std::memory_order_relaxed);
+                c.relocated_bytes.fetch_add(event.relocated_bytes, std::memory_order_relaxed);
+                detail::atomic_max(c.peak_capacity, event.new_capacity);
+                if (event.operation != block_storage_operation::release)
+                    detail::atomic_max(c.peak_wasted_bytes, event.wasted_bytes());
+            }
+
+            /// \returns A snapshot of the current statistics.
+            static block_storage_statistics statistics() noexcept
+            {
+                auto& c = get_counters();
+                return {c.reserve_calls.load(std::memory_order_relaxed),
+                        c.shrink_calls.load(std::memory_order_relaxed),
+                        c.allocated_bytes.load(std::memory_order_relaxed),
+                        c.freed_bytes.load(std::memory_order_relaxed),
+                        c.relocated_objects.load(std::memory_order_relaxed),
+                        c.relocated_bytes.load(std::memory_order_relaxed),
+                        c.peak_capacity.load(std::memory_order_relaxed),
+                        c.peak_wasted_bytes.load(std::memory_order_relaxed)};
+            }
+
+            /// \effects Resets all statistics to zero.
+            static void reset() noexcept
+            {
+                auto& c = get_counters();
+                c.reserve_calls.store(0u, std::memory_order_relaxed);
+                c.shrink_calls.store(0u, std::memory_order_relaxed);
+                c.allocated_bytes.store(0u, std::memory_order_relaxed);
+                c.freed_bytes.store(0u, std::memory_order_relaxed);
+                c.relocated_objects.store(0u, std::memory_order_relaxed);
+                c.relocated_bytes.store(0u, std::memory_order_relaxed);
+                c.peak_capacity.store(0u, std::memory_order_relaxed);
+                c.peak_wasted_bytes.store(0u, std::memory_order_relaxed);
+            }
+
+        private:
+            struct counters
+            {
+                std::atomic<size_type> reserve_calls, shrink_calls;
+                std::atomic<size_type> allocated_bytes, freed_bytes;
+                std::atomic<size_type> relocated_objects, relocated_bytes;
+                std::atomic<size_type> peak_capacity, peak_wasted_bytes;
+            };
+
+            static counters& get_counters() noexcept
+            {
+                static counters c{{0u}, {0u}, {0u}, {0u}, {0u}, {0u}, {0u}, {0u}};
+                return c;
+            }
+        };
+
+        /// A `Sink` that records a histogram of the capacities requested by `reserve()` for the current thread.
+        ///
+        /// Bucket `i` counts the reserves resulting in a capacity in `[2^(i-1), 2^i)`, bucket `0` empty blocks.
+        /// Each `Tag` has its own histogram.
+        template <class Tag = void>
+        class histogram_sink
+        {
+        public:
+            static constexpr std::size_t bucket_count = sizeof(size_type) * 8u + 1u;
+
+            struct histogram
+            {
+                size_type buckets[bucket_count];
+            };
+
+            static void on_event(const block_storage_event& event) noexcept
+            {
+                if (event.operation == block_storage_operation::reserve)
+                    ++get_histogram().buckets[bucket_of(event.new_capacity)];
+            }
+
+            /// \returns The histogram of the current thread.
+            static const histogram& local() noexcept
+            {
+                return get_histogram();
+            }
+
+            /// \effects Resets the histogram of the current thread.
+            static void reset() noexcept
+            {
+                get_histogram() = histogram{};
+            }
+
+            /// \returns The bucket of the given capacity.
+            static std::size_t bucket_of(size_type capacity) noexcept
+            {
+                std::size_t bucket = 0u;
+                while (capacity != 0u)
+                {
+                    ++bucket;
+                    capacity >>= 1u;
+                }
+                return bucket;
+            }
+
+        private:
+            static histogram& get_histogram() noexcept
+            {
+                static thread_local histogram h{};
+                return h;
+            }
+        };
+
+        template <class Tag>
+        constexpr std::size_t histogram_sink<Tag>::bucket_count;
+
+        /// A `Sink` that forwards each event to a callback set at runtime.
+        ///
+        /// Each `Tag` has its own callback.
+        template <class Tag = void>
+        class callback_sink
+        {
+        public:
+            using callback = void (*)(const block_storage_event&);
+
+            static void on_event(const block_storage_event& event) noexcept
+            {
+                auto cb = get_callback().load(std::memory_order_acquire);
+                if (cb)
+                    cb(event);
+            }
+
+            /// \effects Sets the callback, `nullptr` disables it.
+            static void set_callback(callback cb) noexcept
+            {
+                get_callback().store(cb, std::memory_order_release);
+            }
+
+        private:
+            static std::atomic<callback>& get_callback() noexcept
+            {
+                static std::atomic<callback> cb{nullptr};
+                return cb;
+            }
+        };
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_BLOCK_STORAGE_INSTRUMENTED_HPP_INCLUDED
@@ -0,0 +1,110 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_BLOCK_STORAGE_MALLOC_HPP_INCLUDED
+#define FOONATHAN_ARRAY_BLOCK_STORAGE_MALLOC_HPP_INCLUDED
+
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+#include <foonathan/array/block_storage_heap.hpp>
+#include <foonathan/array/config.hpp>
+
+#if FOONATHAN_ARRAY_MALLOC_USABLE_SIZE == 1
+#include <malloc.h>
+#elif FOONATHAN_ARRAY_MALLOC_USABLE_SIZE == 2
+#include <malloc.h>
+#elif FOONATHAN_ARRAY_MALLOC_USABLE_SIZE == 3
+#include <malloc/malloc.h>
+#endif
+
+namespace foonathan
+{
+    namespace array
+    {
+        /// A `Heap` that uses `std::malloc()`.
+        ///
+        /// Unlike [array::new_heap]() it reports the actual usable size of an allocation,
+        /// if the platform provides a way to query it (`malloc_usable_size()`, `_msize()` or `malloc_size()`).
+        /// \requires The alignment must not be bigger than `alignof(std::max_align_t)`.
+        struct malloc_heap
+        {
+            struct handle_type
+            {
+            };
+
+            static memory_block allocate(handle_type&, size_type size, size_type alignment)
+            {
+                assert(alignment <= alignof(std::max_align_t));
+                (void)alignment;
+
+                auto ptr = std::malloc(size);
+                if (!ptr)
+                    throw std::bad_alloc();
+                return {to_raw_pointer(ptr), usable_size(ptr, size)};
+            }
+
+            static void deallocate(handle_type&, memory_block&& block) noexcept
+            {
+                std::free(to_void_pointer(block.begin()));
+            }
+
+            static size_type max_size(const handle_type&) noexcept
+            {
+                return memory_block::max_size();
+            }
+
+            /// \effects Shrinks the block using `std::realloc()`.
+            /// As that might move the memory, it only does so if the objects are `relocatable`,
+            /// i.e. they can be copied bitwise.
+            /// \returns Whether or not the block was shrunk.
+            static bool try_shrink(handle_type&, memory_block& block, size_type new_size,
+                                   bool relocatable) noexcept
+            {
+                if (!relocatable)
+                    return false;
+
+                auto ptr = std::realloc(to_void_pointer(block.begin()), new_size);
+                if (!ptr)
+                    return false;
+                block = memory_block(to_raw_pointer(ptr), usable_size(ptr, new_size));
+                return true;
+            }
+
+#if FOONATHAN_ARRAY_MALLOC_USABLE_SIZE == 3
+            static size_type good_size(const handle_type&, size_type size) noexcept
+            {
+                return malloc_good_size(size);
+            }
+#endif
+
+        private:
+            static size_type usable_size(void* ptr, size_type size) noexcept
+            {
+#if FOONATHAN_ARRAY_MALLOC_USABLE_SIZE == 1
+                (void)size;
+                return malloc_usable_size(ptr);
+#elif FOONATHAN_ARRAY_MALLOC_USABLE_SIZE == 2
+                (void)size;
+                return _msize(ptr);
+#elif FOONATHAN_ARRAY_MALLOC_USABLE_SIZE == 3
+                (void)size;
+                return malloc_size(ptr);
+#else
+                (void)ptr;
+                return size;
+#endif
+            }
+        };
+
+        /// A `BlockStorage` that uses `std::malloc()` for memory allocations.
+        ///
+        /// The capacity of the block is the usable size reported by the allocator.
+        template <class GrowthPolicy = default_growth>
+        using block_storage_malloc = block_storage_heap<malloc_heap, GrowthPolicy>;
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_BLOCK_STORAGE_MALLOC_HPP_INCLUDED
@@ -52,8 +52,10 @@ namespace foonathan
         template <typename T>
         constexpr make_byte_view_t<T> byte_view(const block_view<T>& view) noexcept
         {
-            return make_byte_view_t<T>(to_raw_pointer(view.data()),
-                                       to_raw_pointer(view.data_end()));
+            // reinterpret_cast keeps the cv-qualifiers of T
+            using pointer = typename detail::select_byte_view<T>::type*;
+            return make_byte_view_t<T>(reinterpret_cast<pointer>(view.data()),
+                                       reinterpret_cast<pointer>(view.data_end()));
         }
 
         /// \returns A reinterpretation of the byte view as the given type.
@@ -0,0 +1,274 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_CHUNKED_READER_HPP_INCLUDED
+#define FOONATHAN_ARRAY_CHUNKED_READER_HPP_INCLUDED
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include <foonathan/array/array.hpp>
+#include <foonathan/array/bag.hpp>
+#include <foonathan/array/serialization.hpp>
+
+namespace foonathan
+{
+    namespace array
+    {
+        namespace detail
+        {
+            template <typename Result>
+            bool is_read_error(std::true_type /* signed */, Result result) noexcept
+            {
+                return result < 0;
+            }
+            template <typename Result>
+            bool is_read_error(std::false_type /* signed */, Result) noexcept
+            {
+                return false;
+            }
+        } // namespace detail
+
+        /// A `ChunkSource` that reads trivially copyable objects as bytes.
+        ///
+        /// A `ChunkSource` is a function object that is called with a [array::partially_constructed_range]() and a count `n`,
+        /// and creates up to `n` objects in the range.
+        /// If it creates fewer than `n`, the input has ended.
+        ///
+        /// The `ReadFunc` is called with a `byte*` and a size, like `::read()` on a file descriptor,
+        /// and returns the number of bytes written to it, or `0` if the input has ended.
+        /// A negative result, like the `-1` returned by `::read()`, signals an error.
+        template <typename T, typename ReadFunc>
+        class byte_chunk_source
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "T must be trivially copyable to be read as bytes");
+
+        public:
+            explicit byte_chunk_source(ReadFunc read) : read_(std::move(read)) {}
+
+            /// \effects Reads up to `n` objects directly into the memory of the range.
+            /// It calls the `ReadFunc` until all bytes have been read or the input has ended.
+            /// \throws [array::serialization_error]() if the input ends in the middle of an object
+            /// or the `ReadFunc` returns a negative result, or anything thrown by the `ReadFunc`.
+            void operator()(partially_constructed_range<T>& range, size_type n)
+            {
+                auto block = range.uninitialized_block();
+                assert(n * sizeof(T) <= block.size());
+
+                auto bytes = size_type(0);
+                while (bytes != n * sizeof(T))
+                {
+                    auto result = read_(block.begin() + bytes, n * sizeof(T) - bytes);
+                    if (detail::is_read_error(std::is_signed<decltype(result)>{}, result))
+                        throw serialization_error("error while reading the input");
+                    else if (result == 0u)
+                        break;
+                    bytes += size_type(result);
+                }
+
+                if (bytes % sizeof(T) != 0u)
+                    throw serialization_error("input ends in the middle of an object");
+                range.adopt_objects(bytes / sizeof(T));
+            }
+
+        private:
+            ReadFunc read_;
+        };
+
+        /// \returns A [array::byte_chunk_source]() using the given `ReadFunc`.
+        template <typename T, typename ReadFunc>
+        byte_chunk_source<T, ReadFunc> make_byte_chunk_source(ReadFunc read)
+        {
+            return byte_chunk_source<T, ReadFunc>(std::move(read));
+        }
+
+        namespace detail
+        {
+            template <typename T, class BlockStorage, class ChunkSource>
+            size_type append_chunk(array<T, BlockStorage>& arr, ChunkSource& source,
+                                   size_type chunk_size)
+            {
+                return arr.append_in_place(chunk_size,
+                                           [&](partially_constructed_range<T>& range) {
+                                               source(range, chunk_size);
+                                           });
+            }
+
+            template <typename T, class BlockStorage, class ChunkSource>
+            size_type append_chunk(bag<T, BlockStorage>& b, ChunkSource& source,
+                                   size_type chunk_size)
+            {
+                return b.insert_in_place(chunk_size, [&](partially_constructed_range<T>& range) {
+                    source(range, chunk_size);
+                });
+            }
+
+            // reads chunks into a buffer on a worker thread
+            template <typename T, class BlockStorage, class ChunkSource>
+            class chunk_reader_thread
+            {
+            public:
+                chunk_reader_thread(ChunkSource& source, size_type chunk_size)
+                : source_(source),
+                  chunk_size_(chunk_size),
+                  buffer_(nullptr),
+                  done_(false),
+                  stop_(false),
+                  thread_([this] { run(); })
+                {
+                }
+
+                chunk_reader_thread(const chunk_reader_thread&) = delete;
+                chunk_reader_thread& operator=(const chunk_reader_thread&) = delete;
+
+                // waits until the current chunk has been read
+                ~chunk_reader_thread() noexcept
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        stop_ = true;
+                    }
+                    cv_.notify_all();
+                    thread_.join();
+                }
+
+                // starts reading the next chunk into the buffer
+                void start(array<T, BlockStorage>& buffer)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        buffer_ = &buffer;
+                        done_   = false;
+                    }
+                    cv_.notify_all();
+                }
+
+                // waits until the chunk has been read, rethrows its exception
+                void wait()
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_.wait(lock, [&] { return done_; });
+                    if (error_)
+                    {
+                        auto error = error_;
+                        error_     = nullptr;
+                        std::rethrow_exception(error);
+                    }
+                }
+
+            private:
+                void run()
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    while (true)
+                    {
+                        cv_.wait(lock, [&] { return stop_ || buffer_ != nullptr; });
+                        if (stop_)
+                            return;
+
+                        auto buffer = buffer_;
+                        buffer_     = nullptr;
+                        lock.unlock();
+
+                        std::exception_ptr error;
+                        try
+                        {
+                            buffer->clear();
+                            append_chunk(*buffer, source_, chunk_size_);
+                        }
+                        catch (...)
+                        {
+                            error = std::current_exception();
+                        }
+
+                        lock.lock();
+                        error_ = error;
+                        done_  = true;
+                        cv_.notify_all();
+                    }
+                }
+
+                ChunkSource& source_;
+                size_type    chunk_size_;
+
+                std::mutex              mutex_;
+                std::condition_variable cv_;
+                array<T, BlockStorage>* buffer_;
+                std::exception_ptr      error_;
+                bool                    done_, stop_;
+
+                std::thread thread_;
+            };
+        } // namespace detail
+
+        /// \effects Appends all objects of the `ChunkSource` to the [array::array]() or [array::bag]().
+        /// Each chunk of up to `chunk_size` objects is created directly in the memory of the container,
+        /// without an intermediate buffer.
+        /// \returns The number of objects that were appended.
+        /// \throws Anything thrown by the allocation or the `ChunkSource`,
+        /// the objects of the previous chunks are still appended.
+        template <class Container, class ChunkSource>
+        size_type read_chunked(Container& container, ChunkSource&& source, size_type chunk_size)
+        {
+            assert(chunk_size > 0u);
+
+            auto total = size_type(0);
+            while (true)
+            {
+                auto count = detail::append_chunk(container, source, chunk_size);
+                total += count;
+                if (count < chunk_size)
+                    // don't reserve memory for another chunk that doesn't come
+                    break;
+            }
+            return total;
+        }
+
+        /// \effects Reads all objects of the `ChunkSource` in chunks of up to `chunk_size` objects,
+        /// and calls `f` with an [array::array_view]() to each chunk in order.
+        /// While `f` processes one chunk, the next one is read on a worker thread into a second buffer,
+        /// so the input is overlapped with the processing and only the memory for two chunks is used.
+        /// The buffers use a `BlockStorage` initialized with the given arguments.
+        /// \returns The number of objects that were read.
+        /// \throws Anything thrown by the allocation, the `ChunkSource` or `f`.
+        /// \notes The `ChunkSource` is called on a different thread than `f`,
+        /// but never concurrently.
+        template <typename T, class BlockStorage = block_storage_default, class ChunkSource,
+                  typename Func>
+        size_type read_chunked_double_buffered(ChunkSource&& source, size_type chunk_size, Func f,
+                                               typename BlockStorage::arg_type args = {})
+        {
+            assert(chunk_size > 0u);
+
+            array<T, BlockStorage> buffers[2] = {array<T, BlockStorage>(args),
+                                                 array<T, BlockStorage>(args)};
+            // destroyed before the buffers, which waits for the read in progress
+            detail::chunk_reader_thread<T, BlockStorage, typename std::decay<ChunkSource>::type>
+                reader(source, chunk_size);
+
+            auto total = size_type(0);
+            reader.start(buffers[0]);
+            for (auto cur = 0u;; cur = 1u - cur)
+            {
+                reader.wait();
+                auto& chunk = buffers[cur];
+                auto  last  = chunk.size() < chunk_size;
+                total += chunk.size();
+
+                if (!last)
+                    reader.start(buffers[1u - cur]);
+                if (!chunk.empty())
+                    f(array_view<T>(chunk));
+                if (last)
+                    break;
+            }
+            return total;
+        }
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_CHUNKED_READER_HPP_INCLUDED
@@ -0,0 +1,626 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_COMPRESSED_INTEGER_SET_HPP_INCLUDED
+#define FOONATHAN_ARRAY_COMPRESSED_INTEGER_SET_HPP_INCLUDED
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include <foonathan/array/array.hpp>
+#include <foonathan/array/key_compare.hpp>
+
+namespace foonathan
+{
+    namespace array
+    {
+        namespace detail
+        {
+            // the number of bits required to store the value
+            template <typename T>
+            unsigned bit_width(T value) noexcept
+            {
+                auto result = 0u;
+                for (; value != 0u; value >>= 1u)
+                    ++result;
+                return result;
+            }
+
+            inline size_type packed_words(size_type count, unsigned bits) noexcept
+            {
+                return (count * bits + 63u) / 64u;
+            }
+
+            // words must be zeroed
+            inline void pack_bits(std::uint64_t* words, size_type index, unsigned bits,
+                                  std::uint64_t value) noexcept
+            {
+                if (bits == 0u)
+                    return;
+
+                auto bit   = index * bits;
+                auto word  = bit / 64u;
+                auto shift = bit % 64u;
+                words[word] |= value << shift;
+                if (shift + bits > 64u)
+                    words[word + 1u] |= value >> (64u - shift);
+            }
+
+            inline std::uint64_t unpack_bits(const std::uint64_t* words, size_type index,
+                                             unsigned bits) noexcept
+            {
+                if (bits == 0u)
+                    return 0u;
+
+                auto bit    = index * bits;
+                auto word   = bit / 64u;
+                auto shift  = bit % 64u;
+                auto result = words[word] >> shift;
+                if (shift + bits > 64u)
+                    result |= words[word + 1u] << (64u - shift);
+                return bits == 64u ? result : result & ((std::uint64_t(1) << bits) - 1u);
+            }
+
+            // unpacks the 64 keys starting at the word,
+            // the recursion unrolls the loop so all shifts and masks are constants
+            template <typename T, unsigned Bits, unsigned I>
+            struct unpack_group
+            {
+                static void unpack(const std::uint64_t* words, T base, T* out) noexcept
+                {
+                    constexpr auto mask =
+                        Bits == 64u ? ~std::uint64_t(0) : (std::uint64_t(1) << (Bits % 64u)) - 1u;
+                    constexpr auto word  = I * Bits / 64u;
+                    constexpr auto shift = I * Bits % 64u;
+
+                    auto value = words[word] >> shift;
+                    if (shift + Bits > 64u)
+                        value |= words[word + 1u] << ((64u - shift) % 64u);
+                    out[I] = T(base + (value & mask));
+
+                    unpack_group<T, Bits, I + 1u>::unpack(words, base, out);
+                }
+            };
+
+            template <typename T, unsigned Bits>
+            struct unpack_group<T, Bits, 64u>
+            {
+                static void unpack(const std::uint64_t*, T, T*) noexcept {}
+            };
+
+            template <unsigned... Bits>
+            struct bit_widths
+            {
+            };
+
+            template <unsigned N, unsigned... Bits>
+            struct make_bit_widths : make_bit_widths<N - 1u, N - 1u, Bits...>
+            {
+            };
+
+            template <unsigned... Bits>
+            struct make_bit_widths<0u, Bits...>
+            {
+                using type = bit_widths<Bits...>;
+            };
+
+            template <typename T>
+            using unpack_group_fn = void (*)(const std::uint64_t*, T, T*);
+
+            // the unpack function for each bit width of T
+            template <typename T, unsigned... Bits>
+            const unpack_group_fn<T>* unpack_group_table(bit_widths<Bits...>) noexcept
+            {
+                static const unpack_group_fn<T> table[] = {&unpack_group<T, Bits, 0u>::unpack...};
+                return table;
+            }
+
+            template <typename T>
+            unpack_group_fn<T> get_unpack_group(unsigned bits) noexcept
+            {
+                using widths = typename make_bit_widths<sizeof(T) * CHAR_BIT + 1u>::type;
+                return unpack_group_table<T>(widths{})[bits];
+            }
+
+            // a block of the compressed set:
+            // the keys are stored as bit-packed offsets to the base
+            template <typename T>
+            struct compressed_block
+            {
+                T             base;
+                size_type     word_offset;
+                std::uint32_t size;
+                std::uint32_t bits;
+            };
+
+            template <class Set>
+            class compressed_set_iterator
+            {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type        = typename Set::value_type;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = const value_type*;
+                using reference         = value_type; // keys are decoded on the fly
+
+                compressed_set_iterator() noexcept : set_(nullptr), index_(0u) {}
+
+                reference operator*() const noexcept
+                {
+                    return set_->key_at(index_);
+                }
+
+                compressed_set_iterator& operator++() noexcept
+                {
+                    ++index_;
+                    return *this;
+                }
+                compressed_set_iterator operator++(int) noexcept
+                {
+                    auto save = *this;
+                    ++*this;
+                    return save;
+                }
+
+                friend bool operator==(const compressed_set_iterator& lhs,
+                                       const compressed_set_iterator& rhs) noexcept
+                {
+                    return lhs.index_ == rhs.index_;
+                }
+                friend bool operator!=(const compressed_set_iterator& lhs,
+                                       const compressed_set_iterator& rhs) noexcept
+                {
+                    return !(lhs == rhs);
+                }
+
+            private:
+                explicit compressed_set_iterator(const Set* set, size_type index) noexcept
+                : set_(set), index_(index)
+                {
+                }
+
+                const Set* set_;
+                size_type  index_;
+
+                friend Set;
+            };
+        } // namespace detail
+
+        /// A compressed, immutable sorted set of unsigned integers.
+        ///
+        /// The keys are split into blocks of `block_size` keys.
+        /// Each block stores its first key as base and the remaining keys as offsets to the base,
+        /// bit-packed using as few bits as the largest offset of the block requires.
+        /// A separate array of the maximum of each block is used to find the block of a key.
+        ///
+        /// It is intended for large, read-mostly sets, like sets of ids,
+        /// where it requires a lot less memory than a [array::flat_set]().
+        /// It can only be created from a sorted range and cannot be modified afterwards.
+        template <typename T, class BlockStorage = block_storage_default>
+        class compressed_integer_set
+        {
+            static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value,
+                          "keys must be unsigned integers");
+
+            using block = detail::compressed_block<T>;
+
+        public:
+            using key_type   = T;
+            using value_type = key_type;
+
+            using block_storage = BlockStorage;
+
+            using iterator       = detail::compressed_set_iterator<compressed_integer_set>;
+            using const_iterator = iterator;
+
+            /// The number of keys in a block.
+            static constexpr size_type block_size = 128u;
+
+            //=== constructors/destructors ===//
+            /// Default constructor.
+            /// \effects Creates a set without any elements.
+            /// The block storage is initialized with default constructed arguments.
+            compressed_integer_set() : size_(0u) {}
+
+            /// \effects Creates a set without any elements.
+            /// The block storage is initialized with the given arguments.
+            /// \notes It will be copied to initialize the three arrays.
+            explicit compressed_integer_set(typename block_storage::arg_type args) noexcept
+            : blocks_(args), maxima_(args), words_(std::move(args)), size_(0u)
+            {
+            }
+
+            /// \effects Creates a set containing the keys of the sorted view,
+            /// for example a [array::flat_set]().
+            /// Duplicate keys are only stored once.
+            /// The block storage is initialized with the given arguments.
+            explicit compressed_integer_set(sorted_view<const T> keys,
+                                            typename block_storage::arg_type args = {})
+            : compressed_integer_set(std::move(args))
+            {
+                assign(keys);
+            }
+
+            compressed_integer_set(const compressed_integer_set&) = default;
+
+            compressed_integer_set(compressed_integer_set&& other) noexcept(
+                block_storage_nothrow_move<BlockStorage, T>{})
+            : blocks_(std::move(other.blocks_)),
+              maxima_(std::move(other.maxima_)),
+              words_(std::move(other.words_)),
+              size_(other.size_)
+            {
+                other.size_ = 0u;
+            }
+
+            ~compressed_integer_set() noexcept = default;
+
+            compressed_integer_set& operator=(const compressed_integer_set&) = default;
+
+            compressed_integer_set& operator=(compressed_integer_set&& other) noexcept(
+                block_storage_nothrow_move<BlockStorage, T>{})
+            {
+                blocks_      = std::move(other.blocks_);
+                maxima_      = std::move(other.maxima_);
+                words_       = std::move(other.words_);
+                size_       = other.size_;
+                other.size_ = 0u;
+                return *this;
+            }
+
+            /// Swap.
+            friend void swap(compressed_integer_set& lhs, compressed_integer_set& rhs) noexcept(
+                block_storage_nothrow_move<BlockStorage, T>{})
+            {
+                swap(lhs.blocks_, rhs.blocks_);
+                swap(lhs.maxima_, rhs.maxima_);
+                swap(lhs.words_, rhs.words_);
+                std::swap(lhs.size_, rhs.size_);
+            }
+
+            //=== access ===//
+            const_iterator begin() const noexcept
+            {
+                return cbegin();
+            }
+            const_iterator cbegin() const noexcept
+            {
+                return const_iterator(this, 0u);
+            }
+
+            const_iterator end() const noexcept
+            {
+                return cend();
+            }
+            const_iterator cend() const noexcept
+            {
+                return const_iterator(this, size_);
+            }
+
+            /// \returns The minimal key.
+            T min() const noexcept
+            {
+                assert(!empty());
+                return blocks_.front().base;
+            }
+
+            /// \returns The maximal key.
+            T max() const noexcept
+            {
+                assert(!empty());
+                return maxima_.back();
+            }
+
+            //=== capacity ===//
+            /// \returns Whether or not the set is empty.
+            bool empty() const noexcept
+            {
+                return size_ == 0u;
+            }
+
+            /// \returns The number of keys in the set.
+            size_type size() const noexcept
+            {
+                return size_;
+            }
+
+            /// \returns The number of blocks.
+            size_type block_count() const noexcept
+            {
+                return blocks_.size();
+            }
+
+            /// \returns The number of bytes used to store the keys.
+            size_type memory_size() const noexcept
+            {
+                return blocks_.size() * (sizeof(block) + sizeof(T))
+                       + words_.size() * sizeof(std::uint64_t);
+            }
+
+            //=== modifiers ===//
+            /// \effects Destroys and removes all keys.
+            void clear() noexcept
+            {
+                blocks_.clear();
+                maxima_.clear();
+                words_.clear();
+                size_ = 0u;
+            }
+
+            /// \effects Replaces the keys with the keys of the sorted view.
+            /// Duplicate keys are only stored once.
+            /// The arrays are allocated with the exact size.
+            void assign(sorted_view<const T> keys)
+            {
+                clear();
+
+                // count everything first, so each array is only allocated once
+                auto block_count = size_type(0);
+                auto word_count  = size_type(0);
+                for_each_block(keys, [&](const T* begin, const T* end) {
+                    ++block_count;
+                    word_count += detail::packed_words(size_type(end - begin),
+                                                       detail::bit_width(T(end[-1] - *begin)));
+                });
+                blocks_.reserve(block_count);
+                maxima_.reserve(block_count);
+                words_.reserve(word_count);
+
+                for_each_block(keys, [&](const T* begin, const T* end) {
+                    auto size = size_type(end - begin);
+                    auto bits = detail::bit_width(T(end[-1] - *begin));
+
+                    auto offset = words_.size();
+                    for (auto i = detail::packed_words(size, bits); i != 0u; --i)
+                        words_.push_back(0u);
+
+                    auto words = iterator_to_pointer(words_.begin()) + offset;
+                    for (auto i = size_type(0); i != size; ++i)
+                        detail::pack_bits(words, i, bits, std::uint64_t(begin[i] - *begin));
+
+                    blocks_.push_back(
+                        block{*begin, offset, std::uint32_t(size), std::uint32_t(bits)});
+                    maxima_.push_back(end[-1]);
+                    size_ += size;
+                });
+            }
+
+            //=== lookup ===//
+            /// \returns Whether or not the key is contained in the set.
+            bool contains(T key) const noexcept
+            {
+                auto lower = lower_bound(key);
+                return lower != end() && *lower == key;
+            }
+
+            /// \returns The number of occurences of `key` in the set, either `0` or `1`.
+            size_type count(T key) const noexcept
+            {
+                return contains(key) ? 1u : 0u;
+            }
+
+            /// \returns An iterator to the first key that is not less than the given key.
+            const_iterator lower_bound(T key) const noexcept
+            {
+                auto block_iter = std::lower_bound(maxima_.begin(), maxima_.end(), key);
+                if (block_iter == maxima_.end())
+                    return end();
+
+                auto  index = size_type(block_iter - maxima_.begin());
+                auto& b     = blocks_[index];
+                if (key <= b.base)
+                    return const_iterator(this, index * block_size);
+
+                // binary search for the offset in the block,
+                // the last key is not less than the searched key
+                auto offset = std::uint64_t(key - b.base);
+                auto words  = block_words(b);
+                auto begin  = size_type(1);
+                auto length = size_type(b.size - 1u);
+                while (length != 0u)
+                {
+                    auto half = length / 2u;
+                    if (detail::unpack_bits(words, begin + half, b.bits) < offset)
+                    {
+                        begin += half + 1u;
+                        length -= half + 1u;
+                    }
+                    else
+                        length = half;
+                }
+                return const_iterator(this, index * block_size + begin);
+            }
+
+            //=== bulk operations ===//
+            /// \effects Decodes all keys in order and writes them to the output iterator.
+            /// \returns The output iterator after the last key.
+            template <typename OutputIt>
+            OutputIt decode(OutputIt out) const
+            {
+                T buffer[block_size];
+                for (auto i = size_type(0); i != blocks_.size(); ++i)
+                {
+                    auto size = decode_block(i, buffer);
+                    out       = std::copy(buffer, buffer + size, out);
+                }
+                return out;
+            }
+
+            /// \effects Writes all keys that are in both sets in order to the output iterator.
+            /// Only the blocks whose ranges overlap are decoded.
+            /// \returns The output iterator after the last key.
+            template <typename OutputIt>
+            OutputIt intersection(const compressed_integer_set& other, OutputIt out) const
+            {
+                T lhs_buffer[block_size], rhs_buffer[block_size];
+
+                // the next block to decode and the remaining keys of the decoded one
+                auto        lhs = size_type(0), rhs = size_type(0);
+                const auto* lhs_cur = lhs_buffer;
+                const auto* lhs_end = lhs_buffer;
+                const auto* rhs_cur = rhs_buffer;
+                const auto* rhs_end = rhs_buffer;
+                while (true)
+                {
+                    if (lhs_cur == lhs_end)
+                    {
+                        // skip all blocks that end before the current key of the other set
+                        if (rhs_cur != rhs_end)
+                            while (lhs != blocks_.size() && maxima_[lhs] < *rhs_cur)
+                                ++lhs;
+                        if (lhs == blocks_.size())
+                            break;
+
+                        lhs_cur = lhs_buffer;
+                        lhs_end = lhs_buffer + decode_block(lhs++, lhs_buffer);
+                    }
+                    if (rhs_cur == rhs_end)
+                    {
+                        while (rhs != other.blocks_.size() && other.maxima_[rhs] < *lhs_cur)
+                            ++rhs;
+                        if (rhs == other.blocks_.size())
+                            break;
+
+                        rhs_cur = rhs_buffer;
+                        rhs_end = rhs_buffer + other.decode_block(rhs++, rhs_buffer);
+                    }
+
+                    // merge until one block is exhausted
+                    while (lhs_cur != lhs_end && rhs_cur != rhs_end)
+                    {
+                        if (*lhs_cur < *rhs_cur)
+                            ++lhs_cur;
+                        else if (*rhs_cur < *lhs_cur)
+                            ++rhs_cur;
+                        else
+                        {
+                            *out++ = *lhs_cur;
+                            ++lhs_cur;
+                            ++rhs_cur;
+                        }
+                    }
+                }
+                return out;
+            }
+
+            /// \effects Writes all keys that are in both the set and the sorted view in order to the output iterator.
+            /// Only the blocks that overlap with the keys of the view are decoded.
+            /// \returns The output iterator after the last key.
+            template <typename OutputIt>
+            OutputIt intersection(sorted_view<const T> keys, OutputIt out) const
+            {
+                T buffer[block_size];
+
+                auto cur = keys.begin();
+                for (auto i = size_type(0); i != blocks_.size() && cur != keys.end(); ++i)
+                {
+                    cur = std::lower_bound(cur, keys.end(), blocks_[i].base);
+                    if (cur == keys.end() || maxima_[i] < *cur)
+                        // no key of the view in this block
+                        continue;
+
+                    auto last = std::upper_bound(cur, keys.end(), maxima_[i]);
+                    auto size = decode_block(i, buffer);
+                    out       = std::set_intersection(buffer, buffer + size, cur, last, out);
+                    cur       = last;
+                }
+                return out;
+            }
+
+        private:
+            const std::uint64_t* block_words(const block& b) const noexcept
+            {
+                return iterator_to_pointer(words_.begin()) + b.word_offset;
+            }
+
+            T key_at(size_type index) const noexcept
+            {
+                assert(index < size_);
+                auto& b = blocks_[index / block_size];
+                return T(b.base + detail::unpack_bits(block_words(b), index % block_size, b.bits));
+            }
+
+            // decodes the block into the buffer, returns the number of keys
+            size_type decode_block(size_type index, T* buffer) const noexcept
+            {
+                // copy to locals, the writes to the buffer could alias the block otherwise
+                auto& b     = blocks_[index];
+                auto  words = block_words(b);
+                auto  base  = b.base;
+                auto  size  = size_type(b.size);
+                auto  bits  = size_type(b.bits);
+                if (bits == 0u)
+                {
+                    std::fill(buffer, buffer + size, base);
+                    return size;
+                }
+
+                else if (size == block_size)
+                {
+                    // a full block are two groups of 64 keys, each taking bits words
+                    static_assert(block_size == 128u, "update this code");
+                    auto unpack = detail::get_unpack_group<T>(unsigned(bits));
+                    unpack(words, base, buffer);
+                    unpack(words + bits, base, buffer + 64u);
+                    return size;
+                }
+
+                // read the bits sequentially instead of unpacking each position
+                auto mask = bits == 64u ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1u;
+                auto bit  = size_type(0);
+                for (auto i = size_type(0); i != size; ++i, bit += bits)
+                {
+                    auto word  = bit / 64u;
+                    auto shift = bit % 64u;
+                    auto value = words[word] >> shift;
+                    if (shift + bits > 64u)
+                        value |= words[word + 1u] << (64u - shift);
+                    buffer[i] = T(base + (value & mask));
+                }
+                return size;
+            }
+
+            // calls f with the range of each block of unique keys
+            template <typename Func>
+            static void for_each_block(sorted_view<const T> keys, Func f)
+            {
+                T    buffer[block_size];
+                auto size  = size_type(0);
+                auto first = true;
+                auto last  = T(0);
+                for (auto key : keys)
+                {
+                    if (!first && key == last)
+                        continue;
+                    first = false;
+                    last  = key;
+
+                    buffer[size++] = key;
+                    if (size == block_size)
+                    {
+                        f(static_cast<const T*>(buffer), static_cast<const T*>(buffer + size));
+                        size = 0u;
+                    }
+                }
+                if (size != 0u)
+                    f(static_cast<const T*>(buffer), static_cast<const T*>(buffer + size));
+            }
+
+            array<block, BlockStorage>         blocks_;
+            array<T, BlockStorage>             maxima_;
+            array<std::uint64_t, BlockStorage> words_;
+            size_type                          size_;
+
+            friend iterator;
+        };
+
+        template <typename T, class BlockStorage>
+        constexpr size_type compressed_integer_set<T, BlockStorage>::block_size;
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_COMPRESSED_INTEGER_SET_HPP_INCLUDED
@@ -39,4 +39,54 @@
 
 #endif
 
+#ifndef FOONATHAN_ARRAY_MALLOC_USABLE_SIZE
+
+#if defined(__GLIBC__) || defined(__ANDROID__) || defined(__FreeBSD__)
+/// \exclude
+#define FOONATHAN_ARRAY_MALLOC_USABLE_SIZE 1
+#elif defined(_WIN32)
+/// \exclude
+#define FOONATHAN_ARRAY_MALLOC_USABLE_SIZE 2
+#elif defined(__APPLE__)
+/// \exclude
+#define FOONATHAN_ARRAY_MALLOC_USABLE_SIZE 3
+#else
+/// \exclude
+#define FOONATHAN_ARRAY_MALLOC_USABLE_SIZE 0
+#endif
+
+#endif
+
+#ifndef FOONATHAN_ARRAY_INSTRUMENTATION
+/// \exclude
+#define FOONATHAN_ARRAY_INSTRUMENTATION 0
+#endif
+
+#ifndef FOONATHAN_ARRAY_HAS_SSE2
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+/// \exclude
+#define FOONATHAN_ARRAY_HAS_SSE2 1
+#else
+/// \exclude
+#define FOONATHAN_ARRAY_HAS_SSE2 0
+#endif
+
+#endif
+
+#ifndef FOONATHAN_ARRAY_PARALLEL_COPY_THRESHOLD
+/// \exclude
+#define FOONATHAN_ARRAY_PARALLEL_COPY_THRESHOLD 0
+#endif
+
+#ifndef FOONATHAN_ARRAY_NON_TEMPORAL_THRESHOLD
+/// \exclude
+#define FOONATHAN_ARRAY_NON_TEMPORAL_THRESHOLD 0
+#endif
+
+#ifndef FOONATHAN_ARRAY_LINEAR_SEARCH_THRESHOLD
+/// \exclude
+#define FOONATHAN_ARRAY_LINEAR_SEARCH_THRESHOLD 8
+#endif
+
 #endif // FOONATHAN_ARRAY_CONFIG_HPP_INCLUDED
@@ -0,0 +1,488 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_FLAT_HASH_MAP_HPP_INCLUDED
+#define FOONATHAN_ARRAY_FLAT_HASH_MAP_HPP_INCLUDED
+
+#include <foonathan/array/flat_hash_set.hpp>
+#include <foonathan/array/flat_map.hpp>
+
+namespace foonathan
+{
+    namespace array
+    {
+        /// Specialization of [array::key_hash_default]() for the [array::key_value_pair]().
+        ///
+        /// It will only hash and compare the key.
+        template <typename Key, typename Value>
+        struct key_hash_default::customize_for<key_value_pair<Key, Value>>
+        {
+            static std::size_t hash(const key_value_pair<Key, Value>& pair)
+            {
+                return key_hash_default::hash<Key>(pair.key);
+            }
+
+            template <typename T>
+            static std::size_t hash(const T& t)
+            {
+                return key_hash_default::hash<Key>(t);
+            }
+
+            template <typename T>
+            static auto equal(const key_value_pair<Key, Value>& pair, const T& t) noexcept
+                -> decltype(key_hash_default::equal(pair.key, t))
+            {
+                return key_hash_default::equal(pair.key, t);
+            }
+        };
+
+        namespace detail
+        {
+            template <typename Key, typename Value>
+            struct hash_map_traits
+            {
+                using key_type  = Key;
+                using slot_type = key_value_pair<Key, typename std::remove_const<Value>::type>;
+
+                using value_type = key_value_ref<Key, Value>;
+                using reference  = value_type; // can't use a real reference
+
+                struct pointer
+                {
+                    mutable value_type pair;
+
+                    value_type* operator->() const noexcept
+                    {
+                        return &pair;
+                    }
+                };
+
+                using const_traits = hash_map_traits<Key, const Value>;
+
+                static const Key& key(const slot_type& slot) noexcept
+                {
+                    return slot.key;
+                }
+
+                static reference get(const slot_type& slot) noexcept
+                {
+                    // note: the value is mutable
+                    return reference(slot.key, slot.value);
+                }
+
+                static pointer arrow(const slot_type& slot) noexcept
+                {
+                    return pointer{get(slot)};
+                }
+            };
+        } // namespace detail
+
+        /// An unordered map of keys to values.
+        ///
+        /// It is similar to [std::unordered_map](),
+        /// but uses the same open addressing table as [array::flat_hash_set]().
+        /// Each slot stores an [array::key_value_pair](),
+        /// and the slots are stored together with the control bytes in a single memory block of the `BlockStorage`.
+        ///
+        /// `Hash` must be a `KeyHash` type, like [array::key_hash_default](), not something like [std::hash]().
+        /// \notes Unlike [array::flat_map]() the order of the elements is unspecified,
+        /// and inserting invalidates all iterators, as the table might be rehashed.
+        template <typename Key, typename Value, typename Hash = key_hash_default,
+                  class BlockStorage = block_storage_default>
+        class flat_hash_map
+        {
+            using traits       = detail::hash_map_traits<Key, Value>;
+            using const_traits = detail::hash_map_traits<Key, const Value>;
+
+        public:
+            using key_type   = Key;
+            using value_type = Value;
+
+            using key_hash = Hash;
+
+            using block_storage = BlockStorage;
+
+            using iterator       = detail::hash_table_iterator<traits>;
+            using const_iterator = detail::hash_table_iterator<const_traits>;
+
+            //=== constructors/destructors ===//
+            /// Default constructor.
+            /// \effects Creates a map without any elements.
+            /// The block storage is initialized with default constructed arguments.
+            flat_hash_map() : flat_hash_map(typename block_storage::arg_type{}) {}
+
+            /// \effects Creates a map without any elements.
+            /// The block storage is initialized with the given arguments.
+            explicit flat_hash_map(typename block_storage::arg_type args) noexcept
+            : table_(std::move(args))
+            {
+            }
+
+            /// \effects Creates a map containing the key-value-pairs of the view.
+            /// The block storage is initialized with the given arguments.
+            explicit flat_hash_map(input_view<key_value_pair<Key, Value>, BlockStorage>&& input,
+                                   typename block_storage::arg_type                  args = {})
+            : table_(std::move(args))
+            {
+                assign(std::move(input));
+            }
+
+            /// \effects Same as `assign(std::move(view))`.
+            flat_hash_map& operator=(input_view<key_value_pair<Key, Value>, BlockStorage>&& view)
+            {
+                assign(std::move(view));
+                return *this;
+            }
+
+            /// Swap.
+            friend void swap(flat_hash_map& lhs, flat_hash_map& rhs) noexcept(
+                !BlockStorage::embedded_storage::value)
+            {
+                swap(lhs.table_, rhs.table_);
+            }
+
+            //=== access ===//
+            iterator begin() noexcept
+            {
+                return table_.template make_iterator<traits>(0u);
+            }
+            const_iterator begin() const noexcept
+            {
+                return cbegin();
+            }
+            const_iterator cbegin() const noexcept
+            {
+                return table_.template make_iterator<const_traits>(0u);
+            }
+
+            iterator end() noexcept
+            {
+                return table_.template make_iterator<traits>(table_.end_index());
+            }
+            const_iterator end() const noexcept
+            {
+                return cend();
+            }
+            const_iterator cend() const noexcept
+            {
+                return table_.template make_iterator<const_traits>(table_.end_index());
+            }
+
+            //=== capacity ===//
+            /// \returns Whether or not the map is empty.
+            bool empty() const noexcept
+            {
+                return size() == 0u;
+            }
+
+            /// \returns The number of elements in the map.
+            size_type size() const noexcept
+            {
+                return table_.size();
+            }
+
+            /// \returns The number of elements the map can contain without rehashing.
+            size_type capacity() const noexcept
+            {
+                return table_.capacity();
+            }
+
+            /// \returns The maximum number of elements as determined by the block storage.
+            size_type max_size() const noexcept
+            {
+                return table_.max_size();
+            }
+
+            /// \effects Rehashes to make capacity as least as big as `new_capacity` if that isn't the case already.
+            void reserve(size_type new_capacity)
+            {
+                table_.reserve(new_capacity);
+            }
+
+            /// \effects Non-binding request to make the capacity as small as necessary.
+            void shrink_to_fit()
+            {
+                table_.shrink_to_fit();
+            }
+
+            //=== modifiers ===//
+            /// The result of an insert operation.
+            class insert_result
+            {
+            public:
+                /// \returns An iterator to the key-value-pair with the given key.
+                iterator iter() const noexcept
+                {
+                    return iter_;
+                }
+
+                /// \returns Whether or not the key was already present in the map.
+                bool was_duplicate() const noexcept
+                {
+                    return was_duplicate_;
+                }
+
+                /// \returns Whether or not the key was inserted into the map.
+                /// This is the same as `!was_duplicate()`.
+                bool was_inserted() const noexcept
+                {
+                    return !was_duplicate_;
+                }
+
+            private:
+                insert_result(iterator iter, bool dup) : iter_(iter), was_duplicate_(dup) {}
+
+                iterator iter_;
+                bool     was_duplicate_;
+
+                friend flat_hash_map;
+            };
+
+            /// \effects Does a lookup for the given key.
+            /// If the key isn't part of the map, inserts the key-value-pair
+            /// where the key is constructed from the transparent key and the value is constructed from the arguments.
+            /// Otherwise, does nothing.
+            /// \returns The result of the insert operation.
+            template <typename TransparentKey, typename... ValueArgs>
+            insert_result try_emplace(TransparentKey&& key, ValueArgs&&... args)
+            {
+                auto result = table_.try_emplace(std::forward<TransparentKey>(key),
+                                                 std::forward<ValueArgs>(args)...);
+                return insert_result(table_.template make_iterator<traits>(result.first),
+                                     !result.second);
+            }
+
+            /// \effects Does a lookup for the given key.
+            /// If the key isn't part of the map, inserts the key-value-pair
+            /// where the key is constructed from the transparent key and the value is constructed from the arguments.
+            /// Otherwise, assigns the value already stored to the value constructed by from the arguments.
+            /// \returns The result of the insert operation.
+            template <typename TransparentKey, typename... Args>
+            insert_result emplace_or_assign(TransparentKey&& key, Args&&... args)
+            {
+                auto result =
+                    try_emplace(std::forward<TransparentKey>(key), std::forward<Args>(args)...);
+                if (!result.was_inserted())
+                {
+                    // update the value
+                    // the forwarded arguments are not actually used, so fine to forward them again
+                    assign_value(result.iter()->value, std::forward<Args>(args)...);
+                }
+                return result;
+            }
+
+            /// \effects Same as `try_emplace(FWD(k), FWD(v))`.
+            template <
+                typename K, typename V,
+                typename = typename std::enable_if<std::is_convertible<K, Key>::value
+                                                   && std::is_convertible<V, Value>::value>::type>
+            insert_result insert(K&& k, V&& v)
+            {
+                return try_emplace(std::forward<K>(k), std::forward<V>(v));
+            }
+
+            /// \effects Same as `emplace_or_assign(FWD(k), FWD(v))`.
+            template <
+                typename K, typename V,
+                typename = typename std::enable_if<std::is_convertible<K, Key>::value
+                                                   && std::is_convertible<V, Value>::value>::type>
+            insert_result insert_or_assign(K&& k, V&& v)
+            {
+                return emplace_or_assign(std::forward<K>(k), std::forward<V>(v));
+            }
+
+            /// \effects Same as `try_emplace(get<0>(FWD(pair)), get<1>(FWD(pair))`.
+            template <class Pair>
+            insert_result insert_pair(Pair&& pair)
+            {
+                using pair_type = typename std::decay<Pair>::type;
+                static_assert(std::tuple_size<pair_type>::value == 2u, "not a pair");
+
+                using std::get;
+                return try_emplace(get<0>(std::forward<Pair>(pair)),
+                                   get<1>(std::forward<Pair>(pair)));
+            }
+
+            /// \effects Same as `emplace_or_assign(get<0>(FWD(pair)), get<1>(FWD(pair))`.
+            template <class Pair>
+            insert_result insert_or_assign_pair(Pair&& pair)
+            {
+                using pair_type = typename std::decay<Pair>::type;
+                static_assert(std::tuple_size<pair_type>::value == 2u, "not a pair");
+
+                using std::get;
+                return emplace_or_assign(get<0>(std::forward<Pair>(pair)),
+                                         get<1>(std::forward<Pair>(pair)));
+            }
+
+            /// \effects Inserts all elements in the range `[begin, end)` by calling `insert_pair(*cur)`.
+            template <typename InputIt>
+            void insert_pair_range(InputIt begin, InputIt end)
+            {
+                reserve(size()
+                        + range_size(typename std::iterator_traits<InputIt>::iterator_category{},
+                                     begin, end));
+                for (auto cur = begin; cur != end; ++cur)
+                    insert_pair(*cur);
+            }
+
+            /// \effects Destroys and removes all elements.
+            /// The capacity is kept.
+            void clear() noexcept
+            {
+                table_.clear();
+            }
+
+            /// \effects Destroys and removes the element at the given position.
+            /// \returns An iterator after the element that was removed.
+            iterator erase(const_iterator pos) noexcept
+            {
+                auto index = table_.index_of(pos);
+                table_.erase(index);
+                return table_.template make_iterator<traits>(index + 1u);
+            }
+
+            /// \effects Destroys and removes the `key`, if it is in the map.
+            /// \returns Whether or not it was removed.
+            template <typename TransparentKey>
+            bool erase_all(const TransparentKey& key)
+            {
+                auto index = table_.find(key);
+                if (index == table_.end_index())
+                    return false;
+                table_.erase(index);
+                return true;
+            }
+
+            /// \effects Conceptually the same as `*this = flat_hash_map<Key, Value>(input)`.
+            /// \notes As the memory layout is different, the elements are always moved into a new table,
+            /// even if the view would allow stealing the memory.
+            void assign(input_view<key_value_pair<Key, Value>, BlockStorage>&& input)
+            {
+                table_.clear();
+                table_.reserve(input.size());
+
+                for (auto& pair : input.view())
+                {
+                    if (input.will_copy())
+                        try_emplace(pair.key, pair.value);
+                    else
+                    {
+                        // safe, according to precondition of input view,
+                        // we're allowed to move them
+                        auto& non_const = const_cast<key_value_pair<Key, Value>&>(pair);
+                        try_emplace(std::move(non_const.key), std::move(non_const.value));
+                    }
+                }
+            }
+
+            /// \effects Conceptually the same as `flat_hash_map<Key, Value> m; m.insert_pair_range(begin, end); *this = std::move(m);`
+            template <typename InputIt>
+            void assign_pair_range(InputIt begin, InputIt end)
+            {
+                table_.clear();
+                insert_pair_range(begin, end);
+            }
+
+            //=== lookup ===//
+            /// \returns Whether or not the key is contained in the map.
+            template <typename TransparentKey>
+            bool contains(const TransparentKey& key) const
+            {
+                return table_.find(key) != table_.end_index();
+            }
+
+            /// \returns The value belonging to the given key.
+            /// \requires The key must be stored in the map.
+            /// \group lookup
+            template <typename TransparentKey>
+            Value& lookup(const TransparentKey& key)
+            {
+                auto index = table_.find(key);
+                assert(index != table_.end_index());
+                return table_.slot(index).value;
+            }
+            /// \group lookup
+            template <typename TransparentKey>
+            const Value& lookup(const TransparentKey& key) const
+            {
+                auto index = table_.find(key);
+                assert(index != table_.end_index());
+                return table_.slot(index).value;
+            }
+
+            /// \returns A pointer to the value belonging to the given key, or `nullptr`, if there was none.
+            /// \group try_lookup
+            template <typename TransparentKey>
+            Value* try_lookup(const TransparentKey& key)
+            {
+                auto index = table_.find(key);
+                if (index == table_.end_index())
+                    return nullptr;
+                else
+                    return &table_.slot(index).value;
+            }
+            /// \group try_lookup
+            template <typename TransparentKey>
+            const Value* try_lookup(const TransparentKey& key) const
+            {
+                auto index = table_.find(key);
+                if (index == table_.end_index())
+                    return nullptr;
+                else
+                    return &table_.slot(index).value;
+            }
+
+            /// \returns An iterator to the given key-value-pair, or `end()` if the key is not in the map.
+            /// \group find
+            template <typename TransparentKey>
+            iterator find(const TransparentKey& key)
+            {
+                return table_.template make_iterator<traits>(table_.find(key));
+            }
+            /// \group find
+            template <typename TransparentKey>
+            const_iterator find(const TransparentKey& key) const
+            {
+                return table_.template make_iterator<const_traits>(table_.find(key));
+            }
+
+            /// \returns The number of occurences of `key` in the map, either `0` or `1`.
+            template <typename TransparentKey>
+            size_type count(const TransparentKey& key) const
+            {
+                return contains(key) ? 1u : 0u;
+            }
+
+        private:
+            template <typename Arg>
+            auto assign_value(Value& value, Arg&& arg) noexcept
+                -> decltype(value = std::forward<Arg>(arg))
+            {
+                return value = std::forward<Arg>(arg);
+            }
+            template <typename... Args>
+            void assign_value(Value& value, Args&&... args) const
+            {
+                value = Value(std::forward<Args>(args)...);
+            }
+
+            template <typename InputIt>
+            static size_type range_size(std::input_iterator_tag, InputIt, InputIt)
+            {
+                return size_type(0u);
+            }
+
+            template <typename ForwardIt>
+            static size_type range_size(std::forward_iterator_tag, ForwardIt begin, ForwardIt end)
+            {
+                return size_type(std::distance(begin, end));
+            }
+
+            detail::hash_table<traits, Hash, BlockStorage> table_;
+        };
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_FLAT_HASH_MAP_HPP_INCLUDED
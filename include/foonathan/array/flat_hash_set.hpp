@@ -0,0 +1,1063 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_FLAT_HASH_SET_HPP_INCLUDED
+#define FOONATHAN_ARRAY_FLAT_HASH_SET_HPP_INCLUDED
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include <foonathan/array/bits.hpp>
+#include <foonathan/array/block_storage.hpp>
+#include <foonathan/array/block_storage_new.hpp>
+#include <foonathan/array/config.hpp>
+#include <foonathan/array/input_view.hpp>
+#include <foonathan/array/key_hash.hpp>
+
+#if FOONATHAN_ARRAY_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace foonathan
+{
+    namespace array
+    {
+        namespace detail
+        {
+            //=== control bytes ===//
+            // every slot has a control byte:
+            // it is either empty, deleted or full and then stores the lower 7 bits of the hash
+            // the sentinel marks the end of the table for the iterators
+            using hash_ctrl = std::int8_t;
+
+            constexpr hash_ctrl hash_ctrl_empty    = -128;
+            constexpr hash_ctrl hash_ctrl_deleted  = -2;
+            constexpr hash_ctrl hash_ctrl_sentinel = -1;
+
+            inline bool hash_ctrl_is_full(hash_ctrl ctrl) noexcept
+            {
+                return ctrl >= 0;
+            }
+
+            // the control bytes of a table without any slots
+            inline const hash_ctrl* hash_empty_ctrl() noexcept
+            {
+                static const hash_ctrl ctrl[16] = {hash_ctrl_sentinel, hash_ctrl_empty,
+                                                   hash_ctrl_empty,    hash_ctrl_empty,
+                                                   hash_ctrl_empty,    hash_ctrl_empty,
+                                                   hash_ctrl_empty,    hash_ctrl_empty,
+                                                   hash_ctrl_empty,    hash_ctrl_empty,
+                                                   hash_ctrl_empty,    hash_ctrl_empty,
+                                                   hash_ctrl_empty,    hash_ctrl_empty,
+                                                   hash_ctrl_empty,    hash_ctrl_empty};
+                return ctrl;
+            }
+
+            //=== group ===//
+            // the result of matching a group, one bit or byte per control byte
+            template <typename T, unsigned Shift>
+            class hash_group_mask
+            {
+            public:
+                explicit hash_group_mask(T mask) noexcept : mask_(mask) {}
+
+                explicit operator bool() const noexcept
+                {
+                    return mask_ != 0u;
+                }
+
+                size_type lowest() const noexcept
+                {
+                    return count_trailing_zeros(mask_) >> Shift;
+                }
+
+                void clear_lowest() noexcept
+                {
+                    mask_ &= mask_ - 1u;
+                }
+
+            private:
+                T mask_;
+            };
+
+#if FOONATHAN_ARRAY_HAS_SSE2
+            // a group of 16 control bytes, matched with SSE2
+            class hash_group
+            {
+            public:
+                static constexpr size_type width = 16u;
+
+                using mask = hash_group_mask<std::uint32_t, 0>;
+
+                explicit hash_group(const hash_ctrl* ctrl) noexcept
+                : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+                {
+                }
+
+                mask match(hash_ctrl h2) const noexcept
+                {
+                    return to_mask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+                }
+
+                mask match_empty() const noexcept
+                {
+                    return match(hash_ctrl_empty);
+                }
+
+                mask match_empty_or_deleted() const noexcept
+                {
+                    // both are smaller than the sentinel, while full bytes are bigger
+                    return to_mask(_mm_cmpgt_epi8(_mm_set1_epi8(hash_ctrl_sentinel), ctrl_));
+                }
+
+            private:
+                static mask to_mask(__m128i bytes) noexcept
+                {
+                    return mask(std::uint32_t(_mm_movemask_epi8(bytes)));
+                }
+
+                __m128i ctrl_;
+            };
+#else
+            // a group of 8 control bytes, matched with bit tricks on a 64 bit integer
+            class hash_group
+            {
+            public:
+                static constexpr size_type width = 8u;
+
+                using mask = hash_group_mask<std::uint64_t, 3>;
+
+                explicit hash_group(const hash_ctrl* ctrl) noexcept : ctrl_(0u)
+                {
+                    // little endian load on every platform, the compiler turns it into a single load
+                    for (auto i = 0u; i != 8u; ++i)
+                        ctrl_ |= std::uint64_t(static_cast<unsigned char>(ctrl[i])) << (8u * i);
+                }
+
+                mask match(hash_ctrl h2) const noexcept
+                {
+                    // sets the high bit of each byte that is zero after the xor
+                    // this can have false positives after a real match,
+                    // but only for full slots, and those are filtered out by comparing the keys
+                    auto x = ctrl_ ^ (lsbs * static_cast<unsigned char>(h2));
+                    return mask((x - lsbs) & ~x & msbs);
+                }
+
+                mask match_empty() const noexcept
+                {
+                    // only the empty byte has the high bit set but the second lowest bit not
+                    return mask(ctrl_ & ~(ctrl_ << 6u) & msbs);
+                }
+
+                mask match_empty_or_deleted() const noexcept
+                {
+                    // the sentinel is the only byte with the high bit set that has the lowest bit set
+                    return mask(ctrl_ & ~(ctrl_ << 7u) & msbs);
+                }
+
+            private:
+                static constexpr std::uint64_t lsbs = 0x0101010101010101ull;
+                static constexpr std::uint64_t msbs = 0x8080808080808080ull;
+
+                std::uint64_t ctrl_;
+            };
+#endif
+
+            //=== hash ===//
+            // mixes the bits of the hash value,
+            // so a weak hash like the identity of std::hash<int> can be used as well
+            inline size_type hash_mix(std::size_t hash) noexcept
+            {
+                auto product = std::uint64_t(hash) * 0x9E3779B97F4A7C15ull;
+                return size_type(product ^ (product >> 32u));
+            }
+
+            inline hash_ctrl hash_h2(size_type hash) noexcept
+            {
+                return hash_ctrl(hash & 0x7Fu);
+            }
+
+            // triangular probing over the groups,
+            // visits every group exactly once as the capacity is a power of two minus one
+            class hash_probe
+            {
+            public:
+                explicit hash_probe(size_type hash, size_type capacity) noexcept
+                : mask_(capacity), offset_((hash >> 7u) & capacity), index_(0u)
+                {
+                }
+
+                size_type offset() const noexcept
+                {
+                    return offset_;
+                }
+
+                size_type offset(size_type i) const noexcept
+                {
+                    return (offset_ + i) & mask_;
+                }
+
+                void next() noexcept
+                {
+                    index_ += hash_group::width;
+                    offset_ = (offset_ + index_) & mask_;
+                }
+
+            private:
+                size_type mask_, offset_, index_;
+            };
+
+            //=== iterator ===//
+            // Traits provides slot_type, value_type, reference, pointer and const_traits,
+            // as well as get() and arrow() to turn a slot into a reference and pointer
+            template <class Traits>
+            class hash_table_iterator
+            {
+                using slot_type = typename Traits::slot_type;
+
+            public:
+                struct private_key
+                {
+                    explicit private_key() {}
+                };
+
+                using iterator_category = std::forward_iterator_tag;
+                using value_type        = typename Traits::value_type;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = typename Traits::pointer;
+                using reference         = typename Traits::reference;
+
+                hash_table_iterator() noexcept : ctrl_(nullptr), slot_(nullptr) {}
+
+                explicit hash_table_iterator(private_key, const hash_ctrl* ctrl,
+                                             slot_type* slot) noexcept
+                : ctrl_(ctrl), slot_(slot)
+                {
+                    skip_empty();
+                }
+
+                template <class NonConstTraits,
+                          typename = typename std::enable_if<
+                              !std::is_same<NonConstTraits, Traits>::value
+                              && std::is_same<typename NonConstTraits::const_traits,
+                                              Traits>::value>::type>
+                hash_table_iterator(const hash_table_iterator<NonConstTraits>& non_const) noexcept
+                : ctrl_(non_const.ctrl_), slot_(non_const.slot_)
+                {
+                }
+
+                //=== access ===//
+                reference operator*() const noexcept
+                {
+                    return Traits::get(*slot_);
+                }
+
+                pointer operator->() const noexcept
+                {
+                    return Traits::arrow(*slot_);
+                }
+
+                const hash_ctrl* get_ctrl_pointer(private_key) const noexcept
+                {
+                    return ctrl_;
+                }
+
+                //=== increment ===//
+                hash_table_iterator& operator++() noexcept
+                {
+                    ++ctrl_;
+                    ++slot_;
+                    skip_empty();
+                    return *this;
+                }
+                hash_table_iterator operator++(int) noexcept
+                {
+                    auto save = *this;
+                    ++*this;
+                    return save;
+                }
+
+                //=== comparison ===//
+                friend bool operator==(const hash_table_iterator& lhs,
+                                       const hash_table_iterator& rhs) noexcept
+                {
+                    return lhs.ctrl_ == rhs.ctrl_;
+                }
+                friend bool operator!=(const hash_table_iterator& lhs,
+                                       const hash_table_iterator& rhs) noexcept
+                {
+                    return !(lhs == rhs);
+                }
+
+            private:
+                void skip_empty() noexcept
+                {
+                    // the sentinel stops the loop
+                    while (*ctrl_ < hash_ctrl_sentinel)
+                    {
+                        ++ctrl_;
+                        ++slot_;
+                    }
+                }
+
+                const hash_ctrl* ctrl_;
+                slot_type*       slot_;
+
+                template <class>
+                friend class hash_table_iterator;
+            };
+
+            //=== hash_table ===//
+            // an open addressing hash table where the control bytes and slots are in one block
+            //
+            // the capacity is always a power of two minus one, the control bytes are followed by the sentinel,
+            // and then clones of the first width - 1 control bytes, so a group can be loaded at every position
+            //
+            // Traits provides key_type, slot_type and key() to get the key of a slot
+            template <class Traits, class Hash, class BlockStorage>
+            class hash_table
+            {
+            public:
+                using key_type  = typename Traits::key_type;
+                using slot_type = typename Traits::slot_type;
+
+                //=== constructors/destructors ===//
+                explicit hash_table(typename BlockStorage::arg_type args) noexcept
+                : storage_(std::move(args)),
+                  ctrl_(hash_empty_ctrl()),
+                  slots_(nullptr),
+                  size_(0u),
+                  capacity_(0u),
+                  growth_left_(0u)
+                {
+                }
+
+                hash_table(const hash_table& other) : hash_table(other.storage_.arguments())
+                {
+                    reserve(other.size_);
+                    for (auto i = size_type(0u); i != other.capacity_; ++i)
+                        if (hash_ctrl_is_full(other.ctrl_[i]))
+                        {
+                            auto& slot = static_cast<const slot_type&>(other.slots_[i]);
+                            insert_new(hash_of(Traits::key(slot)), slot);
+                        }
+                }
+
+                hash_table(hash_table&& other) noexcept(!BlockStorage::embedded_storage::value)
+                : hash_table(other.storage_.arguments())
+                {
+                    swap(*this, other);
+                }
+
+                ~hash_table() noexcept
+                {
+                    destroy_slots();
+                }
+
+                hash_table& operator=(const hash_table& other)
+                {
+                    hash_table tmp(other);
+                    swap(*this, tmp);
+                    return *this;
+                }
+
+                hash_table& operator=(hash_table&& other) noexcept(
+                    !BlockStorage::embedded_storage::value)
+                {
+                    hash_table tmp(std::move(other));
+                    swap(*this, tmp);
+                    return *this;
+                }
+
+                friend void swap(hash_table& lhs, hash_table& rhs) noexcept(
+                    !BlockStorage::embedded_storage::value)
+                {
+                    swap_impl(typename BlockStorage::embedded_storage{}, lhs, rhs);
+                }
+
+                //=== access ===//
+                template <class IterTraits>
+                hash_table_iterator<IterTraits> make_iterator(size_type index) const noexcept
+                {
+                    using key = typename hash_table_iterator<IterTraits>::private_key;
+                    return hash_table_iterator<IterTraits>(key{}, ctrl_ + index, slots_ + index);
+                }
+
+                template <class IterTraits>
+                size_type index_of(const hash_table_iterator<IterTraits>& iter) const noexcept
+                {
+                    using key = typename hash_table_iterator<IterTraits>::private_key;
+                    return size_type(iter.get_ctrl_pointer(key{}) - ctrl_);
+                }
+
+                // the index of the sentinel, i.e. the end
+                size_type end_index() const noexcept
+                {
+                    return capacity_;
+                }
+
+                slot_type& slot(size_type index) const noexcept
+                {
+                    assert(index < capacity_ && hash_ctrl_is_full(ctrl_[index]));
+                    return slots_[index];
+                }
+
+                //=== capacity ===//
+                size_type size() const noexcept
+                {
+                    return size_;
+                }
+
+                // the number of elements that can be stored without a rehash
+                size_type capacity() const noexcept
+                {
+                    return size_ + growth_left_;
+                }
+
+                size_type max_size() const noexcept
+                {
+                    return BlockStorage::max_size(storage_.arguments()) / (sizeof(slot_type) + 1u);
+                }
+
+                void reserve(size_type new_capacity)
+                {
+                    if (new_capacity > capacity())
+                        rehash(capacity_for(new_capacity));
+                }
+
+                void shrink_to_fit()
+                {
+                    auto new_capacity = capacity_for(size_);
+                    if (new_capacity < capacity_)
+                        rehash(new_capacity);
+                }
+
+                //=== modifiers ===//
+                void clear() noexcept
+                {
+                    destroy_slots();
+                    if (capacity_ != 0u)
+                        reset_ctrl();
+                }
+
+                // returns the index of the element with the given key and whether it was inserted
+                template <typename TransparentKey, typename... Args>
+                std::pair<size_type, bool> try_emplace(TransparentKey&& key, Args&&... args)
+                {
+                    auto hash  = hash_of(key);
+                    auto index = find_index(key, hash);
+                    if (index != end_index())
+                        return std::make_pair(index, false);
+
+                    index = prepare_insert(hash);
+                    construct_object<slot_type>(to_raw_pointer(slots_ + index),
+                                                std::forward<TransparentKey>(key),
+                                                std::forward<Args>(args)...);
+                    finish_insert(index, hash);
+                    return std::make_pair(index, true);
+                }
+
+                void erase(size_type index) noexcept
+                {
+                    destroy_object(&slot(index));
+                    // a tombstone is required, as later elements of the probe sequence could be after it
+                    set_ctrl(index, hash_ctrl_deleted);
+                    --size_;
+                }
+
+                //=== lookup ===//
+                template <typename TransparentKey>
+                size_type find(const TransparentKey& key) const
+                {
+                    return find_index(key, hash_of(key));
+                }
+
+            private:
+                static void swap_impl(std::false_type, hash_table& lhs, hash_table& rhs) noexcept
+                {
+                    // the storage doesn't embed the slots, so it only swaps pointers
+                    block_view<slot_type> lhs_constructed, rhs_constructed;
+                    BlockStorage::swap(lhs.storage_, lhs_constructed, rhs.storage_,
+                                       rhs_constructed);
+
+                    std::swap(lhs.ctrl_, rhs.ctrl_);
+                    std::swap(lhs.slots_, rhs.slots_);
+                    std::swap(lhs.size_, rhs.size_);
+                    std::swap(lhs.capacity_, rhs.capacity_);
+                    std::swap(lhs.growth_left_, rhs.growth_left_);
+                }
+
+                static void swap_impl(std::true_type, hash_table& lhs, hash_table& rhs)
+                {
+                    // the slots might be embedded in the storage,
+                    // so they have to be moved individually, as the layout depends on the capacity
+                    hash_table tmp(lhs.storage_.arguments());
+                    tmp.take_elements(lhs);
+                    lhs.take_elements(rhs);
+                    rhs.take_elements(tmp);
+                }
+
+                //=== layout ===//
+                static size_type growth_of(size_type capacity) noexcept
+                {
+                    // maximum load factor of 7/8,
+                    // but a table with a single portable group needs at least one empty slot
+                    return hash_group::width == 8u && capacity == 7u ? 6u
+                                                                     : capacity - capacity / 8u;
+                }
+
+                static size_type capacity_for(size_type size) noexcept
+                {
+                    if (size == 0u)
+                        return 0u;
+
+                    auto capacity = size_type(1u);
+                    while (growth_of(capacity) < size)
+                        capacity = capacity * 2u + 1u;
+                    return capacity;
+                }
+
+                static size_type ctrl_size(size_type capacity) noexcept
+                {
+                    return capacity + hash_group::width;
+                }
+
+                static size_type slot_offset(size_type capacity) noexcept
+                {
+                    auto alignment = alignof(slot_type);
+                    return (ctrl_size(capacity) + alignment - 1u) / alignment * alignment;
+                }
+
+                static size_type block_size(size_type capacity) noexcept
+                {
+                    return slot_offset(capacity) + capacity * sizeof(slot_type);
+                }
+
+                //=== allocation ===//
+                // precondition: there are no elements
+                void allocate(size_type new_capacity)
+                {
+                    assert(size_ == 0u);
+
+                    auto new_size = block_size(new_capacity);
+                    if (new_capacity == 0u || new_size < storage_.block().size() / 2u)
+                        // give back the memory, it is too big
+                        clear_and_shrink(storage_, block_view<slot_type>());
+
+                    capacity_    = 0u;
+                    growth_left_ = 0u;
+                    ctrl_        = hash_empty_ctrl();
+                    slots_       = nullptr;
+                    if (new_capacity == 0u)
+                        return;
+
+                    auto& block = storage_.block();
+                    if (new_size > block.size())
+                        storage_.reserve(new_size - block.size(), block_view<slot_type>());
+                    assert(storage_.block().size() >= new_size);
+
+                    capacity_ = new_capacity;
+                    ctrl_     = to_pointer<hash_ctrl>(storage_.block().begin());
+                    slots_ = to_pointer<slot_type>(storage_.block().begin() + slot_offset(capacity_));
+                    reset_ctrl();
+                }
+
+                void reset_ctrl() noexcept
+                {
+                    auto ctrl = to_pointer<hash_ctrl>(storage_.block().begin());
+                    std::memset(ctrl, static_cast<unsigned char>(hash_ctrl_empty),
+                                ctrl_size(capacity_));
+                    ctrl[capacity_] = hash_ctrl_sentinel;
+                    growth_left_    = growth_of(capacity_);
+                    size_           = 0u;
+                }
+
+                void rehash(size_type new_capacity)
+                {
+                    if (size_ == 0u)
+                        allocate(new_capacity);
+                    else if (!BlockStorage::embedded_storage::value)
+                    {
+                        // create the new table in a separate storage and swap pointers afterwards,
+                        // so this one is unchanged if it throws
+                        hash_table tmp(storage_.arguments());
+                        tmp.allocate(new_capacity);
+                        tmp.take_elements(*this);
+                        swap(*this, tmp);
+                    }
+                    else
+                    {
+                        // move the elements out, reuse the storage and move them back
+                        hash_table tmp(storage_.arguments());
+                        tmp.take_elements(*this);
+                        allocate(new_capacity);
+                        take_elements(tmp);
+                    }
+                }
+
+                // inserts the elements of other and clears it
+                void take_elements(hash_table& other)
+                {
+                    reserve(size_ + other.size_);
+                    for (auto i = size_type(0u); i != other.capacity_; ++i)
+                        if (hash_ctrl_is_full(other.ctrl_[i]))
+                        {
+                            auto& slot = other.slots_[i];
+                            insert_new(hash_of(Traits::key(slot)), std::move_if_noexcept(slot));
+                        }
+                    other.clear();
+                }
+
+                void destroy_slots() noexcept
+                {
+                    if (std::is_trivially_destructible<slot_type>::value)
+                        return;
+
+                    for (auto i = size_type(0u); i != capacity_; ++i)
+                        if (hash_ctrl_is_full(ctrl_[i]))
+                            destroy_object(slots_ + i);
+                }
+
+                //=== probing ===//
+                template <typename TransparentKey>
+                static size_type hash_of(const TransparentKey& key)
+                {
+                    return hash_mix(Hash::template hash<key_type>(key));
+                }
+
+                template <typename TransparentKey>
+                size_type find_index(const TransparentKey& key, size_type hash) const
+                {
+                    auto       h2 = hash_h2(hash);
+                    hash_probe probe(hash, capacity_);
+                    while (true)
+                    {
+                        hash_group group(ctrl_ + probe.offset());
+                        for (auto match = group.match(h2); match; match.clear_lowest())
+                        {
+                            auto index = probe.offset(match.lowest());
+                            if (Hash::equal(Traits::key(slots_[index]), key))
+                                return index;
+                        }
+
+                        if (group.match_empty())
+                            // the key would have been inserted in the empty slot
+                            return end_index();
+                        probe.next();
+                    }
+                }
+
+                size_type find_first_non_full(size_type hash) const noexcept
+                {
+                    hash_probe probe(hash, capacity_);
+                    while (true)
+                    {
+                        auto match = hash_group(ctrl_ + probe.offset()).match_empty_or_deleted();
+                        if (match)
+                            return probe.offset(match.lowest());
+                        probe.next();
+                    }
+                }
+
+                // returns the index of the slot where an element with the given hash is inserted,
+                // rehashes if necessary
+                size_type prepare_insert(size_type hash)
+                {
+                    auto index = find_first_non_full(hash);
+                    if (growth_left_ == 0u && ctrl_[index] != hash_ctrl_deleted)
+                    {
+                        // only rehash in place if at least half of the growth is taken by tombstones,
+                        // otherwise we'd be doing it over and over again
+                        auto new_capacity = capacity_for(size_ + 1u);
+                        if (new_capacity == capacity_ && size_ * 2u > growth_of(capacity_))
+                            new_capacity = capacity_ * 2u + 1u;
+                        rehash(new_capacity);
+
+                        index = find_first_non_full(hash);
+                    }
+                    return index;
+                }
+
+                void finish_insert(size_type index, size_type hash) noexcept
+                {
+                    if (ctrl_[index] == hash_ctrl_empty)
+                        --growth_left_;
+                    set_ctrl(index, hash_h2(hash));
+                    ++size_;
+                }
+
+                // precondition: the key isn't in the table and there is space
+                template <typename... Args>
+                void insert_new(size_type hash, Args&&... args)
+                {
+                    auto index = find_first_non_full(hash);
+                    assert(growth_left_ > 0u || ctrl_[index] == hash_ctrl_deleted);
+                    construct_object<slot_type>(to_raw_pointer(slots_ + index),
+                                                std::forward<Args>(args)...);
+                    finish_insert(index, hash);
+                }
+
+                void set_ctrl(size_type index, hash_ctrl ctrl) noexcept
+                {
+                    // also update the clone, if there is one
+                    auto clone_index = ((index - (hash_group::width - 1u)) & capacity_)
+                                       + ((hash_group::width - 1u) & capacity_);
+                    auto mutable_ctrl         = const_cast<hash_ctrl*>(ctrl_);
+                    mutable_ctrl[index]       = ctrl;
+                    mutable_ctrl[clone_index] = ctrl;
+                }
+
+                BlockStorage     storage_;
+                const hash_ctrl* ctrl_;
+                slot_type*       slots_;
+                size_type        size_, capacity_, growth_left_;
+            };
+
+            template <typename Key>
+            struct hash_set_traits
+            {
+                using key_type     = Key;
+                using slot_type    = Key;
+                using value_type   = Key;
+                using reference    = const Key&;
+                using pointer      = const Key*;
+                using const_traits = hash_set_traits;
+
+                static const Key& key(const Key& slot) noexcept
+                {
+                    return slot;
+                }
+
+                static reference get(const Key& slot) noexcept
+                {
+                    return slot;
+                }
+
+                static pointer arrow(const Key& slot) noexcept
+                {
+                    return &slot;
+                }
+            };
+        } // namespace detail
+
+        /// An unordered set of elements.
+        ///
+        /// It is similar to [std::unordered_set](), but uses open addressing with an array of slots,
+        /// where each slot has a control byte that stores seven bits of the hash.
+        /// A lookup compares a group of control bytes in parallel — using SSE2 if available —
+        /// and only compares the keys of the slots where the bits match.
+        /// The control bytes and the slots are stored together in a single memory block of the `BlockStorage`.
+        ///
+        /// `Hash` must be a `KeyHash` type, like [array::key_hash_default](), not something like [std::hash]().
+        /// \notes Unlike [array::flat_set]() the order of the elements is unspecified,
+        /// and inserting invalidates all iterators, as the table might be rehashed.
+        /// Erasing leaves a tombstone and doesn't invalidate other iterators.
+        template <typename Key, typename Hash = key_hash_default,
+                  class BlockStorage = block_storage_default>
+        class flat_hash_set
+        {
+            using traits = detail::hash_set_traits<Key>;
+
+        public:
+            using key_type   = Key;
+            using value_type = key_type;
+
+            using key_hash = Hash;
+
+            using block_storage = BlockStorage;
+
+            using iterator       = detail::hash_table_iterator<traits>;
+            using const_iterator = iterator;
+
+            //=== constructors/destructors ===//
+            /// Default constructor.
+            /// \effects Creates a set without any elements.
+            /// The block storage is initialized with default constructed arguments.
+            flat_hash_set() : flat_hash_set(typename block_storage::arg_type{}) {}
+
+            /// \effects Creates a set without any elements.
+            /// The block storage is initialized with the given arguments.
+            explicit flat_hash_set(typename block_storage::arg_type args) noexcept
+            : table_(std::move(args))
+            {
+            }
+
+            /// \effects Creates a set containing the elements of the view.
+            /// The block storage is initialized with the given arguments.
+            explicit flat_hash_set(input_view<Key, BlockStorage>&&  input,
+                                   typename block_storage::arg_type args = {})
+            : table_(std::move(args))
+            {
+                assign(std::move(input));
+            }
+
+            /// \effects Same as `assign(std::move(view))`.
+            flat_hash_set& operator=(input_view<Key, BlockStorage>&& view)
+            {
+                assign(std::move(view));
+                return *this;
+            }
+
+            /// Swap.
+            friend void swap(flat_hash_set& lhs, flat_hash_set& rhs) noexcept(
+                !BlockStorage::embedded_storage::value)
+            {
+                swap(lhs.table_, rhs.table_);
+            }
+
+            //=== access ===//
+            const_iterator begin() const noexcept
+            {
+                return cbegin();
+            }
+            const_iterator cbegin() const noexcept
+            {
+                return table_.template make_iterator<traits>(0u);
+            }
+
+            const_iterator end() const noexcept
+            {
+                return cend();
+            }
+            const_iterator cend() const noexcept
+            {
+                return table_.template make_iterator<traits>(table_.end_index());
+            }
+
+            //=== capacity ===//
+            /// \returns Whether or not the set is empty.
+            bool empty() const noexcept
+            {
+                return size() == 0u;
+            }
+
+            /// \returns The number of elements in the set.
+            size_type size() const noexcept
+            {
+                return table_.size();
+            }
+
+            /// \returns The number of elements the set can contain without rehashing.
+            size_type capacity() const noexcept
+            {
+                return table_.capacity();
+            }
+
+            /// \returns The maximum number of elements as determined by the block storage.
+            size_type max_size() const noexcept
+            {
+                return table_.max_size();
+            }
+
+            /// \effects Rehashes to make capacity as least as big as `new_capacity` if that isn't the case already.
+            void reserve(size_type new_capacity)
+            {
+                table_.reserve(new_capacity);
+            }
+
+            /// \effects Non-binding request to make the capacity as small as necessary.
+            void shrink_to_fit()
+            {
+                table_.shrink_to_fit();
+            }
+
+            //=== modifiers ===//
+            /// The result of an insert operation.
+            class insert_result
+            {
+            public:
+                /// \returns An iterator to the element with the given key.
+                iterator iter() const noexcept
+                {
+                    return iter_;
+                }
+
+                /// \returns Whether or not the key was already present in the set.
+                bool was_duplicate() const noexcept
+                {
+                    return was_duplicate_;
+                }
+
+                /// \returns Whether or not the key was inserted into the set.
+                /// This is the same as `!was_duplicate()`.
+                bool was_inserted() const noexcept
+                {
+                    return !was_duplicate_;
+                }
+
+            private:
+                insert_result(iterator iter, bool dup) : iter_(iter), was_duplicate_(dup) {}
+
+                iterator iter_;
+                bool     was_duplicate_;
+
+                friend flat_hash_set;
+            };
+
+            /// \effects Does a lookup for the given key.
+            /// If the key isn't part of the set, inserts a key constructed from the transparent key followed by the additional arguments.
+            /// Otherwise, does nothing.
+            /// \returns The result of the insert operation.
+            template <typename TransparentKey, typename... Args>
+            insert_result try_emplace(TransparentKey&& key, Args&&... args)
+            {
+                auto result =
+                    table_.try_emplace(std::forward<TransparentKey>(key), std::forward<Args>(args)...);
+                return insert_result(table_.template make_iterator<traits>(result.first),
+                                     !result.second);
+            }
+
+            /// \effects Same as `try_emplace(FWD(k))`.
+            /// \notes This function does not participate in overload resolution if `Key` is not constructible from `K`.
+            /// \param 1
+            /// \exclude
+            template <typename K,
+                      typename = typename std::enable_if<std::is_convertible<K, Key>::value>::type>
+            insert_result insert(K&& k)
+            {
+                return try_emplace(std::forward<K>(k));
+            }
+
+            /// \effects Same as `insert_range(view.begin(), view.end())`.
+            void insert(const block_view<const Key>& view)
+            {
+                insert_range(view.begin(), view.end());
+            }
+
+            /// \effects Inserts all elements in the range `[begin, end)`.
+            template <typename InputIt>
+            void insert_range(InputIt begin, InputIt end)
+            {
+                insert_range_impl(typename std::iterator_traits<InputIt>::iterator_category{},
+                                  begin, end);
+            }
+
+            /// \effects Destroys and removes all elements.
+            /// The capacity is kept.
+            void clear() noexcept
+            {
+                table_.clear();
+            }
+
+            /// \effects Destroys and removes the element at the given position.
+            /// \returns An iterator after the element that was removed.
+            iterator erase(iterator pos) noexcept
+            {
+                auto index = table_.index_of(pos);
+                table_.erase(index);
+                return table_.template make_iterator<traits>(index + 1u);
+            }
+
+            /// \effects Destroys and removes the `key`, if it is in the set.
+            /// \returns Whether or not it was removed.
+            template <typename TransparentKey>
+            bool erase_all(const TransparentKey& key)
+            {
+                auto index = table_.find(key);
+                if (index == table_.end_index())
+                    return false;
+                table_.erase(index);
+                return true;
+            }
+
+            /// \effects Conceptually the same as `*this = flat_hash_set<Key>(input)`.
+            /// \notes As the memory layout is different, the elements are always moved into a new table,
+            /// even if the view would allow stealing the memory.
+            void assign(input_view<Key, BlockStorage>&& input)
+            {
+                table_.clear();
+                table_.reserve(input.size());
+
+                // insert all elements individually
+                for (auto& element : input.view())
+                {
+                    if (input.will_copy())
+                        insert(element);
+                    else
+                    {
+                        // safe, according to precondition of input view,
+                        // we're allowed to move them
+                        auto& non_const = const_cast<Key&>(element);
+                        insert(std::move(non_const));
+                    }
+                }
+            }
+
+            /// \effects Conceptually the same as `flat_hash_set<Key> s; s.insert_range(begin, end); *this = std::move(s);`
+            template <typename InputIt>
+            void assign_range(InputIt begin, InputIt end)
+            {
+                table_.clear();
+                insert_range(begin, end);
+            }
+
+            //=== lookup ===//
+            /// \returns Whether or not the key is contained in the set.
+            template <typename TransparentKey>
+            bool contains(const TransparentKey& key) const
+            {
+                return table_.find(key) != table_.end_index();
+            }
+
+            /// \returns The key that is considered equal to the given transparent key.
+            /// \requires The key must be stored in the set.
+            template <typename TransparentKey>
+            const Key& lookup(const TransparentKey& key) const
+            {
+                auto index = table_.find(key);
+                assert(index != table_.end_index());
+                return table_.slot(index);
+            }
+
+            /// \returns A pointer to the key that is considered equal to the given transparent key,
+            /// or `nullptr`, if there was none.
+            template <typename TransparentKey>
+            const Key* try_lookup(const TransparentKey& key) const
+            {
+                auto index = table_.find(key);
+                if (index == table_.end_index())
+                    return nullptr;
+                else
+                    return &table_.slot(index);
+            }
+
+            /// \returns An iterator to the given key, or `end()` if the key is not in the set.
+            template <typename TransparentKey>
+            const_iterator find(const TransparentKey& key) const
+            {
+                return table_.template make_iterator<traits>(table_.find(key));
+            }
+
+            /// \returns The number of occurences of `key` in the set, either `0` or `1`.
+            template <typename TransparentKey>
+            size_type count(const TransparentKey& key) const
+            {
+                return contains(key) ? 1u : 0u;
+            }
+
+        private:
+            template <typename InputIt>
+            void insert_range_impl(std::input_iterator_tag, InputIt begin, InputIt end)
+            {
+                for (auto cur = begin; cur != end; ++cur)
+                    insert(*cur);
+            }
+            template <typename ForwardIt>
+            void insert_range_impl(std::forward_iterator_tag, ForwardIt begin, ForwardIt end)
+            {
+                auto size = std::distance(begin, end);
+                table_.reserve(table_.size() + size_type(size));
+
+                insert_range_impl(std::input_iterator_tag{}, begin, end);
+            }
+
+            detail::hash_table<traits, Hash, BlockStorage> table_;
+        };
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_FLAT_HASH_SET_HPP_INCLUDED
@@ -232,21 +232,876 @@ namespace foonathan
                 template <typename, typename>
                 friend class flat_map_iterator;
             };
+
+            template <typename Key, typename Value>
+            class flat_map_pair_iterator
+            {
+                using pair = key_value_pair<Key, typename std::remove_const<Value>::type>;
+
+            public:
+                struct private_key
+                {
+                    explicit private_key() {}
+                };
+
+                using iterator_category = std::random_access_iterator_tag;
+                using value_type        = key_value_ref<Key, Value>;
+                using difference_type   = std::ptrdiff_t;
+
+                struct pointer
+                {
+                    mutable value_type pair;
+
+                    value_type* operator->() const noexcept
+                    {
+                        return &pair;
+                    }
+                };
+
+                using reference = value_type; // can't use a real reference
+
+                flat_map_pair_iterator() noexcept = default;
+
+                explicit flat_map_pair_iterator(private_key, const pair* p) noexcept : pair_(p) {}
+
+                template <typename NonConstValue,
+                          typename = typename std::enable_if<
+                              std::is_const<Value>::value
+                              && std::is_same<NonConstValue,
+                                              typename std::remove_const<Value>::type>::value>::type>
+                flat_map_pair_iterator(
+                    const flat_map_pair_iterator<Key, NonConstValue>& non_const) noexcept
+                : pair_(non_const.pair_)
+                {
+                }
+
+                //=== access ===//
+                reference operator*() const noexcept
+                {
+                    // note: the value is mutable
+                    return reference(pair_->key, pair_->value);
+                }
+
+                pointer operator->() const noexcept
+                {
+                    return pointer{**this};
+                }
+
+                value_type operator[](difference_type offset) const noexcept
+                {
+                    return *(*this + offset);
+                }
+
+                const pair* get_pair_pointer(private_key) const noexcept
+                {
+                    return pair_;
+                }
+
+                //=== increment/decrement ===//
+                flat_map_pair_iterator& operator++() noexcept
+                {
+                    return *this += 1;
+                }
+                flat_map_pair_iterator operator++(int) noexcept
+                {
+                    auto save = *this;
+                    ++*this;
+                    return save;
+                }
+
+                flat_map_pair_iterator& operator--() noexcept
+                {
+                    return *this += -1;
+                }
+                flat_map_pair_iterator operator--(int) noexcept
+                {
+                    auto save = *this;
+                    --*this;
+                    return save;
+                }
+
+                flat_map_pair_iterator& operator+=(difference_type offset) noexcept
+                {
+                    pair_ += offset;
+                    return *this;
+                }
+                flat_map_pair_iterator& operator-=(difference_type offset) noexcept
+                {
+                    return *this += -offset;
+                }
+
+                //=== addition/subtraction ===//
+                friend flat_map_pair_iterator operator+(flat_map_pair_iterator iter,
+                                                        difference_type        offset) noexcept
+                {
+                    return flat_map_pair_iterator(private_key{}, iter.pair_ + offset);
+                }
+                friend flat_map_pair_iterator operator+(difference_type        offset,
+                                                        flat_map_pair_iterator iter) noexcept
+                {
+                    return iter + offset;
+                }
+
+                friend flat_map_pair_iterator operator-(flat_map_pair_iterator iter,
+                                                        difference_type        offset) noexcept
+                {
+                    return iter + (-offset);
+                }
+                friend flat_map_pair_iterator operator-(difference_type        offset,
+                                                        flat_map_pair_iterator iter) noexcept
+                {
+                    return iter - offset;
+                }
+
+                friend difference_type operator-(flat_map_pair_iterator lhs,
+                                                 flat_map_pair_iterator rhs)
+                {
+                    return lhs.pair_ - rhs.pair_;
+                }
+
+                //=== comparison ===//
+                friend bool operator==(flat_map_pair_iterator lhs,
+                                       flat_map_pair_iterator rhs) noexcept
+                {
+                    return lhs.pair_ == rhs.pair_;
+                }
+                friend bool operator!=(flat_map_pair_iterator lhs,
+                                       flat_map_pair_iterator rhs) noexcept
+                {
+                    return lhs.pair_ != rhs.pair_;
+                }
+
+                friend bool operator<(flat_map_pair_iterator lhs,
+                                      flat_map_pair_iterator rhs) noexcept
+                {
+                    return lhs.pair_ < rhs.pair_;
+                }
+                friend bool operator>(flat_map_pair_iterator lhs,
+                                      flat_map_pair_iterator rhs) noexcept
+                {
+                    return lhs.pair_ > rhs.pair_;
+                }
+                friend bool operator<=(flat_map_pair_iterator lhs,
+                                       flat_map_pair_iterator rhs) noexcept
+                {
+                    return lhs.pair_ <= rhs.pair_;
+                }
+                friend bool operator>=(flat_map_pair_iterator lhs,
+                                       flat_map_pair_iterator rhs) noexcept
+                {
+                    return lhs.pair_ >= rhs.pair_;
+                }
+
+            private:
+                const pair* pair_;
+
+                template <typename, typename>
+                friend class flat_map_pair_iterator;
+            };
+        } // namespace detail
+
+        /// Layout of an [array::flat_map]() that stores keys and values in two separate arrays.
+        ///
+        /// Each array has its own `BlockStorage`, so they are reallocated separately.
+        struct separate_arrays_layout
+        {
+        };
+
+        /// Layout of an [array::flat_map]() that stores keys and values in a single memory block.
+        ///
+        /// The block contains all keys followed by all values, and is allocated by a single `BlockStorage`,
+        /// so there is only one allocation and one capacity.
+        /// When the capacity is exhausted, the size of the new block is determined by the `GrowthPolicy` of the `BlockStorage`.
+        /// \requires The `BlockStorage` must not embed objects.
+        struct single_block_layout
+        {
+        };
+
+        /// Layout of an [array::flat_map]() that stores [array::key_value_pair]() objects in a single array.
+        ///
+        /// As each value is stored right next to its key, accessing the value after a lookup doesn't touch another cache line.
+        /// This is beneficial for small values, but makes the lookup itself slower for bigger ones.
+        /// \notes As the keys and values aren't stored in separate arrays,
+        /// the functions providing views or iterators to only the keys or only the values are not available.
+        struct array_of_structs_layout
+        {
+        };
+
+        namespace detail
+        {
+            template <typename T, typename Arg>
+            auto flat_map_assign(T* ptr, Arg&& arg) -> decltype(*ptr = std::forward<Arg>(arg))
+            {
+                return *ptr = std::forward<Arg>(arg);
+            }
+            template <typename T, typename... Args>
+            void flat_map_assign(T* ptr, Args&&... args)
+            {
+                *ptr = T(std::forward<Args>(args)...);
+            }
+
+            // compares a key_value_pair by only comparing the key
+            template <class Compare>
+            struct flat_map_pair_compare
+            {
+                template <typename Key, typename Value, typename TransparentKey>
+                static auto compare(const key_value_pair<Key, Value>& pair,
+                                    const TransparentKey&             key) noexcept
+                    -> decltype(Compare::compare(pair.key, key))
+                {
+                    return Compare::compare(pair.key, key);
+                }
+            };
+
+            // appends the elements of two input views of the same size to an empty storage,
+            // used by the layouts that can't steal the memory of the views
+            template <class Storage, typename Key, typename Value, class BlockStorage>
+            void flat_map_append_sorted(Storage& storage, input_view<Key, BlockStorage>&& keys,
+                                        input_view<Value, BlockStorage>&& values)
+            {
+                assert(keys.size() == values.size());
+                storage.clear();
+                storage.reserve(keys.size());
+
+                auto value = values.view().begin();
+                for (auto& key : keys.view())
+                {
+                    // safe, according to precondition of input view, we're allowed to move them
+                    auto& non_const_key   = const_cast<Key&>(key);
+                    auto& non_const_value = const_cast<Value&>(*value++);
+                    storage.emplace(storage.size(),
+                                    keys.will_copy() ? Key(key) : Key(std::move(non_const_key)),
+                                    values.will_copy() ? Value(non_const_value)
+                                                       : Value(std::move(non_const_value)));
+                }
+            }
+
+            // stores the keys and values of a flat_map
+            //
+            // the search range is a contiguous range ordered by the key,
+            // search_compare<Compare> compares its elements with a key
+            template <typename Key, typename Value, class BlockStorage, class Layout>
+            class flat_map_storage;
+
+            template <typename Key, typename Value, class BlockStorage>
+            class flat_map_storage<Key, Value, BlockStorage, separate_arrays_layout>
+            {
+            public:
+                using iterator       = flat_map_iterator<Key, Value>;
+                using const_iterator = flat_map_iterator<Key, const Value>;
+
+                template <class Compare>
+                using search_compare = Compare;
+
+                const Key* search_data() const noexcept
+                {
+                    return keys();
+                }
+
+                iterator make_iterator(size_type index) noexcept
+                {
+                    return iterator(typename iterator::private_key{}, keys() + index,
+                                    values() + index);
+                }
+                const_iterator make_iterator(size_type index) const noexcept
+                {
+                    return const_iterator(typename const_iterator::private_key{}, keys() + index,
+                                          values() + index);
+                }
+
+                size_type index_of(const_iterator iter) const noexcept
+                {
+                    auto key = iter.get_key_pointer(typename const_iterator::private_key{});
+                    assert(key >= keys() && key <= keys() + size());
+                    return size_type(key - keys());
+                }
+
+                flat_map_storage() = default;
+
+                explicit flat_map_storage(typename BlockStorage::arg_type args) noexcept
+                : keys_(args), values_(std::move(args))
+                {
+                }
+
+                friend void swap(flat_map_storage& lhs, flat_map_storage& rhs) noexcept(
+                    block_storage_nothrow_move<BlockStorage, Key>{})
+                {
+                    swap(lhs.keys_, rhs.keys_);
+                    swap(lhs.values_, rhs.values_);
+                }
+
+                const Key* keys() const noexcept
+                {
+                    return iterator_to_pointer(keys_.begin());
+                }
+
+                Value* values() noexcept
+                {
+                    return iterator_to_pointer(values_.begin());
+                }
+                const Value* values() const noexcept
+                {
+                    return iterator_to_pointer(values_.begin());
+                }
+
+                size_type size() const noexcept
+                {
+                    return keys_.size();
+                }
+
+                size_type capacity() const noexcept
+                {
+                    return std::min(keys_.capacity(), values_.capacity());
+                }
+
+                size_type max_size() const noexcept
+                {
+                    return std::min(keys_.max_size(), values_.max_size());
+                }
+
+                void reserve(size_type new_capacity)
+                {
+                    keys_.reserve(new_capacity);
+                    values_.reserve(new_capacity);
+                }
+
+                void shrink_to_fit()
+                {
+                    keys_.shrink_to_fit();
+                    values_.shrink_to_fit();
+                }
+
+                void clear() noexcept
+                {
+                    keys_.clear();
+                    values_.clear();
+                }
+
+                template <typename TransparentKey, typename... ValueArgs>
+                void emplace(size_type index, TransparentKey&& key, ValueArgs&&... args)
+                {
+                    auto key_iter = keys_.emplace(keys_.begin() + std::ptrdiff_t(index),
+                                                  std::forward<TransparentKey>(key));
+                    try
+                    {
+                        values_.emplace(values_.begin() + std::ptrdiff_t(index),
+                                        std::forward<ValueArgs>(args)...);
+                    }
+                    catch (...)
+                    {
+                        keys_.erase(key_iter);
+                        throw;
+                    }
+                }
+
+                void assign_sorted(input_view<Key, BlockStorage>&&   keys,
+                                   input_view<Value, BlockStorage>&& values)
+                {
+                    assert(keys.size() == values.size());
+                    keys_.assign(std::move(keys));
+                    values_.assign(std::move(values));
+                }
+
+                void move_element(size_type dest, size_type src) noexcept(
+                    std::is_nothrow_move_assignable<Key>::value
+                    && std::is_nothrow_move_assignable<Value>::value)
+                {
+                    keys_[dest]   = std::move(keys_[src]);
+                    values_[dest] = std::move(values_[src]);
+                }
+
+                void erase_range(size_type begin, size_type end) noexcept(
+                    std::is_nothrow_move_assignable<Key>::value
+                    && std::is_nothrow_move_assignable<Value>::value)
+                {
+                    keys_.erase_range(keys_.begin() + std::ptrdiff_t(begin),
+                                      keys_.begin() + std::ptrdiff_t(end));
+                    values_.erase_range(values_.begin() + std::ptrdiff_t(begin),
+                                        values_.begin() + std::ptrdiff_t(end));
+                }
+
+            private:
+                array<Key, BlockStorage>   keys_;
+                array<Value, BlockStorage> values_;
+            };
+
+            template <typename Key, typename Value, class BlockStorage>
+            class flat_map_storage<Key, Value, BlockStorage, single_block_layout>
+            {
+                static_assert(!BlockStorage::embedded_storage::value,
+                              "single_block_layout requires a BlockStorage that doesn't embed "
+                              "objects");
+
+                // the type used to request memory with the required alignment
+                using align_type =
+                    typename std::conditional<(alignof(Key) > alignof(Value)), Key, Value>::type;
+
+            public:
+                using iterator       = flat_map_iterator<Key, Value>;
+                using const_iterator = flat_map_iterator<Key, const Value>;
+
+                template <class Compare>
+                using search_compare = Compare;
+
+                const Key* search_data() const noexcept
+                {
+                    return keys();
+                }
+
+                iterator make_iterator(size_type index) noexcept
+                {
+                    return iterator(typename iterator::private_key{}, keys() + index,
+                                    values() + index);
+                }
+                const_iterator make_iterator(size_type index) const noexcept
+                {
+                    return const_iterator(typename const_iterator::private_key{}, keys() + index,
+                                          values() + index);
+                }
+
+                size_type index_of(const_iterator iter) const noexcept
+                {
+                    auto key = iter.get_key_pointer(typename const_iterator::private_key{});
+                    assert(key >= keys() && key <= keys() + size());
+                    return size_type(key - keys());
+                }
+
+                flat_map_storage() : flat_map_storage(typename BlockStorage::arg_type{}) {}
+
+                explicit flat_map_storage(typename BlockStorage::arg_type args) noexcept
+                : storage_(std::move(args)), size_(0u), capacity_(0u)
+                {
+                }
+
+                flat_map_storage(const flat_map_storage& other)
+                : flat_map_storage(other.storage_.arguments())
+                {
+                    reserve(other.size_);
+
+                    auto keys = uninitialized_copy(other.keys(), other.keys() + other.size_,
+                                                   key_block(capacity_));
+                    try
+                    {
+                        uninitialized_copy(other.values(), other.values() + other.size_,
+                                           value_block(capacity_));
+                    }
+                    catch (...)
+                    {
+                        destroy_range(mutable_keys(), to_pointer<Key>(keys));
+                        throw;
+                    }
+                    size_ = other.size_;
+                }
+
+                flat_map_storage(flat_map_storage&& other) noexcept
+                : flat_map_storage(other.storage_.arguments())
+                {
+                    swap(*this, other);
+                }
+
+                ~flat_map_storage() noexcept
+                {
+                    clear();
+                }
+
+                flat_map_storage& operator=(const flat_map_storage& other)
+                {
+                    flat_map_storage tmp(other);
+                    swap(*this, tmp);
+                    return *this;
+                }
+
+                flat_map_storage& operator=(flat_map_storage&& other) noexcept
+                {
+                    flat_map_storage tmp(std::move(other));
+                    swap(*this, tmp);
+                    return *this;
+                }
+
+                friend void swap(flat_map_storage& lhs, flat_map_storage& rhs) noexcept
+                {
+                    // only swaps pointers as the storage doesn't embed objects
+                    block_view<align_type> lhs_view, rhs_view;
+                    BlockStorage::swap(lhs.storage_, lhs_view, rhs.storage_, rhs_view);
+                    std::swap(lhs.size_, rhs.size_);
+                    std::swap(lhs.capacity_, rhs.capacity_);
+                }
+
+                const Key* keys() const noexcept
+                {
+                    return to_pointer<Key>(storage_.block().begin());
+                }
+
+                Value* values() noexcept
+                {
+                    return to_pointer<Value>(storage_.block().begin() + value_offset(capacity_));
+                }
+                const Value* values() const noexcept
+                {
+                    return to_pointer<Value>(storage_.block().begin() + value_offset(capacity_));
+                }
+
+                size_type size() const noexcept
+                {
+                    return size_;
+                }
+
+                size_type capacity() const noexcept
+                {
+                    return capacity_;
+                }
+
+                size_type max_size() const noexcept
+                {
+                    return BlockStorage::max_size(storage_.arguments())
+                           / (sizeof(Key) + sizeof(Value));
+                }
+
+                void reserve(size_type new_capacity)
+                {
+                    if (new_capacity > capacity_)
+                        relocate(new_capacity);
+                }
+
+                void shrink_to_fit()
+                {
+                    if (size_ == 0u)
+                    {
+                        // release the memory
+                        flat_map_storage empty(storage_.arguments());
+                        swap(*this, empty);
+                    }
+                    else if (size_ < capacity_)
+                        relocate(size_);
+                }
+
+                void clear() noexcept
+                {
+                    destroy_range(mutable_keys(), mutable_keys() + size_);
+                    destroy_range(values(), values() + size_);
+                    size_ = 0u;
+                }
+
+                template <typename TransparentKey, typename... ValueArgs>
+                void emplace(size_type index, TransparentKey&& key, ValueArgs&&... args)
+                {
+                    if (size_ == capacity_)
+                        grow();
+
+                    insert_at(mutable_keys(), index, std::forward<TransparentKey>(key));
+                    try
+                    {
+                        insert_at(values(), index, std::forward<ValueArgs>(args)...);
+                    }
+                    catch (...)
+                    {
+                        erase_at(mutable_keys(), size_ + 1u, index, index + 1u);
+                        throw;
+                    }
+                    ++size_;
+                }
+
+                void assign_sorted(input_view<Key, BlockStorage>&&   keys,
+                                   input_view<Value, BlockStorage>&& values)
+                {
+                    flat_map_append_sorted(*this, std::move(keys), std::move(values));
+                }
+
+                void move_element(size_type dest, size_type src) noexcept(
+                    std::is_nothrow_move_assignable<Key>::value
+                    && std::is_nothrow_move_assignable<Value>::value)
+                {
+                    mutable_keys()[dest] = std::move(mutable_keys()[src]);
+                    values()[dest]       = std::move(values()[src]);
+                }
+
+                void erase_range(size_type begin, size_type end) noexcept(
+                    std::is_nothrow_move_assignable<Key>::value
+                    && std::is_nothrow_move_assignable<Value>::value)
+                {
+                    erase_at(mutable_keys(), size_, begin, end);
+                    erase_at(values(), size_, begin, end);
+                    size_ -= end - begin;
+                }
+
+            private:
+                static size_type value_offset(size_type capacity) noexcept
+                {
+                    auto key_bytes = capacity * sizeof(Key);
+                    auto remainder = key_bytes % alignof(Value);
+                    return remainder == 0u ? key_bytes : key_bytes + alignof(Value) - remainder;
+                }
+
+                static size_type block_size(size_type capacity) noexcept
+                {
+                    return value_offset(capacity) + capacity * sizeof(Value);
+                }
+
+                static size_type capacity_for(size_type block_size) noexcept
+                {
+                    // ignoring padding it can't be bigger than that
+                    auto capacity = block_size / (sizeof(Key) + sizeof(Value));
+                    while (capacity > 0u && flat_map_storage::block_size(capacity) > block_size)
+                        --capacity;
+                    return capacity;
+                }
+
+                memory_block key_block(size_type capacity) const noexcept
+                {
+                    return memory_block(storage_.block().begin(), capacity * sizeof(Key));
+                }
+
+                memory_block value_block(size_type capacity) const noexcept
+                {
+                    return memory_block(storage_.block().begin() + value_offset(capacity),
+                                        capacity * sizeof(Value));
+                }
+
+                Key* mutable_keys() noexcept
+                {
+                    return to_pointer<Key>(storage_.block().begin());
+                }
+
+                // the block size reserve() would use, doubling if the storage doesn't tell
+                template <class Storage>
+                static auto next_block_size(int, const Storage& storage,
+                                            size_type min_additional_bytes) noexcept
+                    -> decltype(storage.template growth_size<align_type>(min_additional_bytes))
+                {
+                    return storage.template growth_size<align_type>(min_additional_bytes);
+                }
+                template <class Storage>
+                static size_type next_block_size(short, const Storage& storage,
+                                                 size_type min_additional_bytes) noexcept
+                {
+                    auto cur_size = storage.block().size();
+                    return std::max(2u * cur_size, cur_size + min_additional_bytes);
+                }
+
+                void grow()
+                {
+                    // grow the block like the GrowthPolicy grows it for the other layouts
+                    auto needed   = block_size(capacity_ + 1u) - storage_.block().size();
+                    auto new_size = next_block_size(0, storage_, needed);
+                    relocate(capacity_for(new_size));
+                }
+
+                void relocate(size_type new_capacity)
+                {
+                    // allocate the new block in a temporary storage
+                    flat_map_storage temp(storage_.arguments());
+                    temp.storage_.reserve(block_size(new_capacity), block_view<align_type>());
+                    temp.capacity_ = capacity_for(temp.storage_.block().size());
+                    assert(temp.capacity_ >= new_capacity);
+
+                    // move the keys and values over
+                    uninitialized_move_if_noexcept(mutable_keys(), mutable_keys() + size_,
+                                                   temp.key_block(temp.capacity_));
+                    try
+                    {
+                        uninitialized_move_if_noexcept(values(), values() + size_,
+                                                       temp.value_block(temp.capacity_));
+                    }
+                    catch (...)
+                    {
+                        destroy_range(temp.mutable_keys(), temp.mutable_keys() + size_);
+                        throw;
+                    }
+                    temp.size_ = size_;
+
+                    // temp now owns the objects, the destructor will destroy the old ones
+                    swap(*this, temp);
+                }
+
+                template <typename T, typename... Args>
+                void insert_at(T* data, size_type index, Args&&... args)
+                {
+                    if (index == size_)
+                        construct_object<T>(to_raw_pointer(data + size_),
+                                            std::forward<Args>(args)...);
+                    else
+                    {
+                        // move all elements following it one over
+                        construct_object<T>(to_raw_pointer(data + size_),
+                                            std::move(data[size_ - 1u]));
+                        std::move_backward(data + index, data + size_ - 1u, data + size_);
+
+                        try
+                        {
+                            // assign the element at the now empty position
+                            flat_map_assign(data + index, std::forward<Args>(args)...);
+                        }
+                        catch (...)
+                        {
+                            erase_at(data, size_ + 1u, index, index + 1u);
+                            throw;
+                        }
+                    }
+                }
+
+                template <typename T>
+                static void erase_at(T* data, size_type size, size_type begin,
+                                     size_type end) noexcept(std::is_nothrow_move_assignable<
+                                                             T>::value)
+                {
+                    if (begin != end)
+                    {
+                        // move all elements after to the front, then destroy the ones at the end
+                        std::move(data + end, data + size, data + begin);
+                        destroy_range(data + size - (end - begin), data + size);
+                    }
+                }
+
+                BlockStorage storage_;
+                size_type    size_, capacity_;
+            };
+
+            template <typename Key, typename Value, class BlockStorage>
+            class flat_map_storage<Key, Value, BlockStorage, array_of_structs_layout>
+            {
+                using pair = key_value_pair<Key, Value>;
+
+            public:
+                using iterator       = flat_map_pair_iterator<Key, Value>;
+                using const_iterator = flat_map_pair_iterator<Key, const Value>;
+
+                template <class Compare>
+                using search_compare = flat_map_pair_compare<Compare>;
+
+                flat_map_storage() = default;
+
+                explicit flat_map_storage(typename BlockStorage::arg_type args) noexcept
+                : pairs_(std::move(args))
+                {
+                }
+
+                friend void swap(flat_map_storage& lhs, flat_map_storage& rhs) noexcept(
+                    block_storage_nothrow_move<BlockStorage, pair>{})
+                {
+                    swap(lhs.pairs_, rhs.pairs_);
+                }
+
+                const pair* search_data() const noexcept
+                {
+                    return iterator_to_pointer(pairs_.begin());
+                }
+
+                iterator make_iterator(size_type index) noexcept
+                {
+                    return iterator(typename iterator::private_key{}, search_data() + index);
+                }
+                const_iterator make_iterator(size_type index) const noexcept
+                {
+                    return const_iterator(typename const_iterator::private_key{},
+                                          search_data() + index);
+                }
+
+                size_type index_of(const_iterator iter) const noexcept
+                {
+                    auto ptr = iter.get_pair_pointer(typename const_iterator::private_key{});
+                    assert(ptr >= search_data() && ptr <= search_data() + size());
+                    return size_type(ptr - search_data());
+                }
+
+                size_type size() const noexcept
+                {
+                    return pairs_.size();
+                }
+
+                size_type capacity() const noexcept
+                {
+                    return pairs_.capacity();
+                }
+
+                size_type max_size() const noexcept
+                {
+                    return pairs_.max_size();
+                }
+
+                void reserve(size_type new_capacity)
+                {
+                    pairs_.reserve(new_capacity);
+                }
+
+                void shrink_to_fit()
+                {
+                    pairs_.shrink_to_fit();
+                }
+
+                void clear() noexcept
+                {
+                    pairs_.clear();
+                }
+
+                template <typename TransparentKey, typename... ValueArgs>
+                void emplace(size_type index, TransparentKey&& key, ValueArgs&&... args)
+                {
+                    pairs_.emplace(pairs_.begin() + std::ptrdiff_t(index),
+                                   std::forward<TransparentKey>(key),
+                                   std::forward<ValueArgs>(args)...);
+                }
+
+                void assign_sorted(input_view<Key, BlockStorage>&&   keys,
+                                   input_view<Value, BlockStorage>&& values)
+                {
+                    flat_map_append_sorted(*this, std::move(keys), std::move(values));
+                }
+
+                void move_element(size_type dest, size_type src) noexcept(
+                    std::is_nothrow_move_assignable<pair>::value)
+                {
+                    pairs_[dest] = std::move(pairs_[src]);
+                }
+
+                void erase_range(size_type begin, size_type end) noexcept(
+                    std::is_nothrow_move_assignable<pair>::value)
+                {
+                    pairs_.erase_range(pairs_.begin() + std::ptrdiff_t(begin),
+                                       pairs_.begin() + std::ptrdiff_t(end));
+                }
+
+            private:
+                array<pair, BlockStorage> pairs_;
+            };
         } // namespace detail
 
         /// A sorted map of keys to values.
         ///
         /// It is similar to [std::map]() or [std::multimap]() — depending on `AllowDuplicates`,
-        /// but uses a [array::flat_set]() for the key storage and an [array::array]() internally, both using the given `BlockStorage`.
+        /// but stores the keys in sorted order and the values in a separate array using the given `BlockStorage`.
         /// Matching keys and values are implicitly linked by being stored at the same index.
         ///
+        /// The `Layout` controls how the keys and values are stored:
+        /// [array::separate_arrays_layout]() uses two arrays, each with its own `BlockStorage`,
+        /// [array::single_block_layout]() stores both in a single memory block
+        /// and [array::array_of_structs_layout]() stores them as pairs in a single array.
+        ///
         /// `Compare` must be a `KeyCompare` type, not something like [std::less]().
+        /// The `SearchPolicy` controls how the sorted keys are searched, e.g. [array::binary_search]().
         template <typename Key, typename Value, class Compare = key_compare_default,
-                  class BlockStorage = block_storage_default, bool AllowDuplicates = false>
-        class flat_map
+                  class BlockStorage = block_storage_default, bool AllowDuplicates = false,
+                  class Layout = separate_arrays_layout, class SearchPolicy = search_default>
+        class flat_map : detail::search_index<SearchPolicy, Key, BlockStorage>
         {
-            using key_storage   = flat_set<Key, Compare, BlockStorage, AllowDuplicates>;
-            using value_storage = array<Value, BlockStorage>;
+            // separate tags, so the iterators are different even if Key and Value are the same
+            class key_iterator_tag
+            {
+                constexpr key_iterator_tag() = default;
+
+                friend flat_map;
+            };
+
+            class value_iterator_tag
+            {
+                constexpr value_iterator_tag() = default;
+
+                friend flat_map;
+            };
+
+            using storage        = detail::flat_map_storage<Key, Value, BlockStorage, Layout>;
+            using search_compare = typename storage::template search_compare<Compare>;
+
+            using search_index_type = detail::search_index<SearchPolicy, Key, BlockStorage>;
 
         public:
             using key_type   = Key;
@@ -258,14 +1113,16 @@ namespace foonathan
             using is_multimap = std::integral_constant<bool, AllowDuplicates>;
 
             using block_storage = BlockStorage;
+            using layout        = Layout;
+            using search_policy = SearchPolicy;
 
-            using key_iterator         = typename key_storage::iterator;
+            using key_iterator         = pointer_iterator<key_iterator_tag, const Key>;
             using key_const_iterator   = key_iterator;
-            using value_iterator       = typename value_storage::iterator;
-            using value_const_iterator = typename value_storage::const_iterator;
+            using value_iterator       = pointer_iterator<value_iterator_tag, Value>;
+            using value_const_iterator = pointer_iterator<value_iterator_tag, const Value>;
 
-            using iterator       = detail::flat_map_iterator<Key, Value>;
-            using const_iterator = detail::flat_map_iterator<Key, const Value>;
+            using iterator       = typename storage::iterator;
+            using const_iterator = typename storage::const_iterator;
 
             //=== constructors/destructors ===//
             /// Default constructor.
@@ -275,9 +1132,10 @@ namespace foonathan
 
             /// \effects Creates a map without any elements.
             /// The block storage is initialized with the given arguments.
-            /// \notes It will be copied to initialize the two different containers.
+            /// \notes It will be copied to initialize the two different containers,
+            /// if the layout uses two.
             explicit flat_map(typename block_storage::arg_type args) noexcept
-            : keys_(args), values_(std::move(args))
+            : search_index_type(args), storage_(std::move(args))
             {
             }
 
@@ -285,34 +1143,32 @@ namespace foonathan
             friend void swap(flat_map& lhs, flat_map& rhs) noexcept(
                 block_storage_nothrow_move<BlockStorage, Key>{})
             {
-                swap(lhs.keys_, rhs.keys_);
-                swap(lhs.values_, rhs.values_);
+                swap(lhs.storage_, rhs.storage_);
+                swap(lhs.search_index(), rhs.search_index());
             }
 
             //=== access ===//
             /// \returns An array view to the keys.
             sorted_view<const Key, Compare> keys() const noexcept
             {
-                return keys_;
+                return sorted_view<const Key, Compare>(storage_.keys(), storage_.size());
             }
 
             /// \returns An array view to the mapped values.
             /// \group values
             array_view<Value> values() noexcept
             {
-                return values_;
+                return array_view<Value>(storage_.values(), storage_.size());
             }
             /// \group values
             array_view<const Value> values() const noexcept
             {
-                return values_;
+                return array_view<const Value>(storage_.values(), storage_.size());
             }
 
             iterator begin() noexcept
             {
-                auto key_ptr   = iterator_to_pointer(keys_.begin());
-                auto value_ptr = iterator_to_pointer(values_.begin());
-                return iterator(typename iterator::private_key{}, key_ptr, value_ptr);
+                return storage_.make_iterator(0u);
             }
             const_iterator begin() const noexcept
             {
@@ -320,16 +1176,12 @@ namespace foonathan
             }
             const_iterator cbegin() const noexcept
             {
-                auto key_ptr   = iterator_to_pointer(keys_.begin());
-                auto value_ptr = iterator_to_pointer(values_.begin());
-                return const_iterator(typename const_iterator::private_key{}, key_ptr, value_ptr);
+                return storage_.make_iterator(0u);
             }
 
             iterator end() noexcept
             {
-                auto key_ptr   = iterator_to_pointer(keys_.end());
-                auto value_ptr = iterator_to_pointer(values_.end());
-                return iterator(typename iterator::private_key{}, key_ptr, value_ptr);
+                return begin() + std::ptrdiff_t(size());
             }
             const_iterator end() const noexcept
             {
@@ -337,9 +1189,7 @@ namespace foonathan
             }
             const_iterator cend() const noexcept
             {
-                auto key_ptr   = iterator_to_pointer(keys_.end());
-                auto value_ptr = iterator_to_pointer(values_.end());
-                return const_iterator(typename const_iterator::private_key{}, key_ptr, value_ptr);
+                return cbegin() + std::ptrdiff_t(size());
             }
 
             /// \returns The key iterator corresponding to the given iterator.
@@ -347,7 +1197,7 @@ namespace foonathan
             /// \group key_iter
             key_const_iterator key_iter(const_iterator iter) const noexcept
             {
-                return keys_.begin() + index_of(iter);
+                return key_begin() + std::ptrdiff_t(index_of(iter));
             }
 
             /// \returns The key iterator corresponding to the given iterator.
@@ -355,49 +1205,49 @@ namespace foonathan
             /// \group value_iter
             value_iterator value_iter(const_iterator iter) noexcept
             {
-                return values_.begin() + index_of(iter);
+                return value_begin() + std::ptrdiff_t(index_of(iter));
             }
             /// \group value_iter
             value_const_iterator value_iter(const_iterator iter) const noexcept
             {
-                return values_.begin() + index_of(iter);
+                return value_begin() + std::ptrdiff_t(index_of(iter));
             }
 
             key_iterator key_begin() noexcept
             {
-                return keys_.begin();
+                return key_iterator(key_iterator_tag{}, storage_.keys());
             }
             key_const_iterator key_begin() const noexcept
             {
-                return keys_.begin();
+                return key_iterator(key_iterator_tag{}, storage_.keys());
             }
             key_const_iterator key_cbegin() const noexcept
             {
-                return keys_.cbegin();
+                return key_begin();
             }
 
             key_iterator key_end() noexcept
             {
-                return keys_.end();
+                return key_begin() + std::ptrdiff_t(size());
             }
             key_const_iterator key_end() const noexcept
             {
-                return keys_.end();
+                return key_begin() + std::ptrdiff_t(size());
             }
             key_const_iterator key_cend() const noexcept
             {
-                return keys_.cend();
+                return key_end();
             }
 
             /// \group value_iter
             value_iterator value_iter(key_const_iterator iter) noexcept
             {
-                return values_.begin() + index_of(iter);
+                return value_begin() + std::ptrdiff_t(index_of(iter));
             }
             /// \group value_iter
             value_const_iterator value_iter(key_const_iterator iter) const noexcept
             {
-                return values_.begin() + index_of(iter);
+                return value_begin() + std::ptrdiff_t(index_of(iter));
             }
 
             /// \returns The iterator corresponding to the given key or value iterator.
@@ -405,125 +1255,118 @@ namespace foonathan
             /// \group key_value_iter
             iterator key_value_iter(key_const_iterator iter) noexcept
             {
-                return iterator(typename iterator::private_key{}, iterator_to_pointer(iter),
-                                iterator_to_pointer(value_iter(iter)));
+                return begin() + std::ptrdiff_t(index_of(iter));
             }
             /// \group key_value_iter
             const_iterator key_value_iter(key_const_iterator iter) const noexcept
             {
-                return const_iterator(typename const_iterator::private_key{},
-                                      iterator_to_pointer(iter),
-                                      iterator_to_pointer(value_iter(iter)));
+                return begin() + std::ptrdiff_t(index_of(iter));
             }
 
             value_iterator value_begin() noexcept
             {
-                return values_.begin();
+                return value_iterator(value_iterator_tag{}, storage_.values());
             }
             value_const_iterator value_begin() const noexcept
             {
-                return values_.begin();
+                return value_const_iterator(value_iterator_tag{}, storage_.values());
             }
             value_const_iterator value_cbegin() const noexcept
             {
-                return values_.cbegin();
+                return value_begin();
             }
 
             value_iterator value_end() noexcept
             {
-                return values_.end();
+                return value_begin() + std::ptrdiff_t(size());
             }
             value_const_iterator value_end() const noexcept
             {
-                return values_.end();
+                return value_begin() + std::ptrdiff_t(size());
             }
             value_const_iterator value_cend() const noexcept
             {
-                return values_.cend();
+                return value_end();
             }
 
             /// \group key_iter
             key_const_iterator key_iter(value_const_iterator iter) const noexcept
             {
-                return keys_.begin() + index_of(iter);
+                return key_begin() + std::ptrdiff_t(index_of(iter));
             }
 
             /// \group key_value_iter
             iterator key_value_iter(value_const_iterator iter) noexcept
             {
-                return iterator(typename iterator::private_key{},
-                                iterator_to_pointer(key_iter(iter)),
-                                const_cast<Value*>(iterator_to_pointer(iter)));
+                return begin() + std::ptrdiff_t(index_of(iter));
             }
             /// \group key_value_iter
             const_iterator key_value_iter(value_const_iterator iter) const noexcept
             {
-                return const_iterator(typename const_iterator::private_key{},
-                                      iterator_to_pointer(key_iter(iter)),
-                                      iterator_to_pointer(iter));
+                return begin() + std::ptrdiff_t(index_of(iter));
             }
 
             /// \returns The key value pair with the minimal key.
             /// \group min
             key_value_ref<Key, Value> min() noexcept
             {
-                return {keys_.min(), values_.front()};
+                return *begin();
             }
             /// \group min
             key_value_ref<Key, const Value> min() const noexcept
             {
-                return {keys_.min(), values_.front()};
+                return *begin();
             }
 
             /// \returns The key value pair with the maximal key.
             /// \group max
             key_value_ref<Key, Value> max() noexcept
             {
-                return {keys_.max(), values_.back()};
+                return *std::prev(end());
             }
             /// \group max
             key_value_ref<Key, const Value> max() const noexcept
             {
-                return {keys_.max(), values_.back()};
+                return *std::prev(end());
             }
 
             //=== capacity ===//
             /// \returns Whether or not the map is empty.
             bool empty() const noexcept
             {
-                return keys_.empty();
+                return size() == 0u;
             }
 
             /// \returns The number of elements in the map.
             size_type size() const noexcept
             {
-                return keys_.size();
+                return storage_.size();
             }
 
             /// \returns The number of elements the map can contain without reserving new memory.
             size_type capacity() const noexcept
             {
-                return std::min(keys_.capacity(), values_.capacity());
+                return storage_.capacity();
             }
 
             /// \returns The maximum number of elements as determined by the block storage.
             size_type max_size() const noexcept
             {
-                return std::min(keys_.max_size(), values_.max_size());
+                return storage_.max_size();
             }
 
             /// \effects Reserves new memory to make capacity as least as big as `new_capacity` if that isn't the case already.
             void reserve(size_type new_capacity)
             {
-                keys_.reserve(new_capacity);
-                values_.reserve(new_capacity);
+                storage_.reserve(new_capacity);
+                search_index().reserve(new_capacity);
             }
 
             /// \effects Non-binding request to make the capacity as small as necessary.
             void shrink_to_fit()
             {
-                keys_.shrink_to_fit();
-                values_.shrink_to_fit();
+                storage_.shrink_to_fit();
+                search_index().shrink_to_fit();
             }
 
             //=== modifiers ===//
@@ -572,20 +1415,28 @@ namespace foonathan
             /// where the key is constructed from the transparent key and the value is constructed from the arguments.
             /// Otherwise, does nothing.
             /// \returns The result of the insert operation.
+            /// \notes If the key is sorted after all keys in the map,
+            /// it is appended without doing a search.
             template <typename TransparentKey, typename... ValueArgs>
             insert_result try_emplace(TransparentKey&& key, ValueArgs&&... args)
             {
-                auto result = keys_.try_emplace(std::forward<TransparentKey>(key));
-                if (result.was_inserted())
-                {
-                    // key was inserted, insert value as well
-                    auto iter = value_iter(result.iter());
-                    values_.emplace(iter, std::forward<ValueArgs>(args)...);
-                    return insert_result(key_value_iter(result.iter()), false);
-                }
-                else
-                    // key was not inserted, don't insert value
-                    return insert_result(key_value_iter(result.iter()), true);
+                auto range = search_equal_range_for_insert(key);
+                return emplace_at(range, std::forward<TransparentKey>(key),
+                                  std::forward<ValueArgs>(args)...);
+            }
+
+            /// \effects Same as `try_emplace(FWD(key), FWD(args)...)`,
+            /// but the position of the key is searched starting at the hint.
+            /// \returns The result of the insert operation.
+            /// \notes This is faster than `try_emplace()` if the key is inserted close to the hint.
+            template <typename TransparentKey, typename... ValueArgs>
+            insert_result try_emplace_hint(const_iterator hint, TransparentKey&& key,
+                                           ValueArgs&&... args)
+            {
+                auto lower = search_bound_hint<false>(hint, key);
+                auto upper = search_bound_hint<true>(begin() + std::ptrdiff_t(lower), key);
+                return emplace_at({lower, upper}, std::forward<TransparentKey>(key),
+                                  std::forward<ValueArgs>(args)...);
             }
 
             /// \effects Does a lookup for the given key.
@@ -605,7 +1456,7 @@ namespace foonathan
                 {
                     // update the value
                     // the forwarded arguments are not actually used, so fine to forward them again
-                    assign_value(result.value_iter(), std::forward<Args>(args)...);
+                    assign_value(result.iter()->value, std::forward<Args>(args)...);
                 }
                 return result;
             }
@@ -689,32 +1540,102 @@ namespace foonathan
                     insert_pair(*cur);
             }
 
+            /// \effects Appends keys from the range `[key_begin, key_end)` combined with the matching values from `[value_begin, value_end)`
+            /// without searching for their position.
+            /// It stops as soon as one range is exhausted or at the first key that isn't sorted after the current maximum,
+            /// i.e. that is less or, if the map doesn't allow duplicates, equivalent.
+            /// \returns The number of key-value-pairs that were appended.
+            /// \notes This is meant for bulk loading already sorted keys,
+            /// the remaining keys of an unsorted range have to be inserted with `insert_range()`.
+            template <typename KeyInputIt, typename ValueInputIt>
+            size_type append_sorted_range(KeyInputIt key_begin, KeyInputIt key_end,
+                                          ValueInputIt value_begin, ValueInputIt value_end)
+            {
+                auto no_keys =
+                    range_size(typename std::iterator_traits<KeyInputIt>::iterator_category{},
+                               key_begin, key_end);
+                auto no_values =
+                    range_size(typename std::iterator_traits<ValueInputIt>::iterator_category{},
+                               value_begin, value_end);
+                reserve(size() + std::min(no_keys, no_values));
+
+                auto count = size_type(0);
+                for (; key_begin != key_end && value_begin != value_end;
+                     ++key_begin, ++value_begin, ++count)
+                    if (!try_append(*key_begin, *value_begin))
+                        break;
+                return count;
+            }
+
+            /// \effects Appends all elements in the range `[begin, end)` like `append_sorted_range()`,
+            /// using `get<0>(*cur)` as key and `get<1>(*cur)` as value.
+            /// \returns The number of key-value-pairs that were appended.
+            template <typename InputIt>
+            size_type append_sorted_pair_range(InputIt begin, InputIt end)
+            {
+                reserve(size()
+                        + range_size(typename std::iterator_traits<InputIt>::iterator_category{},
+                                     begin, end));
+
+                using std::get;
+                auto count = size_type(0);
+                for (auto cur = begin; cur != end; ++cur, ++count)
+                    if (!try_append(get<0>(*cur), get<1>(*cur)))
+                        break;
+                return count;
+            }
+
+            /// \effects Replaces the contents with the keys and the values at the same index.
+            /// \requires The views must have the same size, the keys must already be sorted,
+            /// and must not contain duplicates unless `AllowDuplicates` is `true`.
+            /// \notes With the [array::separate_arrays_layout]() the memory of the views is stolen if possible,
+            /// so no element is touched.
+            void assign_sorted(input_view<Key, BlockStorage>&&   keys,
+                               input_view<Value, BlockStorage>&& values)
+            {
+                storage_.assign_sorted(std::move(keys), std::move(values));
+
+                search_index().reserve(size());
+                search_index().clear();
+                for (auto i = size_type(0); i != size(); ++i)
+                {
+                    assert(i == 0u
+                           || Compare::compare(storage_.make_iterator(i)->key,
+                                               storage_.make_iterator(i - 1u)->key)
+                                  != key_ordering::less);
+                    search_index().insert(i, storage_.make_iterator(i)->key);
+                }
+            }
+
             /// \effects Destroys and removes all elements.
             void clear() noexcept
             {
-                keys_.clear();
-                values_.clear();
+                storage_.clear();
+                search_index().clear();
             }
 
             /// \effects Destroys and removes the element at the given position.
             /// \returns An iterator after the element that was removed.
-            iterator erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable<Key>::value)
+            iterator erase(const_iterator pos) noexcept(
+                std::is_nothrow_move_assignable<Key>::value
+                && std::is_nothrow_move_assignable<Value>::value)
             {
-                auto key_after = keys_.erase(key_iter(pos));
-                values_.erase(value_iter(pos));
-                return key_value_iter(key_after);
+                auto index = index_of(pos);
+                storage_.erase_range(index, index + 1u);
+                search_index().erase_range(index, index + 1u);
+                return begin() + std::ptrdiff_t(index);
             }
 
             /// \effects Destroys and removes all elements in the range `[begin, end)`.
             /// \returns An iterator after the last element that was removed.
             iterator erase_range(const_iterator begin, const_iterator end) noexcept(
-                std::is_nothrow_move_assignable<Key>::value)
+                std::is_nothrow_move_assignable<Key>::value
+                && std::is_nothrow_move_assignable<Value>::value)
             {
-                auto value_begin = value_iter(begin);
-                auto value_end   = value_iter(end);
-                auto key_after   = keys_.erase_range(key_iter(begin), key_iter(end));
-                values_.erase_range(value_begin, value_end);
-                return key_value_iter(key_after);
+                auto index = index_of(begin);
+                search_index().erase_range(index, index_of(end));
+                storage_.erase_range(index, index_of(end));
+                return this->begin() + std::ptrdiff_t(index);
             }
 
             /// \effects Destroys and removes all occurrences of `key`.
@@ -722,7 +1643,8 @@ namespace foonathan
             /// whether or not any were removed otherwise.
             template <typename TransparentKey>
             auto erase_all(const TransparentKey& key) noexcept(
-                std::is_nothrow_move_assignable<Key>::value) ->
+                std::is_nothrow_move_assignable<Key>::value
+                && std::is_nothrow_move_assignable<Value>::value) ->
                 typename std::conditional<AllowDuplicates, size_type, bool>::type
             {
                 auto range = equal_range(key);
@@ -736,6 +1658,69 @@ namespace foonathan
                 return count;
             }
 
+            /// \effects Destroys and removes all key-value-pairs where `pred(*iter)` returns `true`,
+            /// where `iter` is an `iterator` to the pair.
+            /// \returns The number of key-value-pairs that were removed.
+            /// \notes `pred` is called exactly once for each pair, in order,
+            /// and the remaining keys and values are compacted in a single pass.
+            /// If `pred` or a move throws, the pairs already erased are removed and the map stays sorted,
+            /// but the pair whose move threw is lost as well.
+            template <typename Predicate>
+            size_type erase_if(Predicate pred)
+            {
+                auto dest   = size_type(0);
+                auto cur    = size_type(0);
+                auto moving = false;
+                try
+                {
+                    for (; cur != size(); ++cur)
+                    {
+                        if (pred(*storage_.make_iterator(cur)))
+                            continue;
+
+                        if (dest != cur)
+                        {
+                            moving = true;
+                            storage_.move_element(dest, cur);
+                            moving = false;
+                        }
+                        ++dest;
+                    }
+                }
+                catch (...)
+                {
+                    // [dest, cur) only contains moved-from or erased pairs
+                    storage_.erase_range(dest, moving ? cur + 1u : cur);
+                    rebuild_search_index();
+                    throw;
+                }
+
+                auto count = size() - dest;
+                if (count != 0u)
+                {
+                    storage_.erase_range(dest, size());
+                    rebuild_search_index();
+                }
+                return count;
+            }
+
+            /// \effects Destroys and removes all key-value-pairs whose key is in the sorted view.
+            /// \returns The number of key-value-pairs that were removed.
+            /// \notes The map and the keys are merged in a single pass,
+            /// which is faster than calling `erase_all(key)` for each key.
+            template <typename T>
+            size_type erase_all(const sorted_view<T, Compare>& keys)
+            {
+                auto cur = keys.begin();
+                return erase_if([&](const typename iterator::value_type& pair) {
+                    while (cur != keys.end()
+                           && Compare::compare(*cur, pair.key) == key_ordering::less)
+                        ++cur;
+                    return cur != keys.end()
+                           && Compare::compare(*cur, pair.key) == key_ordering::equivalent;
+                });
+            }
+
             /// \effects Conceptually the same as `flat_map<Key, Value> m; m.insert_range(key_begin, key_end, value_begin, value_end); *this = std::move(m);`
             template <typename KeyInputIt, typename ValueInputIt>
             void assign_range(KeyInputIt key_begin, KeyInputIt key_end, ValueInputIt value_begin,
@@ -811,13 +1796,13 @@ namespace foonathan
             template <typename TransparentKey>
             iterator find(const TransparentKey& key) noexcept
             {
-                return key_value_iter(keys_.find(key));
+                return begin() + std::ptrdiff_t(search_find(key));
             }
             /// \group find
             template <typename TransparentKey>
             const_iterator find(const TransparentKey& key) const noexcept
             {
-                return key_value_iter(keys_.find(key));
+                return begin() + std::ptrdiff_t(search_find(key));
             }
 
             /// \returns The number of occurences of `key` in the map.
@@ -825,7 +1810,8 @@ namespace foonathan
             template <typename TransparentKey>
             size_type count(const TransparentKey& key) const noexcept
             {
-                return keys_.count(key);
+                auto range = search_equal_range(key);
+                return range.end() - range.begin();
             }
 
             /// \returns Same as [array::lower_bound]() for the given `key`.
@@ -833,13 +1819,13 @@ namespace foonathan
             template <typename TransparentKey>
             iterator lower_bound(const TransparentKey& key) noexcept
             {
-                return key_value_iter(keys_.lower_bound(key));
+                return begin() + std::ptrdiff_t(search_lower_bound(key));
             }
             /// \group lower_bound
             template <typename TransparentKey>
             const_iterator lower_bound(const TransparentKey& key) const noexcept
             {
-                return key_value_iter(keys_.lower_bound(key));
+                return begin() + std::ptrdiff_t(search_lower_bound(key));
             }
 
             /// \returns Same as [array::upper_bound]() for the given `key`.
@@ -847,13 +1833,43 @@ namespace foonathan
             template <typename TransparentKey>
             iterator upper_bound(const TransparentKey& key) noexcept
             {
-                return key_value_iter(keys_.upper_bound(key));
+                return begin() + std::ptrdiff_t(search_upper_bound(key));
             }
             /// \group upper_bound
             template <typename TransparentKey>
             const_iterator upper_bound(const TransparentKey& key) const noexcept
             {
-                return key_value_iter(keys_.upper_bound(key));
+                return begin() + std::ptrdiff_t(search_upper_bound(key));
+            }
+
+            /// \returns Same as [array::lower_bound_hint]() for the given `hint` and `key`,
+            /// i.e. the search starts at the hint instead of using the `SearchPolicy`.
+            /// \group lower_bound_hint
+            template <typename TransparentKey>
+            iterator lower_bound(const_iterator hint, const TransparentKey& key) noexcept
+            {
+                return begin() + std::ptrdiff_t(search_bound_hint<false>(hint, key));
+            }
+            /// \group lower_bound_hint
+            template <typename TransparentKey>
+            const_iterator lower_bound(const_iterator hint, const TransparentKey& key) const noexcept
+            {
+                return begin() + std::ptrdiff_t(search_bound_hint<false>(hint, key));
+            }
+
+            /// \returns Same as [array::upper_bound_hint]() for the given `hint` and `key`,
+            /// i.e. the search starts at the hint instead of using the `SearchPolicy`.
+            /// \group upper_bound_hint
+            template <typename TransparentKey>
+            iterator upper_bound(const_iterator hint, const TransparentKey& key) noexcept
+            {
+                return begin() + std::ptrdiff_t(search_bound_hint<true>(hint, key));
+            }
+            /// \group upper_bound_hint
+            template <typename TransparentKey>
+            const_iterator upper_bound(const_iterator hint, const TransparentKey& key) const noexcept
+            {
+                return begin() + std::ptrdiff_t(search_bound_hint<true>(hint, key));
             }
 
             /// \returns Same as [array::equal_range]() for the given `key`.
@@ -861,48 +1877,224 @@ namespace foonathan
             template <typename TransparentKey>
             iter_pair<iterator> equal_range(const TransparentKey& key) noexcept
             {
-                auto range = keys_.equal_range(key);
-                return {key_value_iter(range.begin()), key_value_iter(range.end())};
+                auto range = search_equal_range(key);
+                return {begin() + std::ptrdiff_t(range.begin()),
+                        begin() + std::ptrdiff_t(range.end())};
             }
             /// \group equal_range
             template <typename TransparentKey>
             iter_pair<const_iterator> equal_range(const TransparentKey& key) const noexcept
             {
-                auto range = keys_.equal_range(key);
-                return {key_value_iter(range.begin()), key_value_iter(range.end())};
+                auto range = search_equal_range(key);
+                return {begin() + std::ptrdiff_t(range.begin()),
+                        begin() + std::ptrdiff_t(range.end())};
+            }
+
+            //=== positional access ===//
+            /// \returns The key value pair at the given position, i.e. the pair with `i` keys before it.
+            /// \requires `i < size()`.
+            /// \group nth
+            key_value_ref<Key, Value> nth(size_type i) noexcept
+            {
+                assert(i < size());
+                return begin()[std::ptrdiff_t(i)];
+            }
+            /// \group nth
+            key_value_ref<Key, const Value> nth(size_type i) const noexcept
+            {
+                assert(i < size());
+                return begin()[std::ptrdiff_t(i)];
+            }
+
+            /// \returns The number of keys that are less than the given key,
+            /// i.e. the position of `lower_bound(key)`.
+            template <typename TransparentKey>
+            size_type rank(const TransparentKey& key) const noexcept
+            {
+                return search_lower_bound(key);
+            }
+
+            /// \returns The number of keys in the half-open range `[lower, upper)`.
+            template <typename TransparentKeyA, typename TransparentKeyB>
+            size_type count_range(const TransparentKeyA& lower, const TransparentKeyB& upper) const
+                noexcept
+            {
+                auto first = search_lower_bound(lower);
+                return std::max(first, search_lower_bound(upper)) - first;
+            }
+
+            /// \returns A sorted view to the keys in the half-open range `[lower, upper)`.
+            /// If `upper` is less than `lower`, the view is empty.
+            /// \notes Like `keys()`, this is not available for the [array::array_of_structs_layout]().
+            template <typename TransparentKeyA, typename TransparentKeyB>
+            sorted_view<const Key, Compare> range(const TransparentKeyA& lower,
+                                                  const TransparentKeyB& upper) const noexcept
+            {
+                auto first = search_lower_bound(lower);
+                auto last  = std::max(first, search_lower_bound(upper));
+                return sorted_view<const Key, Compare>(storage_.keys() + first, last - first);
             }
 
         private:
+            search_index_type& search_index() noexcept
+            {
+                return *this;
+            }
+            const search_index_type& search_index() const noexcept
+            {
+                return *this;
+            }
+
+            void rebuild_search_index()
+            {
+                // the index is rebuilt in place, it already has enough capacity
+                search_index().clear();
+                for (auto i = size_type(0); i != size(); ++i)
+                    search_index().insert(i, storage_.make_iterator(i)->key);
+            }
+
             size_type index_of(key_const_iterator iter) const noexcept
             {
-                assert(iter >= keys_.begin() && iter <= keys_.end());
-                return size_type(iter - keys_.begin());
+                assert(iter >= key_begin() && iter <= key_end());
+                return size_type(iter - key_begin());
             }
 
             size_type index_of(value_const_iterator iter) const noexcept
             {
-                assert(iter >= values_.begin() && iter <= values_.end());
-                return size_type(iter - values_.begin());
+                assert(iter >= value_begin() && iter <= value_end());
+                return size_type(iter - value_begin());
             }
 
             size_type index_of(const_iterator iter) const noexcept
             {
-                auto key = iter.get_key_pointer(typename const_iterator::private_key{});
-                assert(key >= iterator_to_pointer(keys_.begin())
-                       && key <= iterator_to_pointer(keys_.end()));
-                return size_type(key - iterator_to_pointer(keys_.begin()));
+                return storage_.index_of(iter);
+            }
+
+            // the search functions return the index into the map
+            template <typename TransparentKey>
+            size_type search_find(const TransparentKey& key) const noexcept
+            {
+                auto lower = search_lower_bound(key);
+                if (lower == size())
+                    return size();
+                else if (search_compare::compare(storage_.search_data()[lower], key)
+                         == key_ordering::equivalent)
+                    return lower;
+                else
+                    return size();
+            }
+
+            template <typename TransparentKey>
+            size_type search_lower_bound(const TransparentKey& key) const noexcept
+            {
+                auto data = storage_.search_data();
+                auto iter =
+                    search_index().template lower_bound<search_compare>(data, data + size(), key);
+                return size_type(iter - data);
+            }
+
+            template <typename TransparentKey>
+            size_type search_upper_bound(const TransparentKey& key) const noexcept
+            {
+                auto data = storage_.search_data();
+                auto iter =
+                    search_index().template upper_bound<search_compare>(data, data + size(), key);
+                return size_type(iter - data);
+            }
+
+            template <bool Upper, typename TransparentKey>
+            size_type search_bound_hint(const_iterator hint, const TransparentKey& key) const
+                noexcept
+            {
+                auto data  = storage_.search_data();
+                auto start = data + index_of(hint);
+                auto iter  = Upper ? upper_bound_hint<search_compare>(data, data + size(), start, key)
+                                  : lower_bound_hint<search_compare>(data, data + size(), start, key);
+                return size_type(iter - data);
+            }
+
+            template <typename TransparentKey>
+            iter_pair<size_type> search_equal_range(const TransparentKey& key) const noexcept
+            {
+                auto data  = storage_.search_data();
+                auto range =
+                    search_index().template equal_range<search_compare>(data, data + size(), key);
+                return {size_type(range.begin() - data), size_type(range.end() - data)};
+            }
+
+            // same as search_equal_range(), but checks the maximum first,
+            // so keys inserted in increasing order don't need a search
+            // (if the maximum is equivalent, the range only contains the last duplicate,
+            // which is enough to insert the key)
+            template <typename TransparentKey>
+            iter_pair<size_type> search_equal_range_for_insert(const TransparentKey& key) const
+                noexcept
+            {
+                if (empty())
+                    return {0u, 0u};
+
+                auto ordering =
+                    search_compare::compare(storage_.search_data()[size() - 1u], key);
+                if (ordering == key_ordering::less)
+                    return {size(), size()};
+                else if (ordering == key_ordering::equivalent)
+                    return {size() - 1u, size()};
+                else
+                    return search_equal_range(key);
+            }
+
+            template <typename TransparentKey, typename... ValueArgs>
+            insert_result emplace_at(iter_pair<size_type> range, TransparentKey&& key,
+                                     ValueArgs&&... args)
+            {
+                if (AllowDuplicates || range.empty())
+                {
+                    // we either don't care about duplicates or the key is not in the map
+                    auto index = range.end();
+                    search_index().reserve(size() + 1u);
+                    storage_.emplace(index, std::forward<TransparentKey>(key),
+                                     std::forward<ValueArgs>(args)...);
+                    search_index().insert(index, storage_.make_iterator(index)->key);
+                    return insert_result(begin() + std::ptrdiff_t(index), false);
+                }
+                else
+                {
+                    // we don't allow duplicates and the key is already in the map
+                    assert(range.begin() + 1u == range.end());
+                    return insert_result(begin() + std::ptrdiff_t(range.begin()), true);
+                }
+            }
+
+            // appends the key-value-pair if the key is sorted after the maximum
+            template <typename K, typename V>
+            bool try_append(K&& key, V&& value)
+            {
+                if (!empty())
+                {
+                    auto ordering =
+                        search_compare::compare(storage_.search_data()[size() - 1u], key);
+                    if (ordering == key_ordering::greater
+                        || (!AllowDuplicates && ordering == key_ordering::equivalent))
+                        return false;
+                }
+
+                auto index = size();
+                search_index().reserve(index + 1u);
+                storage_.emplace(index, std::forward<K>(key), std::forward<V>(value));
+                search_index().insert(index, storage_.make_iterator(index)->key);
+                return true;
             }
 
             template <typename Arg>
-            auto assign_value(value_iterator iter, Arg&& arg) noexcept
-                -> decltype(*iter = std::forward<Arg>(arg))
+            auto assign_value(Value& value, Arg&& arg) noexcept
+                -> decltype(value = std::forward<Arg>(arg))
             {
-                return *iter = std::forward<Arg>(arg);
+                return value = std::forward<Arg>(arg);
             }
             template <typename... Args>
-            void assign_value(value_iterator iter, Args&&... args) const
+            void assign_value(Value& value, Args&&... args) const
             {
-                *iter = Value(std::forward<Args>(args)...);
+                value = Value(std::forward<Args>(args)...);
             }
 
             template <typename InputIt>
@@ -917,14 +2109,15 @@ namespace foonathan
                 return size_type(std::distance(begin, end));
             }
 
-            key_storage   keys_;
-            value_storage values_;
+            storage storage_;
         };
 
         /// Convenience typedef for an [array::flat_map]() that allows duplicates.
         template <typename Key, typename Value, typename Compare = key_compare_default,
-                  class BlockStorage = block_storage_default>
-        using flat_multimap = flat_map<Key, Value, Compare, BlockStorage, true>;
+                  class BlockStorage = block_storage_default, class Layout = separate_arrays_layout,
+                  class SearchPolicy = search_default>
+        using flat_multimap =
+            flat_map<Key, Value, Compare, BlockStorage, true, Layout, SearchPolicy>;
     } // namespace array
 } // namespace foonathan
 
@@ -85,13 +85,17 @@ namespace foonathan
         /// but uses a sorted [array::array]() with the given `BlockStorage` internally.
         ///
         /// `Compare` must be a `KeyCompare` type, not something like [std::less]().
+        /// The `SearchPolicy` controls how the sorted keys are searched, e.g. [array::binary_search]().
         ///
         /// \notes When you have a `flat_set<key_value_pair<Key, Value>>`,
         /// you have something similar to [array::flat_map]() but where the keys and values are stored together.
         template <typename Key, typename Compare = key_compare_default,
-                  class BlockStorage = block_storage_default, bool AllowDuplicates = false>
-        class flat_set
+                  class BlockStorage = block_storage_default, bool AllowDuplicates = false,
+                  class SearchPolicy = search_default>
+        class flat_set : detail::search_index<SearchPolicy, Key, BlockStorage>
         {
+            using search_index_type = detail::search_index<SearchPolicy, Key, BlockStorage>;
+
             class iterator_tag
             {
                 constexpr iterator_tag() = default;
@@ -111,6 +115,7 @@ namespace foonathan
             using is_multiset = std::integral_constant<bool, AllowDuplicates>;
 
             using block_storage = BlockStorage;
+            using search_policy = SearchPolicy;
 
             using iterator       = pointer_iterator<iterator_tag, const Key>;
             using const_iterator = iterator;
@@ -124,7 +129,7 @@ namespace foonathan
             /// \effects Creates a set without any elements.
             /// The block storage is initialized with the given arguments.
             explicit flat_set(typename block_storage::arg_type args) noexcept
-            : array_(std::move(args))
+            : search_index_type(args), array_(std::move(args))
             {
             }
 
@@ -132,7 +137,7 @@ namespace foonathan
             /// The block storage is initialized with the given arguments.
             explicit flat_set(input_view<Key, BlockStorage>&&  input,
                               typename block_storage::arg_type args = {})
-            : array_(std::move(args))
+            : search_index_type(args), array_(std::move(args))
             {
                 assign(std::move(input));
             }
@@ -149,6 +154,7 @@ namespace foonathan
                 block_storage_nothrow_move<BlockStorage, Key>{})
             {
                 swap(lhs.array_, rhs.array_);
+                swap(lhs.search_index(), rhs.search_index());
             }
 
             //=== access ===//
@@ -161,6 +167,7 @@ namespace foonathan
             /// \returns An input view to the elements.
             operator input_view<Key, BlockStorage>() && noexcept
             {
+                search_index().clear();
                 return std::move(array_).operator input_view<Key, BlockStorage>();
             }
 
@@ -223,12 +230,14 @@ namespace foonathan
             void reserve(size_type new_capacity)
             {
                 array_.reserve(new_capacity);
+                search_index().reserve(new_capacity);
             }
 
             /// \effects Non-binding request to make the capacity as small as necessary.
             void shrink_to_fit()
             {
                 array_.shrink_to_fit();
+                search_index().shrink_to_fit();
             }
 
             //=== modifiers ===//
@@ -270,24 +279,28 @@ namespace foonathan
             /// Otherwise, does nothing.
             /// \returns The result of the insert operation.
             /// \notes The additional arguments are intended for [array::key_value_pair]() as key type.
+            /// \notes If the key is sorted after all keys in the set,
+            /// it is appended without doing a search.
             template <typename TransparentKey, typename... Args>
             insert_result try_emplace(TransparentKey&& key, Args&&... args)
             {
-                auto range = equal_range(key);
-                if (AllowDuplicates || range.empty())
-                {
-                    // we either don't care about duplicates or the key is not in the map
-                    auto iter = array_.emplace(convert_iterator(range.end()),
-                                               std::forward<TransparentKey>(key),
-                                               std::forward<Args>(args)...);
-                    return {convert_iterator(iter), !range.empty()};
-                }
-                else
-                {
-                    // we don't allow duplicates and the key is already in the map
-                    assert(std::next(range.begin()) == range.end());
-                    return {range.begin(), true};
-                }
+                auto range = equal_range_for_insert(key);
+                return emplace_at(range, std::forward<TransparentKey>(key),
+                                  std::forward<Args>(args)...);
+            }
+
+            /// \effects Same as `try_emplace(FWD(key), FWD(args)...)`,
+            /// but the position of the key is searched starting at the hint.
+            /// \returns The result of the insert operation.
+            /// \notes This is faster than `try_emplace()` if the key is inserted close to the hint.
+            template <typename TransparentKey, typename... Args>
+            insert_result try_emplace_hint(const_iterator hint, TransparentKey&& key,
+                                           Args&&... args)
+            {
+                auto lower = lower_bound(hint, key);
+                auto upper = upper_bound(lower, key);
+                return emplace_at({lower, upper}, std::forward<TransparentKey>(key),
+                                  std::forward<Args>(args)...);
             }
 
             /// \effects Same as `try_emplace(FWD(k))`.
@@ -315,16 +328,49 @@ namespace foonathan
                                   begin, end);
             }
 
+            /// \effects Appends the keys in the range `[begin, end)` without searching for their position.
+            /// It stops at the first key that isn't sorted after the current maximum,
+            /// i.e. that is less or, if the set doesn't allow duplicates, equivalent.
+            /// \returns The number of keys that were appended.
+            /// \notes This is meant for bulk loading already sorted keys,
+            /// the remaining keys of an unsorted range have to be inserted with `insert_range()`.
+            template <typename InputIt>
+            size_type append_sorted_range(InputIt begin, InputIt end)
+            {
+                reserve(size()
+                        + range_size(typename std::iterator_traits<InputIt>::iterator_category{},
+                                     begin, end));
+
+                auto count = size_type(0);
+                for (auto cur = begin; cur != end; ++cur, ++count)
+                {
+                    if (!empty())
+                    {
+                        auto ordering = Compare::compare(max(), *cur);
+                        if (ordering == key_ordering::greater
+                            || (!AllowDuplicates && ordering == key_ordering::equivalent))
+                            break;
+                    }
+
+                    array_.push_back(*cur);
+                    search_index().insert(size() - 1u, max());
+                }
+                return count;
+            }
+
             /// \effects Destroys and removes all elements.
             void clear() noexcept
             {
                 array_.clear();
+                search_index().clear();
             }
 
             /// \effects Destroys and removes the element at the given position.
             /// \returns An iterator after the element that was removed.
             iterator erase(iterator pos) noexcept(std::is_nothrow_move_assignable<Key>::value)
             {
+                auto index = size_type(pos - begin());
+                search_index().erase_range(index, index + 1u);
                 return convert_iterator(array_.erase(convert_iterator(pos)));
             }
 
@@ -333,6 +379,8 @@ namespace foonathan
             iterator erase_range(iterator begin,
                                  iterator end) noexcept(std::is_nothrow_move_assignable<Key>::value)
             {
+                search_index().erase_range(size_type(begin - this->begin()),
+                                           size_type(end - this->begin()));
                 return convert_iterator(
                     array_.erase_range(convert_iterator(begin), convert_iterator(end)));
             }
@@ -356,6 +404,47 @@ namespace foonathan
                 return count;
             }
 
+            /// \effects Destroys and removes all keys where `pred(key)` returns `true`.
+            /// \returns The number of keys that were removed.
+            /// \notes `pred` is called exactly once for each key, in order,
+            /// and the remaining keys are compacted in a single pass.
+            /// If `pred` or a move throws, the keys already erased are removed and the set stays sorted,
+            /// but the key whose move threw is lost as well.
+            template <typename Predicate>
+            size_type erase_if(Predicate pred)
+            {
+                size_type count;
+                try
+                {
+                    count = array_.erase_if([&](const Key& key) { return pred(key); });
+                }
+                catch (...)
+                {
+                    search_index().assign(array_.begin(), array_.end());
+                    throw;
+                }
+
+                if (count != 0u)
+                    search_index().assign(array_.begin(), array_.end());
+                return count;
+            }
+
+            /// \effects Destroys and removes all occurrences of the keys in the sorted view.
+            /// \returns The number of keys that were removed.
+            /// \notes The set and the keys are merged in a single pass,
+            /// which is faster than calling `erase_all(key)` for each key.
+            template <typename T>
+            size_type erase_all(const sorted_view<T, Compare>& keys)
+            {
+                auto cur = keys.begin();
+                return erase_if([&](const Key& key) {
+                    while (cur != keys.end() && Compare::compare(*cur, key) == key_ordering::less)
+                        ++cur;
+                    return cur != keys.end()
+                           && Compare::compare(*cur, key) == key_ordering::equivalent;
+                });
+            }
+
             /// \effects Conceptually the same as `*this = flat_set<Key>(input)`.
             void assign(input_view<Key, BlockStorage>&& input)
             {
@@ -379,11 +468,13 @@ namespace foonathan
                                                    });
                         array_.erase_range(new_end, array_.end());
                     }
+
+                    search_index().assign(array_.begin(), array_.end());
                 }
                 else
                 {
-                    array_.clear();
-                    array_.reserve(input.size());
+                    clear();
+                    reserve(input.size());
 
                     // insert all elements individually
                     for (auto& element : input.view())
@@ -409,6 +500,22 @@ namespace foonathan
                 std::sort(array_.begin(), array_.end(), [&](const Key& lhs, const Key& rhs) {
                     return Compare::compare(lhs, rhs) == key_ordering::less;
                 });
+                search_index().assign(array_.begin(), array_.end());
+            }
+
+            /// \effects Same as `assign(std::move(input))`, but takes the elements as they are.
+            /// \requires The elements of the view must already be sorted,
+            /// and must not contain duplicates unless `AllowDuplicates` is `true`.
+            /// \notes If the view steals memory, no element is touched,
+            /// which makes it the fastest way to create a set from data that is known to be sorted.
+            void assign_sorted(input_view<Key, BlockStorage>&& input)
+            {
+                array_.assign(std::move(input));
+                assert(std::is_sorted(array_.begin(), array_.end(),
+                                      [&](const Key& lhs, const Key& rhs) {
+                                          return Compare::compare(lhs, rhs) == key_ordering::less;
+                                      }));
+                search_index().assign(array_.begin(), array_.end());
             }
 
             //=== lookup ===//
@@ -467,24 +574,86 @@ namespace foonathan
             template <typename TransparentKey>
             const_iterator lower_bound(const TransparentKey& key) const noexcept
             {
-                return foonathan::array::lower_bound<Compare>(begin(), end(), key);
+                return search_index().template lower_bound<Compare>(begin(), end(), key);
             }
 
             /// \returns Same as [array::upper_bound]() for the given `key`.
             template <typename TransparentKey>
             const_iterator upper_bound(const TransparentKey& key) const noexcept
             {
-                return foonathan::array::upper_bound<Compare>(begin(), end(), key);
+                return search_index().template upper_bound<Compare>(begin(), end(), key);
             }
 
             /// \returns Same as [array::equal_range]() for the given `key`.
             template <typename TransparentKey>
             iter_pair<const_iterator> equal_range(const TransparentKey& key) const noexcept
             {
-                return foonathan::array::equal_range<Compare>(begin(), end(), key);
+                return search_index().template equal_range<Compare>(begin(), end(), key);
+            }
+
+            /// \returns Same as [array::lower_bound_hint]() for the given `hint` and `key`,
+            /// i.e. the search starts at the hint instead of using the `SearchPolicy`.
+            template <typename TransparentKey>
+            const_iterator lower_bound(const_iterator hint, const TransparentKey& key) const noexcept
+            {
+                return lower_bound_hint<Compare>(begin(), end(), hint, key);
+            }
+
+            /// \returns Same as [array::upper_bound_hint]() for the given `hint` and `key`,
+            /// i.e. the search starts at the hint instead of using the `SearchPolicy`.
+            template <typename TransparentKey>
+            const_iterator upper_bound(const_iterator hint, const TransparentKey& key) const noexcept
+            {
+                return upper_bound_hint<Compare>(begin(), end(), hint, key);
+            }
+
+            //=== positional access ===//
+            /// \returns The key at the given position, i.e. the key with `i` keys before it.
+            /// \requires `i < size()`.
+            const Key& nth(size_type i) const noexcept
+            {
+                assert(i < size());
+                return array_[i];
+            }
+
+            /// \returns The number of keys that are less than the given key,
+            /// i.e. the position of `lower_bound(key)`.
+            template <typename TransparentKey>
+            size_type rank(const TransparentKey& key) const noexcept
+            {
+                return size_type(lower_bound(key) - begin());
+            }
+
+            /// \returns The number of keys in the half-open range `[lower, upper)`.
+            template <typename TransparentKeyA, typename TransparentKeyB>
+            size_type count_range(const TransparentKeyA& lower, const TransparentKeyB& upper) const
+                noexcept
+            {
+                return range(lower, upper).size();
+            }
+
+            /// \returns A sorted view to the keys in the half-open range `[lower, upper)`.
+            /// If `upper` is less than `lower`, the view is empty.
+            template <typename TransparentKeyA, typename TransparentKeyB>
+            sorted_view<const Key, Compare> range(const TransparentKeyA& lower,
+                                                  const TransparentKeyB& upper) const noexcept
+            {
+                auto first = lower_bound(lower);
+                auto last  = std::max(first, lower_bound(upper));
+                return sorted_view<const Key, Compare>(iterator_to_pointer(first),
+                                                       size_type(last - first));
             }
 
         private:
+            search_index_type& search_index() noexcept
+            {
+                return *this;
+            }
+            const search_index_type& search_index() const noexcept
+            {
+                return *this;
+            }
+
             static iterator convert_iterator(
                 typename array<Key, BlockStorage>::const_iterator iter) noexcept
             {
@@ -499,6 +668,60 @@ namespace foonathan
                 return pointer_to_iterator<typename array<Key, BlockStorage>::const_iterator>(ptr);
             }
 
+            // same as equal_range(), but checks the maximum first,
+            // so keys inserted in increasing order don't need a search
+            // (if the maximum is equivalent, the range only contains the last duplicate,
+            // which is enough to insert the key)
+            template <typename TransparentKey>
+            iter_pair<const_iterator> equal_range_for_insert(const TransparentKey& key) const
+                noexcept
+            {
+                if (empty())
+                    return {end(), end()};
+
+                auto ordering = Compare::compare(max(), key);
+                if (ordering == key_ordering::less)
+                    return {end(), end()};
+                else if (ordering == key_ordering::equivalent)
+                    return {std::prev(end()), end()};
+                else
+                    return equal_range(key);
+            }
+
+            template <typename TransparentKey, typename... Args>
+            insert_result emplace_at(iter_pair<const_iterator> range, TransparentKey&& key,
+                                     Args&&... args)
+            {
+                if (AllowDuplicates || range.empty())
+                {
+                    // we either don't care about duplicates or the key is not in the map
+                    search_index().reserve(size() + 1u);
+                    auto iter = array_.emplace(convert_iterator(range.end()),
+                                               std::forward<TransparentKey>(key),
+                                               std::forward<Args>(args)...);
+                    search_index().insert(size_type(iter - array_.begin()), *iter);
+                    return {convert_iterator(iter), !range.empty()};
+                }
+                else
+                {
+                    // we don't allow duplicates and the key is already in the map
+                    assert(std::next(range.begin()) == range.end());
+                    return {range.begin(), true};
+                }
+            }
+
+            template <typename InputIt>
+            static size_type range_size(std::input_iterator_tag, InputIt, InputIt)
+            {
+                return size_type(0u);
+            }
+
+            template <typename ForwardIt>
+            static size_type range_size(std::forward_iterator_tag, ForwardIt begin, ForwardIt end)
+            {
+                return size_type(std::distance(begin, end));
+            }
+
             template <typename InputIt>
             void insert_range_impl(std::input_iterator_tag, InputIt begin, InputIt end)
             {
@@ -509,7 +732,7 @@ namespace foonathan
             void insert_range_impl(std::forward_iterator_tag, ForwardIt begin, ForwardIt end)
             {
                 auto size = std::distance(begin, end);
-                array_.reserve(array_.size() + size_type(size));
+                reserve(array_.size() + size_type(size));
 
                 insert_range_impl(std::input_iterator_tag{}, begin, end);
             }
@@ -519,8 +742,8 @@ namespace foonathan
 
         /// Convenience typedef for an [array::flat_set]() that allows duplicates.
         template <typename Key, typename Compare = key_compare_default,
-                  class BlockStorage = block_storage_default>
-        using flat_multiset = flat_set<Key, Compare, BlockStorage, true>;
+                  class BlockStorage = block_storage_default, class SearchPolicy = search_default>
+        using flat_multiset = flat_set<Key, Compare, BlockStorage, true, SearchPolicy>;
     } // namespace array
 } // namespace foonathan
 
@@ -0,0 +1,820 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_FLAT_STRING_SET_HPP_INCLUDED
+#define FOONATHAN_ARRAY_FLAT_STRING_SET_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+
+#include <foonathan/array/array.hpp>
+#include <foonathan/array/key_compare.hpp>
+#include <foonathan/array/prefix_search.hpp>
+
+namespace foonathan
+{
+    namespace array
+    {
+        /// A lightweight reference to a string.
+        ///
+        /// It views `size()` characters starting at `data()`, they are not necessarily null-terminated.
+        /// It is the key type of [array::flat_string_set]()
+        /// and can be created from anything that has `data()` and `size()` like [std::string]().
+        class string_key
+        {
+        public:
+            /// \effects Creates a view to the empty string.
+            constexpr string_key() noexcept : data_(""), size_(0u) {}
+
+            /// \effects Creates a view to the `size` characters starting at `data`.
+            constexpr string_key(const char* data, size_type size) noexcept
+            : data_(data), size_(size)
+            {
+            }
+
+            /// \effects Creates a view to the null-terminated string.
+            string_key(const char* str) noexcept : data_(str), size_(std::strlen(str)) {}
+
+            /// \effects Creates a view to the characters of the given string.
+            /// \notes This constructor only participates in overload resolution,
+            /// if `str.data()` returns a `const char*` and `str.size()` is valid.
+            /// \param 1
+            /// \exclude
+            template <typename String,
+                      typename = typename std::enable_if<
+                          std::is_convertible<decltype(std::declval<const String&>().data()),
+                                              const char*>::value
+                          && std::is_convertible<decltype(std::declval<const String&>().size()),
+                                                 size_type>::value>::type>
+            string_key(const String& str) noexcept : data_(str.data()), size_(str.size())
+            {
+            }
+
+            /// \returns A copy of the characters.
+            explicit operator std::string() const
+            {
+                return std::string(data_, size_);
+            }
+
+            //=== access ===//
+            const char* data() const noexcept
+            {
+                return data_;
+            }
+
+            size_type size() const noexcept
+            {
+                return size_;
+            }
+
+            bool empty() const noexcept
+            {
+                return size_ == 0u;
+            }
+
+            const char* begin() const noexcept
+            {
+                return data_;
+            }
+
+            const char* end() const noexcept
+            {
+                return data_ + size_;
+            }
+
+            char operator[](size_type i) const noexcept
+            {
+                assert(i < size_);
+                return data_[i];
+            }
+
+            //=== comparison ===//
+            /// \returns A value less than, equal to or greater than zero,
+            /// if the string is lexicographically less than, equal to or greater than `other`.
+            /// \notes The characters are compared as `unsigned char` like [std::string::compare]().
+            int compare(const string_key& other) const noexcept
+            {
+                auto length = size_ < other.size_ ? size_ : other.size_;
+                auto result = length == 0u ? 0 : std::memcmp(data_, other.data_, length);
+                if (result != 0)
+                    return result;
+                else if (size_ == other.size_)
+                    return 0;
+                else
+                    return size_ < other.size_ ? -1 : 1;
+            }
+
+            friend bool operator==(const string_key& lhs, const string_key& rhs) noexcept
+            {
+                return lhs.size_ == rhs.size_ && lhs.compare(rhs) == 0;
+            }
+            friend bool operator!=(const string_key& lhs, const string_key& rhs) noexcept
+            {
+                return !(lhs == rhs);
+            }
+
+            friend bool operator<(const string_key& lhs, const string_key& rhs) noexcept
+            {
+                return lhs.compare(rhs) < 0;
+            }
+            friend bool operator>(const string_key& lhs, const string_key& rhs) noexcept
+            {
+                return rhs < lhs;
+            }
+            friend bool operator<=(const string_key& lhs, const string_key& rhs) noexcept
+            {
+                return !(rhs < lhs);
+            }
+            friend bool operator>=(const string_key& lhs, const string_key& rhs) noexcept
+            {
+                return !(lhs < rhs);
+            }
+
+        private:
+            const char* data_;
+            size_type   size_;
+        };
+
+        /// The prefix of a [array::string_key]() are the first eight bytes it refers to,
+        /// the same as for a [std::string]().
+        ///
+        /// This allows using [array::prefix_search]() with [array::flat_string_set]().
+        template <>
+        struct key_prefix_default::customize_for<string_key>
+        {
+            static std::uint64_t prefix(const string_key& str) noexcept
+            {
+                return customize_for<std::string>::prefix(str.data(), str.size());
+            }
+        };
+
+        namespace detail
+        {
+            // a string in the arena
+            struct string_arena_entry
+            {
+                size_type offset;
+                size_type size;
+            };
+
+            class string_arena_iterator
+            {
+            public:
+                struct private_key
+                {
+                    explicit private_key() {}
+                };
+
+                using iterator_category = std::random_access_iterator_tag;
+                using value_type        = string_key;
+                using difference_type   = std::ptrdiff_t;
+
+                struct pointer
+                {
+                    value_type key;
+
+                    const value_type* operator->() const noexcept
+                    {
+                        return &key;
+                    }
+                };
+
+                using reference = value_type; // can't use a real reference
+
+                string_arena_iterator() noexcept : entry_(nullptr), arena_(nullptr) {}
+
+                explicit string_arena_iterator(private_key, const string_arena_entry* entry,
+                                               const char* arena) noexcept
+                : entry_(entry), arena_(arena)
+                {
+                }
+
+                //=== access ===//
+                reference operator*() const noexcept
+                {
+                    return string_key(arena_ + entry_->offset, entry_->size);
+                }
+
+                pointer operator->() const noexcept
+                {
+                    return pointer{**this};
+                }
+
+                reference operator[](difference_type offset) const noexcept
+                {
+                    return *(*this + offset);
+                }
+
+                const string_arena_entry* get_entry_pointer(private_key) const noexcept
+                {
+                    return entry_;
+                }
+
+                //=== increment/decrement ===//
+                string_arena_iterator& operator++() noexcept
+                {
+                    return *this += 1;
+                }
+                string_arena_iterator operator++(int) noexcept
+                {
+                    auto save = *this;
+                    ++*this;
+                    return save;
+                }
+
+                string_arena_iterator& operator--() noexcept
+                {
+                    return *this += -1;
+                }
+                string_arena_iterator operator--(int) noexcept
+                {
+                    auto save = *this;
+                    --*this;
+                    return save;
+                }
+
+                string_arena_iterator& operator+=(difference_type offset) noexcept
+                {
+                    entry_ += offset;
+                    return *this;
+                }
+                string_arena_iterator& operator-=(difference_type offset) noexcept
+                {
+                    return *this += -offset;
+                }
+
+                //=== addition/subtraction ===//
+                friend string_arena_iterator operator+(string_arena_iterator iter,
+                                                       difference_type       offset) noexcept
+                {
+                    return iter += offset;
+                }
+                friend string_arena_iterator operator+(difference_type       offset,
+                                                       string_arena_iterator iter) noexcept
+                {
+                    return iter += offset;
+                }
+
+                friend string_arena_iterator operator-(string_arena_iterator iter,
+                                                       difference_type       offset) noexcept
+                {
+                    return iter -= offset;
+                }
+
+                friend difference_type operator-(string_arena_iterator lhs,
+                                                 string_arena_iterator rhs) noexcept
+                {
+                    return lhs.entry_ - rhs.entry_;
+                }
+
+                //=== comparison ===//
+                friend bool operator==(string_arena_iterator lhs,
+                                       string_arena_iterator rhs) noexcept
+                {
+                    return lhs.entry_ == rhs.entry_;
+                }
+                friend bool operator!=(string_arena_iterator lhs,
+                                       string_arena_iterator rhs) noexcept
+                {
+                    return lhs.entry_ != rhs.entry_;
+                }
+
+                friend bool operator<(string_arena_iterator lhs, string_arena_iterator rhs) noexcept
+                {
+                    return lhs.entry_ < rhs.entry_;
+                }
+                friend bool operator>(string_arena_iterator lhs, string_arena_iterator rhs) noexcept
+                {
+                    return lhs.entry_ > rhs.entry_;
+                }
+                friend bool operator<=(string_arena_iterator lhs,
+                                       string_arena_iterator rhs) noexcept
+                {
+                    return lhs.entry_ <= rhs.entry_;
+                }
+                friend bool operator>=(string_arena_iterator lhs,
+                                       string_arena_iterator rhs) noexcept
+                {
+                    return lhs.entry_ >= rhs.entry_;
+                }
+
+            private:
+                const string_arena_entry* entry_;
+                const char*               arena_;
+            };
+        } // namespace detail
+
+        /// A sorted set of strings.
+        ///
+        /// It is similar to [array::flat_set]() of [std::string](),
+        /// but the characters of all strings are stored in one [array::array]() of `char`, the arena.
+        /// The set itself is an array of offset and size into the arena sorted by the strings.
+        /// So there is no allocation per string and inserting only moves the small entries, not the strings.
+        /// The elements are [array::string_key]() objects referring into the arena,
+        /// lookup can be done with anything convertible to it.
+        ///
+        /// Erasing a string leaves its characters in the arena,
+        /// they are removed once they make up at least half of the arena and it would need to grow, or on `shrink_to_fit()`.
+        /// `Compare`, `AllowDuplicates` and `SearchPolicy` are like in [array::flat_set]().
+        template <class Compare = key_compare_default, class BlockStorage = block_storage_default,
+                  bool AllowDuplicates = false, class SearchPolicy = search_default>
+        class flat_string_set : detail::search_index<SearchPolicy, string_key, BlockStorage>
+        {
+            using entry             = detail::string_arena_entry;
+            using search_index_type = detail::search_index<SearchPolicy, string_key, BlockStorage>;
+
+        public:
+            using key_type   = string_key;
+            using value_type = key_type;
+
+            using key_compare   = Compare;
+            using value_compare = key_compare;
+
+            using is_multiset = std::integral_constant<bool, AllowDuplicates>;
+
+            using block_storage = BlockStorage;
+            using search_policy = SearchPolicy;
+
+            using iterator       = detail::string_arena_iterator;
+            using const_iterator = iterator;
+
+            //=== constructors/destructors ===//
+            /// Default constructor.
+            /// \effects Creates a set without any elements.
+            /// The block storage is initialized with default constructed arguments.
+            flat_string_set() : bytes_(0u) {}
+
+            /// \effects Creates a set without any elements.
+            /// The block storage is initialized with the given arguments.
+            /// \notes It will be copied to initialize the arena and the entries.
+            explicit flat_string_set(typename block_storage::arg_type args) noexcept
+            : search_index_type(args), arena_(args), entries_(std::move(args)), bytes_(0u)
+            {
+            }
+
+            flat_string_set(const flat_string_set&) = default;
+
+            flat_string_set(flat_string_set&& other) noexcept(
+                block_storage_nothrow_move<BlockStorage, char>{})
+            : search_index_type(std::move(other.search_index())),
+              arena_(std::move(other.arena_)),
+              entries_(std::move(other.entries_)),
+              bytes_(other.bytes_)
+            {
+                other.bytes_ = 0u;
+            }
+
+            ~flat_string_set() noexcept = default;
+
+            flat_string_set& operator=(const flat_string_set&) = default;
+
+            flat_string_set& operator=(flat_string_set&& other) noexcept(
+                block_storage_nothrow_move<BlockStorage, char>{})
+            {
+                search_index() = std::move(other.search_index());
+                arena_         = std::move(other.arena_);
+                entries_       = std::move(other.entries_);
+                bytes_         = other.bytes_;
+                other.bytes_   = 0u;
+                return *this;
+            }
+
+            /// Swap.
+            friend void swap(flat_string_set& lhs, flat_string_set& rhs) noexcept(
+                block_storage_nothrow_move<BlockStorage, char>{})
+            {
+                swap(lhs.arena_, rhs.arena_);
+                swap(lhs.entries_, rhs.entries_);
+                std::swap(lhs.bytes_, rhs.bytes_);
+                swap(lhs.search_index(), rhs.search_index());
+            }
+
+            //=== access ===//
+            const_iterator begin() const noexcept
+            {
+                return cbegin();
+            }
+            const_iterator cbegin() const noexcept
+            {
+                return make_iterator(0u);
+            }
+
+            const_iterator end() const noexcept
+            {
+                return cend();
+            }
+            const_iterator cend() const noexcept
+            {
+                return make_iterator(size());
+            }
+
+            /// \returns The minimal string.
+            string_key min() const noexcept
+            {
+                assert(!empty());
+                return *begin();
+            }
+
+            /// \returns The maximal string.
+            string_key max() const noexcept
+            {
+                assert(!empty());
+                return *std::prev(end());
+            }
+
+            //=== capacity ===//
+            /// \returns Whether or not the set is empty.
+            bool empty() const noexcept
+            {
+                return entries_.empty();
+            }
+
+            /// \returns The number of strings in the set.
+            size_type size() const noexcept
+            {
+                return entries_.size();
+            }
+
+            /// \returns The number of strings the set can contain without reserving new memory for the entries.
+            size_type capacity() const noexcept
+            {
+                return entries_.capacity();
+            }
+
+            /// \returns The maximum number of strings as determined by the block storage.
+            size_type max_size() const noexcept
+            {
+                return entries_.max_size();
+            }
+
+            /// \returns The total number of characters of all strings in the set.
+            size_type total_length() const noexcept
+            {
+                return bytes_;
+            }
+
+            /// \returns The number of characters the arena can contain without reserving new memory.
+            /// \notes This includes the characters of erased strings that are still in the arena.
+            size_type arena_capacity() const noexcept
+            {
+                return arena_.capacity();
+            }
+
+            /// \effects Reserves new memory to make capacity as least as big as `new_capacity`,
+            /// and the arena capacity as least as big as `new_total_length` if that isn't the case already.
+            void reserve(size_type new_capacity, size_type new_total_length = 0u)
+            {
+                entries_.reserve(new_capacity);
+                search_index().reserve(new_capacity);
+                arena_.reserve(new_total_length);
+            }
+
+            /// \effects Removes the characters of erased strings from the arena,
+            /// and makes a non-binding request to make the capacity as small as necessary.
+            void shrink_to_fit()
+            {
+                if (arena_.size() != bytes_)
+                    compact(0u);
+                arena_.shrink_to_fit();
+                entries_.shrink_to_fit();
+                search_index().shrink_to_fit();
+            }
+
+            //=== modifiers ===//
+            /// The result of an insert operation.
+            class insert_result
+            {
+            public:
+                /// \returns An iterator to the string.
+                iterator iter() const noexcept
+                {
+                    return iter_;
+                }
+
+                /// \returns Whether or not the string was already present in the set.
+                bool was_duplicate() const noexcept
+                {
+                    return was_duplicate_;
+                }
+
+                /// \returns Whether or not the string was inserted into the set.
+                /// If `was_duplicate() == false`, this is `true`.
+                /// Otherwise it is only true if the set allows duplicates.
+                bool was_inserted() const noexcept
+                {
+                    return !was_duplicate_ || AllowDuplicates;
+                }
+
+            private:
+                insert_result(iterator iter, bool dup) : iter_(iter), was_duplicate_(dup) {}
+
+                iterator iter_;
+                bool     was_duplicate_;
+
+                friend flat_string_set;
+            };
+
+            /// \effects Does a lookup for the given string.
+            /// If the string isn't part of the set or the set allows duplicates,
+            /// copies its characters into the arena.
+            /// Otherwise, does nothing.
+            /// \returns The result of the insert operation.
+            insert_result insert(string_key str)
+            {
+                auto range = equal_range(str);
+                if (AllowDuplicates || range.empty())
+                {
+                    // we either don't care about duplicates or the string is not in the set
+                    auto index = size_type(range.end() - begin());
+                    entries_.reserve(size() + 1u);
+                    search_index().reserve(size() + 1u);
+
+                    auto offset = append_characters(str);
+                    entries_.insert(entries_.begin() + std::ptrdiff_t(index),
+                                    entry{offset, str.size()});
+                    bytes_ += str.size();
+                    search_index().insert(index, make_iterator(index)[0]);
+
+                    return {make_iterator(index), !range.empty()};
+                }
+                else
+                {
+                    // we don't allow duplicates and the string is already in the set
+                    assert(std::next(range.begin()) == range.end());
+                    return {range.begin(), true};
+                }
+            }
+
+            /// \effects Inserts all strings in the range `[begin, end)`.
+            template <typename InputIt>
+            void insert_range(InputIt begin, InputIt end)
+            {
+                insert_range_impl(typename std::iterator_traits<InputIt>::iterator_category{},
+                                  begin, end);
+            }
+
+            /// \effects Destroys and removes all strings.
+            void clear() noexcept
+            {
+                arena_.clear();
+                entries_.clear();
+                bytes_ = 0u;
+                search_index().clear();
+            }
+
+            /// \effects Removes the string at the given position.
+            /// \returns An iterator after the string that was removed.
+            iterator erase(iterator pos) noexcept
+            {
+                return erase_range(pos, std::next(pos));
+            }
+
+            /// \effects Removes all strings in the range `[begin, end)`.
+            /// \returns An iterator after the last string that was removed.
+            iterator erase_range(iterator begin, iterator end) noexcept
+            {
+                auto first = begin - this->begin();
+                auto last  = end - this->begin();
+                for (auto cur = begin; cur != end; ++cur)
+                    bytes_ -= cur->size();
+
+                search_index().erase_range(size_type(first), size_type(last));
+                entries_.erase_range(entries_.begin() + first, entries_.begin() + last);
+                return this->begin() + first;
+            }
+
+            /// \effects Removes all occurrences of `str`.
+            /// \returns The number of strings that were removed, if it doesn't allow duplicates,
+            /// whether or not any were removed otherwise.
+            auto erase_all(string_key str) noexcept ->
+                typename std::conditional<AllowDuplicates, size_type, bool>::type
+            {
+                auto range = equal_range(str);
+
+                using result_type =
+                    typename std::conditional<AllowDuplicates, size_type, bool>::type;
+                auto count = result_type(range.end() - range.begin());
+
+                erase_range(range.begin(), range.end());
+
+                return count;
+            }
+
+            /// \effects Conceptually the same as `flat_string_set s; s.insert_range(begin, end); *this = std::move(s);`
+            /// \notes If the iterators are forward iterators,
+            /// the arena and the entries are only allocated once and then sorted,
+            /// instead of inserting each string individually.
+            template <typename InputIt>
+            void assign_range(InputIt begin, InputIt end)
+            {
+                clear();
+                assign_range_impl(typename std::iterator_traits<InputIt>::iterator_category{},
+                                  begin, end);
+            }
+
+            //=== lookup ===//
+            /// \returns Whether or not the string is contained in the set.
+            bool contains(string_key str) const noexcept
+            {
+                return find(str) != end();
+            }
+
+            /// \returns An iterator to the given string, or `end()` if the string is not in the set.
+            const_iterator find(string_key str) const noexcept
+            {
+                auto lower = lower_bound(str);
+                if (lower == end())
+                    return end();
+                else if (Compare::compare(*lower, str) == key_ordering::equivalent)
+                    return lower;
+                else
+                    return end();
+            }
+
+            /// \returns The number of occurences of `str` in the set.
+            size_type count(string_key str) const noexcept
+            {
+                auto range = equal_range(str);
+                return size_type(range.end() - range.begin());
+            }
+
+            /// \returns Same as [array::lower_bound]() for the given string.
+            const_iterator lower_bound(string_key str) const noexcept
+            {
+                return search_index().template lower_bound<Compare>(begin(), end(), str);
+            }
+
+            /// \returns Same as [array::upper_bound]() for the given string.
+            const_iterator upper_bound(string_key str) const noexcept
+            {
+                return search_index().template upper_bound<Compare>(begin(), end(), str);
+            }
+
+            /// \returns Same as [array::equal_range]() for the given string.
+            iter_pair<const_iterator> equal_range(string_key str) const noexcept
+            {
+                return search_index().template equal_range<Compare>(begin(), end(), str);
+            }
+
+        private:
+            search_index_type& search_index() noexcept
+            {
+                return *this;
+            }
+            const search_index_type& search_index() const noexcept
+            {
+                return *this;
+            }
+
+            const char* arena_data() const noexcept
+            {
+                return iterator_to_pointer(arena_.begin());
+            }
+
+            iterator make_iterator(size_type index) const noexcept
+            {
+                return iterator(typename iterator::private_key{},
+                                iterator_to_pointer(entries_.begin()) + index, arena_data());
+            }
+
+            // returns the offset of the characters in the arena
+            size_type append_characters(string_key str)
+            {
+                if (arena_.capacity() - arena_.size() < str.size())
+                {
+                    auto in_arena = !std::less<const char*>{}(str.data(), arena_data())
+                                    && std::less<const char*>{}(str.data(),
+                                                                arena_data() + arena_.size());
+                    if (in_arena)
+                    {
+                        // the string is going to be invalidated
+                        std::string copy(str);
+                        return append_characters(copy);
+                    }
+
+                    if (arena_.size() - bytes_ >= arena_.size() / 2u)
+                        // at least half of the arena is garbage
+                        compact(str.size());
+                    else
+                        arena_.reserve(arena_.size() + str.size());
+                }
+
+                auto offset = arena_.size();
+                arena_.append_range(str.begin(), str.end());
+                return offset;
+            }
+
+            // moves the characters of all strings to a new arena,
+            // ordered by the strings
+            void compact(size_type additional)
+            {
+                // the moved-from arena keeps the arguments of its block storage
+                auto old_arena = std::move(arena_);
+                try
+                {
+                    arena_.reserve(bytes_ + additional);
+                }
+                catch (...)
+                {
+                    arena_ = std::move(old_arena);
+                    throw;
+                }
+
+                auto old_data = iterator_to_pointer(old_arena.begin());
+                for (auto& e : entries_)
+                {
+                    auto offset = arena_.size();
+                    arena_.append_range(old_data + e.offset, old_data + e.offset + e.size);
+                    e.offset = offset;
+                }
+            }
+
+            template <typename InputIt>
+            void insert_range_impl(std::input_iterator_tag, InputIt begin, InputIt end)
+            {
+                for (auto cur = begin; cur != end; ++cur)
+                    insert(*cur);
+            }
+            template <typename ForwardIt>
+            void insert_range_impl(std::forward_iterator_tag, ForwardIt begin, ForwardIt end)
+            {
+                auto count  = size_type(0);
+                auto length = size_type(0);
+                for (auto cur = begin; cur != end; ++cur)
+                {
+                    ++count;
+                    length += string_key(*cur).size();
+                }
+                reserve(size() + count, arena_.size() + length);
+
+                insert_range_impl(std::input_iterator_tag{}, begin, end);
+            }
+
+            template <typename InputIt>
+            void assign_range_impl(std::input_iterator_tag, InputIt begin, InputIt end)
+            {
+                insert_range_impl(std::input_iterator_tag{}, begin, end);
+            }
+            template <typename ForwardIt>
+            void assign_range_impl(std::forward_iterator_tag, ForwardIt begin, ForwardIt end)
+            {
+                auto count  = size_type(0);
+                auto length = size_type(0);
+                for (auto cur = begin; cur != end; ++cur)
+                {
+                    ++count;
+                    length += string_key(*cur).size();
+                }
+                reserve(count, length);
+
+                // append all strings, then sort + unique
+                for (auto cur = begin; cur != end; ++cur)
+                {
+                    auto str    = string_key(*cur);
+                    auto offset = arena_.size();
+                    arena_.append_range(str.begin(), str.end());
+                    entries_.push_back(entry{offset, str.size()});
+                }
+                bytes_ = length;
+
+                auto data = arena_data();
+                auto less = [&](const entry& lhs, const entry& rhs) {
+                    return Compare::compare(string_key(data + lhs.offset, lhs.size),
+                                            string_key(data + rhs.offset, rhs.size))
+                           == key_ordering::less;
+                };
+                std::sort(entries_.begin(), entries_.end(), less);
+
+                if (!AllowDuplicates)
+                {
+                    auto new_end = std::unique(entries_.begin(), entries_.end(),
+                                               [&](const entry& lhs, const entry& rhs) {
+                                                   return !less(lhs, rhs);
+                                               });
+                    entries_.erase_range(new_end, entries_.end());
+
+                    // the removed elements are unspecified, so count the ones that were kept
+                    bytes_ = 0u;
+                    for (auto& e : entries_)
+                        bytes_ += e.size;
+                }
+
+                search_index().assign(this->begin(), this->end());
+            }
+
+            array<char, BlockStorage>  arena_;
+            array<entry, BlockStorage> entries_;
+            size_type                  bytes_;
+        };
+
+        /// Convenience typedef for an [array::flat_string_set]() that allows duplicates.
+        template <class Compare = key_compare_default, class BlockStorage = block_storage_default,
+                  class SearchPolicy = search_default>
+        using flat_string_multiset = flat_string_set<Compare, BlockStorage, true, SearchPolicy>;
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_FLAT_STRING_SET_HPP_INCLUDED
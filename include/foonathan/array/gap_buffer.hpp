@@ -0,0 +1,578 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_GAP_BUFFER_HPP_INCLUDED
+#define FOONATHAN_ARRAY_GAP_BUFFER_HPP_INCLUDED
+
+#include <cassert>
+#include <iterator>
+#include <type_traits>
+
+#include <foonathan/array/array_view.hpp>
+#include <foonathan/array/block_storage.hpp>
+#include <foonathan/array/block_storage_new.hpp>
+
+namespace foonathan
+{
+    namespace array
+    {
+        namespace detail
+        {
+            template <typename T>
+            class gap_buffer_iterator
+            {
+            public:
+                struct private_key
+                {
+                    explicit private_key() {}
+                };
+
+                using iterator_category = std::random_access_iterator_tag;
+                using value_type        = typename std::remove_const<T>::type;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = T*;
+                using reference         = T&;
+
+                gap_buffer_iterator() noexcept
+                : data_(nullptr), gap_begin_(0u), gap_size_(0u), index_(0u)
+                {
+                }
+
+                explicit gap_buffer_iterator(private_key, T* data, size_type gap_begin,
+                                             size_type gap_size, size_type index) noexcept
+                : data_(data), gap_begin_(gap_begin), gap_size_(gap_size), index_(index)
+                {
+                }
+
+                template <typename NonConst,
+                          typename = typename std::enable_if<
+                              std::is_const<T>::value
+                              && std::is_same<NonConst, value_type>::value>::type>
+                gap_buffer_iterator(const gap_buffer_iterator<NonConst>& non_const) noexcept
+                : data_(non_const.data_),
+                  gap_begin_(non_const.gap_begin_),
+                  gap_size_(non_const.gap_size_),
+                  index_(non_const.index_)
+                {
+                }
+
+                //=== access ===//
+                reference operator*() const noexcept
+                {
+                    return (*this)[0];
+                }
+
+                pointer operator->() const noexcept
+                {
+                    return &**this;
+                }
+
+                reference operator[](difference_type offset) const noexcept
+                {
+                    auto index = size_type(difference_type(index_) + offset);
+                    return data_[index < gap_begin_ ? index : index + gap_size_];
+                }
+
+                size_type get_index(private_key) const noexcept
+                {
+                    return index_;
+                }
+
+                //=== increment/decrement ===//
+                gap_buffer_iterator& operator++() noexcept
+                {
+                    ++index_;
+                    return *this;
+                }
+                gap_buffer_iterator operator++(int) noexcept
+                {
+                    auto save = *this;
+                    ++*this;
+                    return save;
+                }
+
+                gap_buffer_iterator& operator--() noexcept
+                {
+                    --index_;
+                    return *this;
+                }
+                gap_buffer_iterator operator--(int) noexcept
+                {
+                    auto save = *this;
+                    --*this;
+                    return save;
+                }
+
+                gap_buffer_iterator& operator+=(difference_type offset) noexcept
+                {
+                    index_ = size_type(difference_type(index_) + offset);
+                    return *this;
+                }
+                gap_buffer_iterator& operator-=(difference_type offset) noexcept
+                {
+                    return *this += -offset;
+                }
+
+                //=== addition/subtraction ===//
+                friend gap_buffer_iterator operator+(gap_buffer_iterator iter,
+                                                     difference_type     offset) noexcept
+                {
+                    return iter += offset;
+                }
+                friend gap_buffer_iterator operator+(difference_type     offset,
+                                                     gap_buffer_iterator iter) noexcept
+                {
+                    return iter += offset;
+                }
+
+                friend gap_buffer_iterator operator-(gap_buffer_iterator iter,
+                                                     difference_type     offset) noexcept
+                {
+                    return iter -= offset;
+                }
+
+                friend difference_type operator-(gap_buffer_iterator lhs,
+                                                 gap_buffer_iterator rhs) noexcept
+                {
+                    return difference_type(lhs.index_) - difference_type(rhs.index_);
+                }
+
+                //=== comparison ===//
+                friend bool operator==(gap_buffer_iterator lhs, gap_buffer_iterator rhs) noexcept
+                {
+                    return lhs.index_ == rhs.index_;
+                }
+                friend bool operator!=(gap_buffer_iterator lhs, gap_buffer_iterator rhs) noexcept
+                {
+                    return lhs.index_ != rhs.index_;
+                }
+
+                friend bool operator<(gap_buffer_iterator lhs, gap_buffer_iterator rhs) noexcept
+                {
+                    return lhs.index_ < rhs.index_;
+                }
+                friend bool operator>(gap_buffer_iterator lhs, gap_buffer_iterator rhs) noexcept
+                {
+                    return lhs.index_ > rhs.index_;
+                }
+                friend bool operator<=(gap_buffer_iterator lhs, gap_buffer_iterator rhs) noexcept
+                {
+                    return lhs.index_ <= rhs.index_;
+                }
+                friend bool operator>=(gap_buffer_iterator lhs, gap_buffer_iterator rhs) noexcept
+                {
+                    return lhs.index_ >= rhs.index_;
+                }
+
+            private:
+                T*        data_;
+                size_type gap_begin_, gap_size_, index_;
+
+                template <typename>
+                friend class gap_buffer_iterator;
+            };
+        } // namespace detail
+
+        /// A sequence of elements optimized for insertion and erasure around a cursor.
+        ///
+        /// It stores the elements in a single memory block with a gap of unused memory at the position of the last edit.
+        /// Inserting or erasing at the gap is amortized `O(1)`,
+        /// editing at a different position first moves the gap there, which moves the elements in between.
+        /// So if the edits are clustered, like text edits at a cursor, only a few elements are ever moved,
+        /// where an [array::array]() moves all elements after the position.
+        ///
+        /// The elements are not contiguous, call `make_contiguous()` to get an [array::array_view]() to all of them.
+        /// \notes Any modification invalidates all iterators.
+        template <typename T, class BlockStorage = block_storage_default>
+        class gap_buffer
+        {
+            // moving requires closing the gap, so the elements must be nothrow movable as well
+            using nothrow_move =
+                std::integral_constant<bool, block_storage_nothrow_move<BlockStorage, T>::value
+                                                 && std::is_nothrow_move_constructible<T>::value>;
+
+        public:
+            using value_type    = T;
+            using block_storage = BlockStorage;
+
+            using iterator       = detail::gap_buffer_iterator<T>;
+            using const_iterator = detail::gap_buffer_iterator<const T>;
+
+            //=== constructors/destructors ===//
+            /// Default constructor.
+            /// \effects Creates a gap buffer without any elements.
+            /// The block storage is initialized with default constructed arguments.
+            gap_buffer() : gap_buffer(typename block_storage::arg_type{}) {}
+
+            /// \effects Creates a gap buffer without any elements.
+            /// The block storage is initialized with the given arguments.
+            explicit gap_buffer(typename block_storage::arg_type args) noexcept
+            : storage_(std::move(args)), gap_begin_(0u), gap_end_(capacity())
+            {
+            }
+
+            /// Copy constructor.
+            gap_buffer(const gap_buffer& other) : gap_buffer(other.storage_.arguments())
+            {
+                reserve(other.size());
+                for (auto& element : other)
+                    emplace_back(element);
+            }
+
+            /// Move constructor.
+            gap_buffer(gap_buffer&& other) noexcept(nothrow_move::value)
+            : gap_buffer(other.storage_.arguments())
+            {
+                swap(*this, other);
+            }
+
+            /// Destructor.
+            ~gap_buffer() noexcept
+            {
+                destroy_range(data(), data() + gap_begin_);
+                destroy_range(data() + gap_end_, data() + capacity());
+            }
+
+            /// Copy assignment operator.
+            /// \notes Like the copy assignment of [array::array](), it propagates the arguments of the block storage.
+            gap_buffer& operator=(const gap_buffer& other)
+            {
+                gap_buffer copy(other);
+                swap(*this, copy);
+                return *this;
+            }
+
+            /// Move assignment operator.
+            gap_buffer& operator=(gap_buffer&& other) noexcept(nothrow_move::value)
+            {
+                auto new_view = move_assign(storage_, block_view<T>(make_contiguous()),
+                                            std::move(other.storage_),
+                                            block_view<T>(other.make_contiguous()));
+                gap_begin_       = new_view.size();
+                gap_end_         = capacity();
+                other.gap_begin_ = 0u;
+                other.gap_end_   = other.capacity();
+                return *this;
+            }
+
+            /// Swap.
+            /// \notes This moves the gap of both buffers to the end.
+            friend void swap(gap_buffer& lhs, gap_buffer& rhs) noexcept(nothrow_move::value)
+            {
+                auto lhs_view = block_view<T>(lhs.make_contiguous());
+                auto rhs_view = block_view<T>(rhs.make_contiguous());
+                BlockStorage::swap(lhs.storage_, lhs_view, rhs.storage_, rhs_view);
+                lhs.gap_begin_ = lhs_view.size();
+                lhs.gap_end_   = lhs.capacity();
+                rhs.gap_begin_ = rhs_view.size();
+                rhs.gap_end_   = rhs.capacity();
+            }
+
+            //=== access ===//
+            iterator begin() noexcept
+            {
+                return make_iterator<iterator>(0u);
+            }
+            const_iterator begin() const noexcept
+            {
+                return cbegin();
+            }
+            const_iterator cbegin() const noexcept
+            {
+                return make_iterator<const_iterator>(0u);
+            }
+
+            iterator end() noexcept
+            {
+                return make_iterator<iterator>(size());
+            }
+            const_iterator end() const noexcept
+            {
+                return cend();
+            }
+            const_iterator cend() const noexcept
+            {
+                return make_iterator<const_iterator>(size());
+            }
+
+            T& operator[](size_type i) noexcept
+            {
+                assert(i < size());
+                return data()[physical_index(i)];
+            }
+            const T& operator[](size_type i) const noexcept
+            {
+                assert(i < size());
+                return data()[physical_index(i)];
+            }
+
+            T& front() noexcept
+            {
+                return (*this)[0u];
+            }
+            const T& front() const noexcept
+            {
+                return (*this)[0u];
+            }
+
+            T& back() noexcept
+            {
+                return (*this)[size() - 1u];
+            }
+            const T& back() const noexcept
+            {
+                return (*this)[size() - 1u];
+            }
+
+            /// \returns The position of the gap, i.e. the number of elements before it.
+            /// Inserting or erasing at that position doesn't move any elements.
+            size_type gap_position() const noexcept
+            {
+                return gap_begin_;
+            }
+
+            /// \effects Moves the gap to the end, so the elements are contiguous.
+            /// \returns A view to all elements.
+            array_view<T> make_contiguous() noexcept(std::is_nothrow_move_constructible<T>::value)
+            {
+                move_gap(size());
+                return array_view<T>(data(), size());
+            }
+
+            //=== capacity ===//
+            /// \returns Whether or not the gap buffer is empty.
+            bool empty() const noexcept
+            {
+                return size() == 0u;
+            }
+
+            /// \returns The number of elements in the gap buffer.
+            size_type size() const noexcept
+            {
+                return capacity() - gap_size();
+            }
+
+            /// \returns The number of elements the gap buffer can contain without reserving new memory.
+            size_type capacity() const noexcept
+            {
+                return storage_.block().size() / sizeof(T);
+            }
+
+            /// \returns The maximum number of elements as determined by the block storage.
+            size_type max_size() const noexcept
+            {
+                return BlockStorage::max_size(storage_.arguments()) / sizeof(T);
+            }
+
+            /// \effects Reserves new memory to make capacity as least as big as `new_capacity` if that isn't the case already.
+            /// \notes If it reserves new memory, the gap is moved to the end first.
+            void reserve(size_type new_capacity)
+            {
+                auto cur_cap_bytes = storage_.block().size();
+                auto new_cap_bytes = new_capacity * sizeof(T);
+                if (new_cap_bytes > cur_cap_bytes)
+                {
+                    // the block storage only moves contiguous objects
+                    auto constructed = block_view<T>(make_contiguous());
+                    storage_.reserve(new_cap_bytes - cur_cap_bytes, constructed);
+                    gap_end_ = capacity();
+                }
+            }
+
+            /// \effects Non-binding request to make the capacity as small as necessary.
+            /// \notes This moves the gap to the end.
+            void shrink_to_fit()
+            {
+                auto constructed = block_view<T>(make_contiguous());
+                storage_.shrink_to_fit(constructed);
+                gap_end_ = capacity();
+            }
+
+            //=== modifiers ===//
+            /// \effects Creates a new element before the specified iterator,
+            /// moving the gap there first.
+            /// \returns An iterator to the element that was just inserted.
+            template <typename... Args>
+            iterator emplace(const_iterator pos, Args&&... args)
+            {
+                auto index = index_of(pos);
+                if (gap_size() == 0u)
+                    reserve(size() + 1u);
+                move_gap(index);
+
+                construct_object<T>(to_raw_pointer(data() + gap_begin_),
+                                    std::forward<Args>(args)...);
+                ++gap_begin_;
+                return begin() + std::ptrdiff_t(index);
+            }
+
+            /// \effects Same as `emplace(pos, element)`.
+            iterator insert(const_iterator pos, const T& element)
+            {
+                return emplace(pos, element);
+            }
+
+            /// \effects Same as `emplace(pos, std::move(element))`.
+            iterator insert(const_iterator pos, T&& element)
+            {
+                return emplace(pos, std::move(element));
+            }
+
+            /// \effects Inserts elements from the range `[begin, end)` before `pos`,
+            /// moving the gap there first.
+            /// \returns An iterator to the first inserted element, or `pos` if the range was empty.
+            template <typename InputIt>
+            iterator insert_range(const_iterator pos, InputIt begin, InputIt end)
+            {
+                auto index = index_of(pos);
+                reserve(size()
+                        + range_size(typename std::iterator_traits<InputIt>::iterator_category{},
+                                     begin, end));
+
+                auto cur_index = index;
+                for (auto cur = begin; cur != end; ++cur)
+                    emplace(this->begin() + std::ptrdiff_t(cur_index++), *cur);
+                return this->begin() + std::ptrdiff_t(index);
+            }
+
+            /// \effects Same as `emplace(end(), args...)`.
+            /// \returns A reference to the newly constructed element.
+            template <typename... Args>
+            T& emplace_back(Args&&... args)
+            {
+                return *emplace(cend(), std::forward<Args>(args)...);
+            }
+
+            /// \effects Same as `emplace_back(element)`.
+            void push_back(const T& element)
+            {
+                emplace_back(element);
+            }
+
+            /// \effects Same as `emplace_back(std::move(element))`.
+            void push_back(T&& element)
+            {
+                emplace_back(std::move(element));
+            }
+
+            /// \effects Destroys all elements.
+            void clear() noexcept
+            {
+                destroy_range(data(), data() + gap_begin_);
+                destroy_range(data() + gap_end_, data() + capacity());
+                gap_begin_ = 0u;
+                gap_end_   = capacity();
+            }
+
+            /// \effects Same as `erase(std::prev(end()))`.
+            void pop_back() noexcept(std::is_nothrow_move_constructible<T>::value)
+            {
+                erase(std::prev(cend()));
+            }
+
+            /// \effects Destroys and removes the element at the given position,
+            /// moving the gap there first.
+            /// \returns An iterator after the element that was removed.
+            iterator erase(const_iterator pos) noexcept(
+                std::is_nothrow_move_constructible<T>::value)
+            {
+                return erase_range(pos, std::next(pos));
+            }
+
+            /// \effects Destroys and removes all elements in the range `[begin, end)`,
+            /// moving the gap to `begin` first.
+            /// \returns An iterator after the last element that was removed.
+            iterator erase_range(const_iterator begin, const_iterator end) noexcept(
+                std::is_nothrow_move_constructible<T>::value)
+            {
+                auto index = index_of(begin);
+                auto count = index_of(end) - index;
+                move_gap(index);
+
+                destroy_range(data() + gap_end_, data() + gap_end_ + count);
+                gap_end_ += count;
+                return this->begin() + std::ptrdiff_t(index);
+            }
+
+        private:
+            T* data() const noexcept
+            {
+                return to_pointer<T>(storage_.block().begin());
+            }
+
+            size_type gap_size() const noexcept
+            {
+                return gap_end_ - gap_begin_;
+            }
+
+            size_type physical_index(size_type i) const noexcept
+            {
+                return i < gap_begin_ ? i : i + gap_size();
+            }
+
+            template <class Iterator>
+            Iterator make_iterator(size_type index) const noexcept
+            {
+                return Iterator(typename Iterator::private_key{}, data(), gap_begin_, gap_size(),
+                                index);
+            }
+
+            size_type index_of(const_iterator iter) const noexcept
+            {
+                auto index = iter.get_index(typename const_iterator::private_key{});
+                assert(index <= size());
+                return index;
+            }
+
+            // moves the elements between the gap and the index to the other side of the gap,
+            // each step is one move construction and keeps the buffer valid
+            void move_gap(size_type index) noexcept(std::is_nothrow_move_constructible<T>::value)
+            {
+                assert(index <= size());
+                if (gap_size() == 0u)
+                {
+                    // no gap, nothing to move
+                    gap_begin_ = gap_end_ = index;
+                    return;
+                }
+
+                auto data = this->data();
+                while (gap_begin_ > index)
+                {
+                    construct_object<T>(to_raw_pointer(data + gap_end_ - 1u),
+                                        std::move_if_noexcept(data[gap_begin_ - 1u]));
+                    destroy_object(data + gap_begin_ - 1u);
+                    --gap_begin_;
+                    --gap_end_;
+                }
+                while (gap_begin_ < index)
+                {
+                    construct_object<T>(to_raw_pointer(data + gap_begin_),
+                                        std::move_if_noexcept(data[gap_end_]));
+                    destroy_object(data + gap_end_);
+                    ++gap_begin_;
+                    ++gap_end_;
+                }
+            }
+
+            template <typename InputIt>
+            static size_type range_size(std::input_iterator_tag, InputIt, InputIt)
+            {
+                return size_type(0u);
+            }
+
+            template <typename ForwardIt>
+            static size_type range_size(std::forward_iterator_tag, ForwardIt begin, ForwardIt end)
+            {
+                return size_type(std::distance(begin, end));
+            }
+
+            BlockStorage storage_;
+            // the elements are stored in [0, gap_begin_) and [gap_end_, capacity())
+            size_type gap_begin_, gap_end_;
+        };
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_GAP_BUFFER_HPP_INCLUDED
@@ -6,6 +6,7 @@
 #define FOONATHAN_ARRAY_GROWTH_POLICY_HPP_INCLUDED
 
 #include <type_traits>
+#include <utility>
 
 #include <foonathan/array/memory_block.hpp>
 
@@ -123,15 +124,381 @@ namespace foonathan
             }
 
             /// \returns `size_needed`, i.e. shrink to the minimum.
-            static size_type shrink_size(size_type cur_size, size_type size_needed) noexcept
+            static size_type shrink_size(size_type cur_size, size_type size_needed,
+                                         size_type max_size) noexcept
             {
                 (void)cur_size;
+                (void)max_size;
                 return size_needed;
             }
         };
 
         /// The default growth policy.
         using default_growth = factor_growth<2>;
+
+        //=== growth_context ===//
+        /// The configuration of a `GrowthPolicy` that doesn't have any.
+        struct no_growth_config
+        {
+        };
+
+        namespace detail
+        {
+            template <typename T>
+            struct void_type
+            {
+                using type = void;
+            };
+
+            template <class GrowthPolicy, typename = void>
+            struct growth_config
+            {
+                using type = no_growth_config;
+            };
+
+            template <class GrowthPolicy>
+            struct growth_config<GrowthPolicy,
+                                 typename void_type<typename GrowthPolicy::config_type>::type>
+            {
+                using type = typename GrowthPolicy::config_type;
+            };
+        } // namespace detail
+
+        /// The runtime configuration of a `GrowthPolicy`.
+        ///
+        /// It is `GrowthPolicy::config_type` if there is such a typedef, [array::no_growth_config]() otherwise.
+        template <class GrowthPolicy>
+        using growth_policy_config = typename detail::growth_config<GrowthPolicy>::type;
+
+        /// Whether or not a `GrowthPolicy` has a runtime configuration.
+        template <class GrowthPolicy>
+        using has_growth_config =
+            std::integral_constant<bool, !std::is_same<growth_policy_config<GrowthPolicy>,
+                                                       no_growth_config>::value>;
+
+        namespace detail
+        {
+            template <class Heap>
+            auto heap_good_size(int, const typename Heap::handle_type& handle,
+                                size_type size) noexcept -> decltype(Heap::good_size(handle, size))
+            {
+                return Heap::good_size(handle, size);
+            }
+            template <class Heap>
+            size_type heap_good_size(short, const typename Heap::handle_type&,
+                                     size_type size) noexcept
+            {
+                return size;
+            }
+        } // namespace detail
+
+        /// The context a `GrowthPolicy` is given when computing a new block size.
+        ///
+        /// It gives access to the `Heap` that will allocate the block,
+        /// the runtime configuration of the policy,
+        /// and the size and alignment of the objects that will be stored in the block.
+        template <class Heap, class GrowthPolicy>
+        class growth_context
+        {
+        public:
+            using heap        = Heap;
+            using handle_type = typename Heap::handle_type;
+            using config_type = growth_policy_config<GrowthPolicy>;
+
+            /// \effects Creates the context giving it a copy of the handle and configuration,
+            /// as well as the properties of the objects.
+            growth_context(handle_type handle, config_type config, size_type element_size,
+                           size_type alignment) noexcept
+            : handle_(std::move(handle)),
+              config_(std::move(config)),
+              element_size_(element_size),
+              alignment_(alignment)
+            {
+            }
+
+            /// \returns The handle of the `Heap` that will allocate the block.
+            const handle_type& handle() const noexcept
+            {
+                return handle_;
+            }
+
+            /// \returns The runtime configuration of the `GrowthPolicy`.
+            const config_type& config() const noexcept
+            {
+                return config_;
+            }
+
+            /// \returns The size of the objects that will be stored in the block.
+            size_type element_size() const noexcept
+            {
+                return element_size_;
+            }
+
+            /// \returns The alignment of the objects that will be stored in the block.
+            size_type alignment() const noexcept
+            {
+                return alignment_;
+            }
+
+            /// \returns The maximum size of a block as determined by the `Heap`.
+            size_type max_size() const noexcept
+            {
+                return Heap::max_size(handle_);
+            }
+
+            /// \returns The size of the block the `Heap` will actually return for a request of the given size.
+            /// \notes This calls `Heap::good_size()` if there is one, otherwise it returns `size`.
+            size_type good_size(size_type size) const noexcept
+            {
+                return detail::heap_good_size<Heap>(0, handle_, size);
+            }
+
+        private:
+            handle_type handle_;
+            config_type config_;
+            size_type   element_size_, alignment_;
+        };
+
+        namespace detail
+        {
+            template <class GrowthPolicy, class Context>
+            auto growth_size_impl(int, const Context& context, size_type cur_size,
+                                  size_type additional_needed) noexcept
+                -> decltype(GrowthPolicy::growth_size(context, cur_size, additional_needed))
+            {
+                return GrowthPolicy::growth_size(context, cur_size, additional_needed);
+            }
+            template <class GrowthPolicy, class Context>
+            auto growth_size_impl(short, const Context& context, size_type cur_size,
+                                  size_type additional_needed) noexcept
+                -> decltype(GrowthPolicy::growth_size(cur_size, additional_needed,
+                                                      context.max_size()))
+            {
+                return GrowthPolicy::growth_size(cur_size, additional_needed, context.max_size());
+            }
+
+            template <class GrowthPolicy, class Context>
+            auto shrink_size_impl(int, const Context& context, size_type cur_size,
+                                  size_type size_needed) noexcept
+                -> decltype(GrowthPolicy::shrink_size(context, cur_size, size_needed))
+            {
+                return GrowthPolicy::shrink_size(context, cur_size, size_needed);
+            }
+            template <class GrowthPolicy, class Context>
+            auto shrink_size_impl(short, const Context& context, size_type cur_size,
+                                  size_type size_needed) noexcept
+                -> decltype(GrowthPolicy::shrink_size(cur_size, size_needed, context.max_size()))
+            {
+                return GrowthPolicy::shrink_size(cur_size, size_needed, context.max_size());
+            }
+        } // namespace detail
+
+        /// \returns The result of `GrowthPolicy::growth_size()`.
+        /// \notes This calls the overload taking an [array::growth_context]() if there is one,
+        /// otherwise the one taking only the sizes.
+        template <class GrowthPolicy, class Context>
+        size_type grow_block_size(const Context& context, size_type cur_size,
+                                  size_type additional_needed) noexcept
+        {
+            return detail::growth_size_impl<GrowthPolicy>(0, context, cur_size, additional_needed);
+        }
+
+        /// \returns The result of `GrowthPolicy::shrink_size()`.
+        /// \notes This calls the overload taking an [array::growth_context]() if there is one,
+        /// otherwise the one taking only the sizes.
+        template <class GrowthPolicy, class Context>
+        size_type shrink_block_size(const Context& context, size_type cur_size,
+                                    size_type size_needed) noexcept
+        {
+            return detail::shrink_size_impl<GrowthPolicy>(0, context, cur_size, size_needed);
+        }
+
+        namespace detail
+        {
+            // rounds new_size down to a multiple of the element size, but not below needed
+            inline size_type round_to_elements(size_type element_size, size_type needed,
+                                               size_type new_size) noexcept
+            {
+                if (element_size <= 1u)
+                    return new_size;
+
+                auto rounded = new_size - new_size % element_size;
+                return rounded < needed ? needed : rounded;
+            }
+        } // namespace detail
+
+        //=== decaying_growth ===//
+        /// The runtime configuration of [array::decaying_growth]().
+        struct decaying_growth_config
+        {
+            /// Blocks smaller than that many bytes grow by `small_factor`.
+            size_type small_limit = size_type(1) << 20;
+            /// Blocks smaller than that many bytes (but not smaller than `small_limit`) grow by `medium_factor`.
+            size_type medium_limit = size_type(64) << 20;
+            /// Bigger blocks grow by that many bytes.
+            size_type chunk_size = size_type(16) << 20;
+
+            double small_factor  = 2.0;
+            double medium_factor = 1.5;
+        };
+
+        /// A growth policy where the growth factor decays as the block gets bigger.
+        ///
+        /// Small blocks grow fast to avoid many reallocations,
+        /// big blocks grow slowly to avoid wasting memory,
+        /// and huge blocks only grow by a fixed amount.
+        /// The thresholds are configured at runtime using the [array::decaying_growth_config]()
+        /// passed as part of the block storage arguments.
+        /// \notes The new size is always a multiple of the element size, if possible.
+        struct decaying_growth
+        {
+            using config_type = decaying_growth_config;
+
+            /// \returns The current size grown according to the configuration,
+            /// or the current size plus the additional one, whatever is larger.
+            template <class Context>
+            static size_type growth_size(const Context& context, size_type cur_size,
+                                         size_type additional_needed) noexcept
+            {
+                auto& config = context.config();
+                auto  needed = cur_size + additional_needed;
+
+                size_type grown;
+                if (cur_size < config.small_limit)
+                    grown = size_type(config.small_factor * double(cur_size));
+                else if (cur_size < config.medium_limit)
+                    grown = size_type(config.medium_factor * double(cur_size));
+                else
+                    grown = cur_size + config.chunk_size;
+
+                if (grown > context.max_size())
+                    grown = context.max_size();
+                if (grown <= needed)
+                    return needed;
+                return detail::round_to_elements(context.element_size(), needed, grown);
+            }
+
+            /// \returns `size_needed`, i.e. shrink to the minimum.
+            template <class Context>
+            static size_type shrink_size(const Context&, size_type cur_size,
+                                         size_type size_needed) noexcept
+            {
+                (void)cur_size;
+                return size_needed;
+            }
+        };
+
+        //=== size_class_growth ===//
+        /// \returns The smallest size class that is at least `size`.
+        ///
+        /// Sizes smaller than `page_size` are rounded to one of four classes per power of two,
+        /// like `malloc()` implementations do.
+        /// Bigger sizes are rounded to a multiple of `page_size`.
+        /// If the rounded size would overflow, returns `size` unchanged.
+        /// \requires `page_size` must be a power of two.
+        inline size_type round_to_size_class(size_type size, size_type page_size = 4096u) noexcept
+        {
+            size_type granularity;
+            if (size <= 16u)
+                return size == 0u ? 0u : 16u;
+            else if (size >= page_size)
+                granularity = page_size;
+            else
+            {
+                // granularity is a quarter of the biggest power of two below size
+                auto power = size_type(1);
+                while (power <= (size - 1u) / 2u)
+                    power *= 2u;
+                granularity = power / 4u < 16u ? 16u : power / 4u;
+            }
+
+            auto remainder = size % granularity;
+            if (remainder == 0u)
+                return size;
+            else if (size > memory_block::max_size() - (granularity - remainder))
+                return size;
+            else
+                return size + (granularity - remainder);
+        }
+
+        /// A growth policy that uses the given `GrowthPolicy` and rounds the result up to a size class.
+        ///
+        /// Allocators hand out memory in size classes anyway,
+        /// rounding the request up makes the slack usable instead of wasting it.
+        /// See [array::round_to_size_class]() for the rounding,
+        /// the result is then rounded further by the `good_size()` of the context.
+        /// \notes It forwards the runtime configuration of `GrowthPolicy`.
+        template <class GrowthPolicy = default_growth, size_type PageSize = 4096u>
+        struct size_class_growth
+        {
+            static_assert(PageSize != 0u && (PageSize & (PageSize - 1u)) == 0u,
+                          "page size must be a power of two");
+
+            using config_type = growth_policy_config<GrowthPolicy>;
+
+            /// \returns The result of `GrowthPolicy` rounded up to the next size class.
+            template <class Context>
+            static size_type growth_size(const Context& context, size_type cur_size,
+                                         size_type additional_needed) noexcept
+            {
+                auto size = grow_block_size<GrowthPolicy>(context, cur_size, additional_needed);
+                return round(context, size);
+            }
+
+            /// \returns The result of `GrowthPolicy` rounded up to the next size class.
+            template <class Context>
+            static size_type shrink_size(const Context& context, size_type cur_size,
+                                         size_type size_needed) noexcept
+            {
+                auto size = shrink_block_size<GrowthPolicy>(context, cur_size, size_needed);
+                return round(context, size);
+            }
+
+        private:
+            template <class Context>
+            static size_type round(const Context& context, size_type size) noexcept
+            {
+                auto rounded = context.good_size(round_to_size_class(size, PageSize));
+                return rounded > context.max_size() ? size : rounded;
+            }
+        };
+
+        /// A growth policy that uses the given `GrowthPolicy` but only shrinks if it frees enough memory.
+        ///
+        /// `shrink_size()` keeps the current size,
+        /// unless the new size would free more than `Num / Den` of the current size.
+        /// \notes It forwards the runtime configuration of `GrowthPolicy`.
+        template <class GrowthPolicy = default_growth, size_type Num = 1u, size_type Den = 4u>
+        struct shrink_hysteresis
+        {
+            static_assert(Den != 0u && Num <= Den, "invalid fraction");
+
+            using config_type = growth_policy_config<GrowthPolicy>;
+
+            /// \returns The result of `GrowthPolicy`.
+            template <class Context>
+            static size_type growth_size(const Context& context, size_type cur_size,
+                                         size_type additional_needed) noexcept
+            {
+                return grow_block_size<GrowthPolicy>(context, cur_size, additional_needed);
+            }
+
+            /// \returns The result of `GrowthPolicy`,
+            /// or `cur_size` if that would not free enough memory.
+            template <class Context>
+            static size_type shrink_size(const Context& context, size_type cur_size,
+                                         size_type size_needed) noexcept
+            {
+                auto size = shrink_block_size<GrowthPolicy>(context, cur_size, size_needed);
+                if (size_needed == 0u || size >= cur_size || cur_size < size_needed)
+                    return size;
+
+                auto freed = cur_size - size;
+                // freed / cur_size > Num / Den, without overflow
+                auto threshold = cur_size / Den * Num + cur_size % Den * Num / Den;
+                return freed > threshold ? size : cur_size;
+            }
+        };
     } // namespace array
 } // namespace foonathan
 
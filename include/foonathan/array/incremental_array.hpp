@@ -0,0 +1,595 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_INCREMENTAL_ARRAY_HPP_INCLUDED
+#define FOONATHAN_ARRAY_INCREMENTAL_ARRAY_HPP_INCLUDED
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <type_traits>
+
+#include <foonathan/array/array_view.hpp>
+#include <foonathan/array/block_storage.hpp>
+#include <foonathan/array/block_storage_new.hpp>
+
+namespace foonathan
+{
+    namespace array
+    {
+        namespace detail
+        {
+            template <typename T>
+            class incremental_array_iterator
+            {
+            public:
+                struct private_key
+                {
+                    explicit private_key() {}
+                };
+
+                using iterator_category = std::random_access_iterator_tag;
+                using value_type        = typename std::remove_const<T>::type;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = T*;
+                using reference         = T&;
+
+                incremental_array_iterator() noexcept
+                : data_(nullptr), old_data_(nullptr), migrated_(0u), old_size_(0u), index_(0u)
+                {
+                }
+
+                explicit incremental_array_iterator(private_key, T* data, T* old_data,
+                                                    size_type migrated, size_type old_size,
+                                                    size_type index) noexcept
+                : data_(data),
+                  old_data_(old_data),
+                  migrated_(migrated),
+                  old_size_(old_size),
+                  index_(index)
+                {
+                }
+
+                template <typename NonConst,
+                          typename = typename std::enable_if<
+                              std::is_const<T>::value
+                              && std::is_same<NonConst, value_type>::value>::type>
+                incremental_array_iterator(
+                    const incremental_array_iterator<NonConst>& non_const) noexcept
+                : data_(non_const.data_),
+                  old_data_(non_const.old_data_),
+                  migrated_(non_const.migrated_),
+                  old_size_(non_const.old_size_),
+                  index_(non_const.index_)
+                {
+                }
+
+                //=== access ===//
+                reference operator*() const noexcept
+                {
+                    return (*this)[0];
+                }
+
+                pointer operator->() const noexcept
+                {
+                    return &**this;
+                }
+
+                reference operator[](difference_type offset) const noexcept
+                {
+                    auto index = size_type(difference_type(index_) + offset);
+                    return index < migrated_ || index >= old_size_ ? data_[index] :
+                                                                     old_data_[index];
+                }
+
+                size_type get_index(private_key) const noexcept
+                {
+                    return index_;
+                }
+
+                //=== increment/decrement ===//
+                incremental_array_iterator& operator++() noexcept
+                {
+                    ++index_;
+                    return *this;
+                }
+                incremental_array_iterator operator++(int) noexcept
+                {
+                    auto save = *this;
+                    ++*this;
+                    return save;
+                }
+
+                incremental_array_iterator& operator--() noexcept
+                {
+                    --index_;
+                    return *this;
+                }
+                incremental_array_iterator operator--(int) noexcept
+                {
+                    auto save = *this;
+                    --*this;
+                    return save;
+                }
+
+                incremental_array_iterator& operator+=(difference_type offset) noexcept
+                {
+                    index_ = size_type(difference_type(index_) + offset);
+                    return *this;
+                }
+                incremental_array_iterator& operator-=(difference_type offset) noexcept
+                {
+                    return *this += -offset;
+                }
+
+                //=== addition/subtraction ===//
+                friend incremental_array_iterator operator+(incremental_array_iterator iter,
+                                                            difference_type offset) noexcept
+                {
+                    return iter += offset;
+                }
+                friend incremental_array_iterator operator+(
+                    difference_type offset, incremental_array_iterator iter) noexcept
+                {
+                    return iter += offset;
+                }
+
+                friend incremental_array_iterator operator-(incremental_array_iterator iter,
+                                                            difference_type offset) noexcept
+                {
+                    return iter -= offset;
+                }
+
+                friend difference_type operator-(incremental_array_iterator lhs,
+                                                 incremental_array_iterator rhs) noexcept
+                {
+                    return difference_type(lhs.index_) - difference_type(rhs.index_);
+                }
+
+                //=== comparison ===//
+                friend bool operator==(incremental_array_iterator lhs,
+                                       incremental_array_iterator rhs) noexcept
+                {
+                    return lhs.index_ == rhs.index_;
+                }
+                friend bool operator!=(incremental_array_iterator lhs,
+                                       incremental_array_iterator rhs) noexcept
+                {
+                    return lhs.index_ != rhs.index_;
+                }
+
+                friend bool operator<(incremental_array_iterator lhs,
+                                      incremental_array_iterator rhs) noexcept
+                {
+                    return lhs.index_ < rhs.index_;
+                }
+                friend bool operator>(incremental_array_iterator lhs,
+                                      incremental_array_iterator rhs) noexcept
+                {
+                    return lhs.index_ > rhs.index_;
+                }
+                friend bool operator<=(incremental_array_iterator lhs,
+                                       incremental_array_iterator rhs) noexcept
+                {
+                    return lhs.index_ <= rhs.index_;
+                }
+                friend bool operator>=(incremental_array_iterator lhs,
+                                       incremental_array_iterator rhs) noexcept
+                {
+                    return lhs.index_ >= rhs.index_;
+                }
+
+            private:
+                T*        data_;
+                T*        old_data_;
+                size_type migrated_, old_size_, index_;
+
+                template <typename>
+                friend class incremental_array_iterator;
+            };
+
+            // the minimal number of elements moved by one migration step
+            constexpr size_type incremental_array_min_step = 16u;
+        } // namespace detail
+
+        /// A dynamic array that grows without moving all elements at once.
+        ///
+        /// When an [array::array]() runs out of capacity, the next `push_back()` moves every element into the new memory block,
+        /// so its worst case latency is linear in the size.
+        /// When an incremental array runs out of capacity, it allocates a memory block that is at least twice as big,
+        /// but keeps the elements in the old one.
+        /// Each following `emplace_back()` -- or an explicit call to `step()` -- then moves a bounded slice of them over,
+        /// until the old block is empty and released.
+        /// The slice is big enough that the migration is done before the new block is full,
+        /// so a push back never has to move more than a slice and the amortized cost stays the same.
+        ///
+        /// While it is migrating, the elements are not contiguous and indexing has an additional branch.
+        /// Call `make_contiguous()` to finish the migration and get an [array::array_view]() to all elements.
+        /// \notes Any modification, including `step()`, invalidates all iterators.
+        /// \notes Like with [array::array](), the arguments to `emplace_back()` must not refer to elements of the array.
+        template <typename T, class BlockStorage = block_storage_default>
+        class incremental_array
+        {
+            // swapping finishes the migration, so the elements must be nothrow movable as well
+            using nothrow_move =
+                std::integral_constant<bool, block_storage_nothrow_move<BlockStorage, T>::value
+                                                 && std::is_nothrow_move_constructible<T>::value>;
+
+        public:
+            using value_type    = T;
+            using block_storage = BlockStorage;
+
+            using iterator       = detail::incremental_array_iterator<T>;
+            using const_iterator = detail::incremental_array_iterator<const T>;
+
+            //=== constructors/destructors ===//
+            /// Default constructor.
+            /// \effects Creates an array without any elements.
+            /// The block storage is initialized with default constructed arguments.
+            incremental_array() : incremental_array(typename block_storage::arg_type{}) {}
+
+            /// \effects Creates an array without any elements.
+            /// The block storage is initialized with the given arguments.
+            explicit incremental_array(typename block_storage::arg_type args) noexcept
+            : storage_(args),
+              old_storage_(std::move(args)),
+              size_(0u),
+              migrated_(0u),
+              old_size_(0u),
+              step_size_(0u)
+            {
+            }
+
+            /// Copy constructor.
+            incremental_array(const incremental_array& other)
+            : incremental_array(other.storage_.arguments())
+            {
+                reserve(other.size());
+                for (auto& element : other)
+                    emplace_back(element);
+            }
+
+            /// Move constructor.
+            incremental_array(incremental_array&& other) noexcept(nothrow_move::value)
+            : incremental_array(other.storage_.arguments())
+            {
+                swap(*this, other);
+            }
+
+            /// Destructor.
+            ~incremental_array() noexcept
+            {
+                destroy_all();
+            }
+
+            /// Copy assignment operator.
+            /// \notes Like the copy assignment of [array::array](), it propagates the arguments of the block storage.
+            incremental_array& operator=(const incremental_array& other)
+            {
+                incremental_array copy(other);
+                swap(*this, copy);
+                return *this;
+            }
+
+            /// Move assignment operator.
+            incremental_array& operator=(incremental_array&& other) noexcept(nothrow_move::value)
+            {
+                auto new_view =
+                    move_assign(storage_, block_view<T>(make_contiguous()),
+                                std::move(other.storage_), block_view<T>(other.make_contiguous()));
+                size_       = new_view.size();
+                other.size_ = 0u;
+                return *this;
+            }
+
+            /// Swap.
+            /// \notes This finishes the migration of both arrays.
+            friend void swap(incremental_array& lhs,
+                             incremental_array& rhs) noexcept(nothrow_move::value)
+            {
+                auto lhs_view = block_view<T>(lhs.make_contiguous());
+                auto rhs_view = block_view<T>(rhs.make_contiguous());
+                BlockStorage::swap(lhs.storage_, lhs_view, rhs.storage_, rhs_view);
+                lhs.size_ = lhs_view.size();
+                rhs.size_ = rhs_view.size();
+            }
+
+            //=== access ===//
+            iterator begin() noexcept
+            {
+                return make_iterator<iterator>(0u);
+            }
+            const_iterator begin() const noexcept
+            {
+                return cbegin();
+            }
+            const_iterator cbegin() const noexcept
+            {
+                return make_iterator<const_iterator>(0u);
+            }
+
+            iterator end() noexcept
+            {
+                return make_iterator<iterator>(size());
+            }
+            const_iterator end() const noexcept
+            {
+                return cend();
+            }
+            const_iterator cend() const noexcept
+            {
+                return make_iterator<const_iterator>(size());
+            }
+
+            T& operator[](size_type i) noexcept
+            {
+                assert(i < size());
+                return element(i);
+            }
+            const T& operator[](size_type i) const noexcept
+            {
+                assert(i < size());
+                return element(i);
+            }
+
+            T& front() noexcept
+            {
+                return (*this)[0u];
+            }
+            const T& front() const noexcept
+            {
+                return (*this)[0u];
+            }
+
+            T& back() noexcept
+            {
+                return (*this)[size() - 1u];
+            }
+            const T& back() const noexcept
+            {
+                return (*this)[size() - 1u];
+            }
+
+            /// \effects Finishes the migration, so the elements are contiguous.
+            /// \returns A view to all elements.
+            array_view<T> make_contiguous() noexcept(std::is_nothrow_move_constructible<T>::value)
+            {
+                finish_migration();
+                return array_view<T>(data(), size());
+            }
+
+            //=== migration ===//
+            /// \returns Whether or not some elements are still in the old memory block.
+            bool is_migrating() const noexcept
+            {
+                return migrated_ != old_size_;
+            }
+
+            /// \returns The number of elements that are still in the old memory block.
+            size_type migration_remaining() const noexcept
+            {
+                return old_size_ - migrated_;
+            }
+
+            /// \effects If it is migrating, moves the next slice of elements into the new memory block,
+            /// and releases the old one if it is empty afterwards.
+            /// This is what `emplace_back()` does as well,
+            /// call it in idle time to finish the migration earlier.
+            /// \returns Whether or not it is still migrating afterwards.
+            /// \notes If a move constructor throws, the elements of the slice remain in the old memory block.
+            bool step() noexcept(std::is_nothrow_move_constructible<T>::value)
+            {
+                if (!is_migrating())
+                    return false;
+
+                auto count = std::min(step_size_, migration_remaining());
+                auto begin = old_data() + migrated_;
+                uninitialized_destructive_move(begin, begin + count,
+                                               memory_block(to_raw_pointer(data() + migrated_),
+                                                            count * sizeof(T)));
+                migrated_ += count;
+
+                if (!is_migrating())
+                    release_old();
+                return is_migrating();
+            }
+
+            /// \effects Moves all remaining elements into the new memory block and releases the old one.
+            void finish_migration() noexcept(std::is_nothrow_move_constructible<T>::value)
+            {
+                while (step())
+                {
+                }
+            }
+
+            //=== capacity ===//
+            /// \returns Whether or not the array is empty.
+            bool empty() const noexcept
+            {
+                return size_ == 0u;
+            }
+
+            /// \returns The number of elements in the array.
+            size_type size() const noexcept
+            {
+                return size_;
+            }
+
+            /// \returns The number of elements the array can contain without allocating new memory.
+            /// \notes This is the capacity of the new memory block while migrating.
+            size_type capacity() const noexcept
+            {
+                return storage_.block().size() / sizeof(T);
+            }
+
+            /// \returns The maximum number of elements as determined by the block storage.
+            size_type max_size() const noexcept
+            {
+                return BlockStorage::max_size(storage_.arguments()) / sizeof(T);
+            }
+
+            /// \effects Reserves new memory to make capacity as least as big as `new_capacity` if that isn't the case already.
+            /// \notes If it reserves new memory, it finishes the migration and then moves all elements at once.
+            void reserve(size_type new_capacity)
+            {
+                auto cur_cap_bytes = storage_.block().size();
+                auto new_cap_bytes = new_capacity * sizeof(T);
+                if (new_cap_bytes > cur_cap_bytes)
+                {
+                    auto constructed = block_view<T>(make_contiguous());
+                    storage_.reserve(new_cap_bytes - cur_cap_bytes, constructed);
+                }
+            }
+
+            /// \effects Non-binding request to make the capacity as small as necessary.
+            /// \notes This finishes the migration first.
+            void shrink_to_fit()
+            {
+                auto constructed = block_view<T>(make_contiguous());
+                storage_.shrink_to_fit(constructed);
+            }
+
+            //=== modifiers ===//
+            /// \effects Does one migration `step()`, then creates a new element at the end.
+            /// If there is no space left, it allocates a memory block that is at least twice as big
+            /// and starts migrating the elements into it.
+            /// \returns A reference to the newly constructed element.
+            /// \notes If it throws, the elements are unchanged.
+            template <typename... Args>
+            T& emplace_back(Args&&... args)
+            {
+                step();
+                if (size_ == capacity())
+                    grow();
+
+                auto ptr = construct_object<T>(to_raw_pointer(data() + size_),
+                                               std::forward<Args>(args)...);
+                ++size_;
+                return *ptr;
+            }
+
+            /// \effects Same as `emplace_back(element)`.
+            void push_back(const T& element)
+            {
+                emplace_back(element);
+            }
+
+            /// \effects Same as `emplace_back(std::move(element))`.
+            void push_back(T&& element)
+            {
+                emplace_back(std::move(element));
+            }
+
+            /// \effects Destroys all elements and releases the old memory block.
+            void clear() noexcept
+            {
+                destroy_all();
+                release_old();
+                size_ = 0u;
+            }
+
+            /// \effects Destroys the last element.
+            /// If that was the last element in the old memory block, it is released.
+            void pop_back() noexcept
+            {
+                assert(!empty());
+                --size_;
+                if (size_ < old_size_)
+                {
+                    // the old memory block contains the elements up to the end
+                    destroy_object(old_data() + size_);
+                    old_size_ = size_;
+                    if (!is_migrating())
+                        release_old();
+                }
+                else
+                    destroy_object(data() + size_);
+            }
+
+        private:
+            T* data() const noexcept
+            {
+                return to_pointer<T>(storage_.block().begin());
+            }
+
+            T* old_data() const noexcept
+            {
+                return to_pointer<T>(old_storage_.block().begin());
+            }
+
+            T& element(size_type i) const noexcept
+            {
+                return i < migrated_ || i >= old_size_ ? data()[i] : old_data()[i];
+            }
+
+            // the member function empty() hides the tag
+            static block_view<T> no_elements(const BlockStorage& storage) noexcept
+            {
+                return block_view<T>(foonathan::array::empty, storage.block().begin());
+            }
+
+            template <class Iterator>
+            Iterator make_iterator(size_type index) const noexcept
+            {
+                return Iterator(typename Iterator::private_key{}, data(), old_data(), migrated_,
+                                old_size_, index);
+            }
+
+            // puts the elements into the old storage and reserves a bigger new one
+            void grow()
+            {
+                assert(!is_migrating());
+                if (size_ < detail::incremental_array_min_step)
+                {
+                    // moving them all at once isn't worse than a step
+                    reserve(std::max(2u * capacity(), detail::incremental_array_min_step));
+                    return;
+                }
+
+                // allocate first, so nothing changes if it throws
+                BlockStorage new_storage(storage_.arguments());
+                new_storage.reserve(2u * storage_.block().size(), no_elements(new_storage));
+
+                // the old storage owns nothing, so this only exchanges the memory blocks,
+                // afterwards the new storage owns the block of the old one
+                auto constructed     = block_view<T>(data(), size_);
+                auto old_constructed = no_elements(old_storage_);
+                BlockStorage::swap(storage_, constructed, old_storage_, old_constructed);
+                auto empty_view = no_elements(storage_);
+                auto new_view   = no_elements(new_storage);
+                BlockStorage::swap(storage_, empty_view, new_storage, new_view);
+                assert(old_constructed.data() == old_data());
+                assert(capacity() > size_);
+
+                migrated_ = 0u;
+                old_size_ = size_;
+                // finish before the remaining capacity is used up
+                auto free  = capacity() - size_;
+                step_size_ =
+                    std::max((size_ + free - 1u) / free, detail::incremental_array_min_step);
+            }
+
+            void destroy_all() noexcept
+            {
+                destroy_range(data(), data() + migrated_);
+                destroy_range(old_data() + migrated_, old_data() + old_size_);
+                destroy_range(data() + old_size_, data() + size_);
+            }
+
+            // the elements in the old storage must already be destroyed
+            void release_old() noexcept
+            {
+                clear_and_shrink(old_storage_, no_elements(old_storage_));
+                migrated_ = old_size_ = 0u;
+            }
+
+            BlockStorage storage_, old_storage_;
+            // the element at index i is in the old storage if i is in [migrated_, old_size_),
+            // and in the new storage at the same index otherwise
+            size_type size_, migrated_, old_size_, step_size_;
+        };
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_INCREMENTAL_ARRAY_HPP_INCLUDED
@@ -5,10 +5,13 @@
 #ifndef FOONATHAN_ARRAY_KEY_COMPARE_HPP_INCLUDED
 #define FOONATHAN_ARRAY_KEY_COMPARE_HPP_INCLUDED
 
+#include <cmath>
 #include <functional>
+#include <iterator>
 #include <type_traits>
 
 #include <foonathan/array/array_view.hpp>
+#include <foonathan/array/config.hpp>
 
 namespace foonathan
 {
@@ -121,6 +124,31 @@ namespace foonathan
             }
         };
 
+        /// A pair of two iterators.
+        template <typename Iter>
+        struct iter_pair
+        {
+            Iter first, second;
+
+            Iter begin() const noexcept
+            {
+                return first;
+            }
+
+            Iter end() const noexcept
+            {
+                return second;
+            }
+
+            bool empty() const noexcept
+            {
+                return first == second;
+            }
+        };
+
+        template <std::size_t Threshold = FOONATHAN_ARRAY_LINEAR_SEARCH_THRESHOLD>
+        struct adaptive_search;
+
         /// A lightweight view into a sorted array.
         ///
         /// This is an [array::array_view]() where the elements are sorted according to `Compare`.
@@ -134,6 +162,8 @@ namespace foonathan
         class sorted_view : public array_view<T>
         {
         public:
+            using iterator = typename array_view<T>::iterator;
+
             /// \effects Creates an empty view.
             constexpr sorted_view() noexcept = default;
 
@@ -196,6 +226,48 @@ namespace foonathan
             {
                 return this->back();
             }
+
+            //=== search ===//
+            /// \returns Same as [array::lower_bound]() for the given `key`,
+            /// but searched using the given `SearchPolicy`.
+            template <class SearchPolicy = adaptive_search<>, typename Key>
+            iterator lower_bound(const Key& key) const
+            {
+                return SearchPolicy::template lower_bound<Compare>(this->begin(), this->end(), key);
+            }
+
+            /// \returns Same as [array::upper_bound]() for the given `key`,
+            /// but searched using the given `SearchPolicy`.
+            template <class SearchPolicy = adaptive_search<>, typename Key>
+            iterator upper_bound(const Key& key) const
+            {
+                return SearchPolicy::template upper_bound<Compare>(this->begin(), this->end(), key);
+            }
+
+            /// \returns Same as [array::equal_range]() for the given `key`,
+            /// but searched using the given `SearchPolicy`.
+            template <class SearchPolicy = adaptive_search<>, typename Key>
+            iter_pair<iterator> equal_range(const Key& key) const
+            {
+                return SearchPolicy::template equal_range<Compare>(this->begin(), this->end(), key);
+            }
+
+            /// \returns Whether or not an element equivalent to the key is in the view,
+            /// searched using the given `SearchPolicy`.
+            template <class SearchPolicy = adaptive_search<>, typename Key>
+            bool contains(const Key& key) const
+            {
+                auto iter = lower_bound<SearchPolicy>(key);
+                return iter != this->end() && Compare::compare(*iter, key) == key_ordering::equivalent;
+            }
+
+            /// \returns Same as [array::lower_bound_hint]() for the given `hint` and `key`.
+            template <typename Key>
+            iterator lower_bound(iterator hint, const Key& key) const;
+
+            /// \returns Same as [array::upper_bound_hint]() for the given `hint` and `key`.
+            template <typename Key>
+            iterator upper_bound(iterator hint, const Key& key) const;
         };
 
         /// \returns The sorted view viewing the given block.
@@ -271,28 +343,6 @@ namespace foonathan
             return begin;
         }
 
-        /// A pair of two iterators.
-        template <typename Iter>
-        struct iter_pair
-        {
-            Iter first, second;
-
-            Iter begin() const noexcept
-            {
-                return first;
-            }
-
-            Iter end() const noexcept
-            {
-                return second;
-            }
-
-            bool empty() const noexcept
-            {
-                return first == second;
-            }
-        };
-
         /// \returns A pair of two iterators where the first one is the result of [array::lower_bound]()
         /// and the second one the result of [array::upper_bound]().
         /// \requires The sequence is sorted according to the key comparison.
@@ -325,6 +375,510 @@ namespace foonathan
             }
             return {begin, end};
         }
+
+        //=== search policies ===//
+        /// A `SearchPolicy` that uses binary search, i.e. [array::lower_bound](), [array::upper_bound]() and [array::equal_range]().
+        ///
+        /// A `SearchPolicy` provides those three functions as `static` member functions with the same signature.
+        /// It is used by [array::flat_set]() and [array::flat_map]() to search the sorted keys.
+        /// A `SearchPolicy` can also provide a nested `index<Key, BlockStorage>` template instead,
+        /// then the containers store an index of the keys they keep in sync, see [array::prefix_search]().
+        struct binary_search
+        {
+            template <class Compare, typename ForwardIt, typename Key>
+            static ForwardIt lower_bound(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                return foonathan::array::lower_bound<Compare>(begin, end, key);
+            }
+
+            template <class Compare, typename ForwardIt, typename Key>
+            static ForwardIt upper_bound(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                return foonathan::array::upper_bound<Compare>(begin, end, key);
+            }
+
+            template <class Compare, typename ForwardIt, typename Key>
+            static iter_pair<ForwardIt> equal_range(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                return foonathan::array::equal_range<Compare>(begin, end, key);
+            }
+        };
+
+        /// A `SearchPolicy` that uses a linear scan.
+        ///
+        /// It compares the elements in order and stops at the first one not sorted before the key.
+        /// For small ranges this is faster than binary search,
+        /// as the memory is accessed sequentially and there are fewer dependent comparisons.
+        struct linear_search
+        {
+            template <class Compare, typename ForwardIt, typename Key>
+            static ForwardIt lower_bound(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                while (begin != end && Compare::compare(*begin, key) == key_ordering::less)
+                    ++begin;
+                return begin;
+            }
+
+            template <class Compare, typename ForwardIt, typename Key>
+            static ForwardIt upper_bound(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                while (begin != end && Compare::compare(*begin, key) != key_ordering::greater)
+                    ++begin;
+                return begin;
+            }
+
+            template <class Compare, typename ForwardIt, typename Key>
+            static iter_pair<ForwardIt> equal_range(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                auto lower = lower_bound<Compare>(begin, end, key);
+                auto upper = lower;
+                while (upper != end && Compare::compare(*upper, key) == key_ordering::equivalent)
+                    ++upper;
+                return {lower, upper};
+            }
+        };
+
+        /// A `SearchPolicy` that uses [array::linear_search]() if there are at most `Threshold` elements,
+        /// and [array::binary_search]() otherwise.
+        ///
+        /// The default threshold is given by the `FOONATHAN_ARRAY_LINEAR_SEARCH_THRESHOLD` macro.
+        template <std::size_t Threshold>
+        struct adaptive_search
+        {
+            static constexpr std::size_t threshold = Threshold;
+
+            template <class Compare, typename ForwardIt, typename Key>
+            static ForwardIt lower_bound(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                if (is_small(begin, end))
+                    return linear_search::lower_bound<Compare>(begin, end, key);
+                else
+                    return binary_search::lower_bound<Compare>(begin, end, key);
+            }
+
+            template <class Compare, typename ForwardIt, typename Key>
+            static ForwardIt upper_bound(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                if (is_small(begin, end))
+                    return linear_search::upper_bound<Compare>(begin, end, key);
+                else
+                    return binary_search::upper_bound<Compare>(begin, end, key);
+            }
+
+            template <class Compare, typename ForwardIt, typename Key>
+            static iter_pair<ForwardIt> equal_range(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                if (is_small(begin, end))
+                    return linear_search::equal_range<Compare>(begin, end, key);
+                else
+                    return binary_search::equal_range<Compare>(begin, end, key);
+            }
+
+        private:
+            template <typename ForwardIt>
+            static bool is_small(ForwardIt begin, ForwardIt end) noexcept
+            {
+                return std::size_t(std::distance(begin, end)) <= Threshold;
+            }
+        };
+
+        template <std::size_t Threshold>
+        constexpr std::size_t adaptive_search<Threshold>::threshold;
+
+        namespace detail
+        {
+            template <typename Iter>
+            using is_random_access = std::is_base_of<
+                std::random_access_iterator_tag,
+                typename std::iterator_traits<Iter>::iterator_category>;
+
+            // whether the element is before the result of lower_bound() or upper_bound()
+            template <class Compare, bool Upper, typename T, typename Key>
+            bool search_is_before(const T& element, const Key& key)
+            {
+                auto ordering = Compare::compare(element, key);
+                return Upper ? ordering != key_ordering::greater : ordering == key_ordering::less;
+            }
+
+            // returns the first element where search_is_before() is false using the policy
+            template <class SearchPolicy, class Compare, bool Upper, typename ForwardIt,
+                      typename Key>
+            ForwardIt search_bound(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                return Upper ? SearchPolicy::template upper_bound<Compare>(begin, end, key)
+                             : SearchPolicy::template lower_bound<Compare>(begin, end, key);
+            }
+
+            //=== interpolation search ===//
+            template <typename RandomAccessIt, typename Key>
+            using can_interpolate = std::integral_constant<
+                bool, is_random_access<RandomAccessIt>::value
+                          && std::is_arithmetic<
+                                 typename std::iterator_traits<RandomAccessIt>::value_type>::value
+                          && std::is_arithmetic<Key>::value>;
+
+            // the offset of the key in [begin, end) if the keys are evenly distributed
+            template <typename RandomAccessIt, typename Key>
+            std::ptrdiff_t interpolate(RandomAccessIt begin, RandomAccessIt end,
+                                       const Key& key) noexcept
+            {
+                auto first = double(*begin);
+                auto last  = double(end[-1]);
+                if (!(first < last))
+                    return 0;
+
+                auto fraction = (double(key) - first) / (last - first);
+                fraction      = fraction > 0. ? (fraction < 1. ? fraction : 1.) : 0.; // also handles NaN
+                return std::ptrdiff_t(fraction * double(end - begin - 1));
+            }
+
+            template <class Fallback, class Compare, bool Upper, typename RandomAccessIt,
+                      typename Key>
+            RandomAccessIt interpolation_search(std::true_type, RandomAccessIt begin,
+                                                RandomAccessIt end, const Key& key)
+            {
+                // each round probes the interpolated position,
+                // and a second position a guard distance towards the key,
+                // so evenly distributed keys shrink the range to its square root
+                // if the key is outside the guard distance twice, the keys aren't evenly distributed,
+                // and the remaining range is searched using the fallback
+                for (auto misses = 0; misses != 2 && end - begin > 16;)
+                {
+                    auto guard = std::ptrdiff_t(std::sqrt(double(end - begin)));
+                    auto probe = begin + interpolate(begin, end, key);
+                    if (search_is_before<Compare, Upper>(*probe, key))
+                    {
+                        begin      = probe + 1;
+                        auto guess = end - begin > guard ? begin + guard : end - 1;
+                        if (search_is_before<Compare, Upper>(*guess, key))
+                            begin = guess + 1;
+                        else
+                            end = guess;
+                    }
+                    else
+                    {
+                        end        = probe;
+                        auto guess = end - begin > guard ? end - guard : begin;
+                        if (search_is_before<Compare, Upper>(*guess, key))
+                            begin = guess + 1;
+                        else
+                            end = guess;
+                    }
+
+                    if (end - begin > guard)
+                        ++misses;
+                }
+
+                return search_bound<Fallback, Compare, Upper>(begin, end, key);
+            }
+
+            template <class Fallback, class Compare, bool Upper, typename ForwardIt,
+                      typename Key>
+            ForwardIt interpolation_search(std::false_type, ForwardIt begin, ForwardIt end,
+                                           const Key& key)
+            {
+                return search_bound<Fallback, Compare, Upper>(begin, end, key);
+            }
+
+            //=== branchless search ===//
+            template <class Compare, bool Upper, typename RandomAccessIt, typename Key>
+            RandomAccessIt branchless_search(std::true_type, RandomAccessIt begin,
+                                             RandomAccessIt end, const Key& key)
+            {
+                auto length = end - begin;
+                if (length == 0)
+                    return begin;
+
+                // the result is always in [begin, begin + length],
+                // the conditional is just a conditional move, so there are no mispredictions
+                while (length > 1)
+                {
+                    auto half = length / 2;
+                    begin     = search_is_before<Compare, Upper>(begin[half], key) ? begin + half
+                                                                                   : begin;
+                    length -= half;
+                }
+                return search_is_before<Compare, Upper>(*begin, key) ? begin + 1 : begin;
+            }
+
+            template <class Compare, bool Upper, typename ForwardIt, typename Key>
+            ForwardIt branchless_search(std::false_type, ForwardIt begin, ForwardIt end,
+                                        const Key& key)
+            {
+                return search_bound<binary_search, Compare, Upper>(begin, end, key);
+            }
+
+            //=== exponential search ===//
+            // the result is in [begin, end] and expected close to the end
+            template <class Compare, bool Upper, typename BidirIt, typename Key>
+            BidirIt exponential_search_backward(BidirIt begin, BidirIt end, const Key& key)
+            {
+                // double the distance to the end until an element is before the key
+                auto step = std::ptrdiff_t(1);
+                for (auto length = std::distance(begin, end); length > step;
+                     length -= step, step *= 2)
+                {
+                    auto probe = std::prev(end, step);
+                    if (search_is_before<Compare, Upper>(*probe, key))
+                        return search_bound<binary_search, Compare, Upper>(std::next(probe), end,
+                                                                           key);
+                    end = probe;
+                }
+                return search_bound<binary_search, Compare, Upper>(begin, end, key);
+            }
+
+            // the result is in [begin, end] and expected close to the begin
+            template <class Compare, bool Upper, typename ForwardIt, typename Key>
+            ForwardIt exponential_search_forward(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                // double the distance to the begin until an element isn't before the key
+                auto step = std::ptrdiff_t(1);
+                for (auto length = std::distance(begin, end); length > step; step *= 2)
+                {
+                    auto probe = std::next(begin, step - 1);
+                    if (!search_is_before<Compare, Upper>(*probe, key))
+                        return search_bound<binary_search, Compare, Upper>(begin, probe, key);
+                    begin = std::next(probe);
+                    length -= step;
+                }
+                return search_bound<binary_search, Compare, Upper>(begin, end, key);
+            }
+
+            // the result is close to the hint
+            template <class Compare, bool Upper, typename BidirIt, typename Key>
+            BidirIt hinted_search(BidirIt begin, BidirIt end, BidirIt hint, const Key& key)
+            {
+                if (hint == end || !search_is_before<Compare, Upper>(*hint, key))
+                    return exponential_search_backward<Compare, Upper>(begin, hint, key);
+                else
+                    return exponential_search_forward<Compare, Upper>(std::next(hint), end, key);
+            }
+        } // namespace detail
+
+        /// A `SearchPolicy` that uses interpolation search for arithmetic keys.
+        ///
+        /// Instead of the middle, it looks at the position where the key would be if the keys were evenly distributed
+        /// between the first and the last one.
+        /// For evenly distributed keys, like timestamps or ids, this needs about `log log n` instead of `log n` comparisons.
+        /// If the interpolated positions are off too far, the remaining range is searched using `Fallback`,
+        /// so other distributions are still searched in `O(log n)`.
+        ///
+        /// \notes It is only used if the iterators are random access and both the element and the key are arithmetic types,
+        /// otherwise it always uses `Fallback`.
+        /// The comparison must order them by their value, which is the case for [array::key_compare_default]().
+        template <class Fallback = binary_search>
+        struct interpolation_search
+        {
+            template <class Compare, typename ForwardIt, typename Key>
+            static ForwardIt lower_bound(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                return detail::interpolation_search<Fallback, Compare, false>(
+                    detail::can_interpolate<ForwardIt, Key>{}, begin, end, key);
+            }
+
+            template <class Compare, typename ForwardIt, typename Key>
+            static ForwardIt upper_bound(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                return detail::interpolation_search<Fallback, Compare, true>(
+                    detail::can_interpolate<ForwardIt, Key>{}, begin, end, key);
+            }
+
+            template <class Compare, typename ForwardIt, typename Key>
+            static iter_pair<ForwardIt> equal_range(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                auto lower = lower_bound<Compare>(begin, end, key);
+                return {lower, upper_bound<Compare>(lower, end, key)};
+            }
+        };
+
+        /// A `SearchPolicy` that uses a binary search without branches.
+        ///
+        /// It always halves the range, and the decision which half to take is compiled to a conditional move.
+        /// This avoids branch mispredictions, which is faster for cheap comparisons,
+        /// especially if the range fits into the cache.
+        ///
+        /// \notes It is only used for random access iterators, otherwise it uses [array::binary_search]().
+        struct branchless_search
+        {
+            template <class Compare, typename ForwardIt, typename Key>
+            static ForwardIt lower_bound(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                return detail::branchless_search<Compare, false>(
+                    detail::is_random_access<ForwardIt>{}, begin, end, key);
+            }
+
+            template <class Compare, typename ForwardIt, typename Key>
+            static ForwardIt upper_bound(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                return detail::branchless_search<Compare, true>(
+                    detail::is_random_access<ForwardIt>{}, begin, end, key);
+            }
+
+            template <class Compare, typename ForwardIt, typename Key>
+            static iter_pair<ForwardIt> equal_range(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                return {lower_bound<Compare>(begin, end, key), upper_bound<Compare>(begin, end, key)};
+            }
+        };
+
+        /// A `SearchPolicy` that uses an exponential search starting at the end.
+        ///
+        /// It compares the elements `1, 2, 4, 8, ...` positions before the end,
+        /// until one is before the key, and then does a binary search in the remaining range.
+        /// If the keys searched for are close to the maximal key, e.g. because the keys are appended in increasing order
+        /// and recent keys are looked up, this needs `O(log d)` comparisons, where `d` is the distance to the end.
+        /// Otherwise it is about twice as slow as [array::binary_search]().
+        struct exponential_search
+        {
+            template <class Compare, typename BidirIt, typename Key>
+            static BidirIt lower_bound(BidirIt begin, BidirIt end, const Key& key)
+            {
+                return detail::exponential_search_backward<Compare, false>(begin, end, key);
+            }
+
+            template <class Compare, typename BidirIt, typename Key>
+            static BidirIt upper_bound(BidirIt begin, BidirIt end, const Key& key)
+            {
+                return detail::exponential_search_backward<Compare, true>(begin, end, key);
+            }
+
+            template <class Compare, typename BidirIt, typename Key>
+            static iter_pair<BidirIt> equal_range(BidirIt begin, BidirIt end, const Key& key)
+            {
+                auto upper = upper_bound<Compare>(begin, end, key);
+                return {lower_bound<Compare>(begin, upper, key), upper};
+            }
+        };
+
+        /// \returns Same as [array::lower_bound]() but it starts the search at the given hint.
+        /// It does an exponential search in the direction of the key and then a binary search,
+        /// so it needs `O(log d)` comparisons, where `d` is the distance between the hint and the result.
+        /// This is useful for looking up multiple keys in increasing order, passing the previous result as hint.
+        /// \requires The sequence is sorted according to the key comparison and the hint is in `[begin, end]`.
+        template <class Compare, typename BidirIt, typename Key>
+        BidirIt lower_bound_hint(BidirIt begin, BidirIt end, BidirIt hint, const Key& key)
+        {
+            return detail::hinted_search<Compare, false>(begin, end, hint, key);
+        }
+
+        /// \returns Same as [array::upper_bound]() but it starts the search at the given hint,
+        /// like [array::lower_bound_hint]().
+        /// \requires The sequence is sorted according to the key comparison and the hint is in `[begin, end]`.
+        template <class Compare, typename BidirIt, typename Key>
+        BidirIt upper_bound_hint(BidirIt begin, BidirIt end, BidirIt hint, const Key& key)
+        {
+            return detail::hinted_search<Compare, true>(begin, end, hint, key);
+        }
+
+        template <typename T, class Compare>
+        template <typename Key>
+        auto sorted_view<T, Compare>::lower_bound(iterator hint, const Key& key) const -> iterator
+        {
+            return lower_bound_hint<Compare>(this->begin(), this->end(), hint, key);
+        }
+
+        template <typename T, class Compare>
+        template <typename Key>
+        auto sorted_view<T, Compare>::upper_bound(iterator hint, const Key& key) const -> iterator
+        {
+            return upper_bound_hint<Compare>(this->begin(), this->end(), hint, key);
+        }
+
+        /// The default `SearchPolicy` of the containers.
+        ///
+        /// It uses [array::adaptive_search]() for arithmetic keys, where a short linear scan is cheap,
+        /// and [array::binary_search]() for all other keys, where each comparison can be expensive.
+        struct search_default
+        {
+            template <class Compare, typename ForwardIt, typename Key>
+            static ForwardIt lower_bound(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                return policy<ForwardIt>::template lower_bound<Compare>(begin, end, key);
+            }
+
+            template <class Compare, typename ForwardIt, typename Key>
+            static ForwardIt upper_bound(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                return policy<ForwardIt>::template upper_bound<Compare>(begin, end, key);
+            }
+
+            template <class Compare, typename ForwardIt, typename Key>
+            static iter_pair<ForwardIt> equal_range(ForwardIt begin, ForwardIt end, const Key& key)
+            {
+                return policy<ForwardIt>::template equal_range<Compare>(begin, end, key);
+            }
+
+        private:
+            template <typename ForwardIt>
+            using policy = typename std::conditional<
+                std::is_arithmetic<typename std::iterator_traits<ForwardIt>::value_type>::value,
+                adaptive_search<>, binary_search>::type;
+        };
+
+        namespace detail
+        {
+            // the index of a SearchPolicy without one,
+            // it has no state and forwards to the static functions
+            template <class SearchPolicy, class BlockStorage>
+            class stateless_search_index
+            {
+            public:
+                stateless_search_index() noexcept = default;
+
+                explicit stateless_search_index(const typename BlockStorage::arg_type&) noexcept {}
+
+                friend void swap(stateless_search_index&, stateless_search_index&) noexcept {}
+
+                //=== synchronization ===//
+                template <typename Key>
+                void insert(size_type, const Key&) noexcept
+                {
+                }
+
+                void erase_range(size_type, size_type) noexcept {}
+
+                void clear() noexcept {}
+
+                template <typename ForwardIt>
+                void assign(ForwardIt, ForwardIt) noexcept
+                {
+                }
+
+                void reserve(size_type) noexcept {}
+
+                void shrink_to_fit() noexcept {}
+
+                //=== search ===//
+                template <class Compare, typename ForwardIt, typename Key>
+                static ForwardIt lower_bound(ForwardIt begin, ForwardIt end, const Key& key)
+                {
+                    return SearchPolicy::template lower_bound<Compare>(begin, end, key);
+                }
+
+                template <class Compare, typename ForwardIt, typename Key>
+                static ForwardIt upper_bound(ForwardIt begin, ForwardIt end, const Key& key)
+                {
+                    return SearchPolicy::template upper_bound<Compare>(begin, end, key);
+                }
+
+                template <class Compare, typename ForwardIt, typename Key>
+                static iter_pair<ForwardIt> equal_range(ForwardIt begin, ForwardIt end,
+                                                        const Key& key)
+                {
+                    return SearchPolicy::template equal_range<Compare>(begin, end, key);
+                }
+            };
+
+            template <class SearchPolicy, typename Key, class BlockStorage>
+            auto get_search_index(int) -> typename SearchPolicy::template index<Key, BlockStorage>;
+
+            template <class SearchPolicy, typename Key, class BlockStorage>
+            auto get_search_index(short) -> stateless_search_index<SearchPolicy, BlockStorage>;
+
+            // the index a container stores for the SearchPolicy
+            template <class SearchPolicy, typename Key, class BlockStorage>
+            using search_index = decltype(get_search_index<SearchPolicy, Key, BlockStorage>(0));
+        } // namespace detail
     } // namespace array
 } // namespace foonathan
 
@@ -0,0 +1,66 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_KEY_HASH_HPP_INCLUDED
+#define FOONATHAN_ARRAY_KEY_HASH_HPP_INCLUDED
+
+#include <cstddef>
+#include <functional>
+
+namespace foonathan
+{
+    namespace array
+    {
+        /// The default hashing of keys.
+        ///
+        /// A `KeyHash` provides a `static std::size_t hash<Key>(const TransparentKey&)` function
+        /// and a `static bool equal(const Key&, const TransparentKey&)` function.
+        /// A transparent key that is equal to a key must have the same hash value.
+        struct key_hash_default
+        {
+            /// Helper struct to allow customization of the default hashing for specific keys.
+            ///
+            /// This is required because `key_hash_default` itself shouldn't be a template,
+            /// but it should still be possible to override the default hashing.
+            ///
+            /// A specialization for a user-defined type must give it the same interface as required by the `KeyHash` concept.
+            template <typename Key>
+            struct customize_for
+            {
+                /// The default default hash.
+                ///
+                /// It uses [std::hash]() of the `Key`,
+                /// so a transparent key is converted to the key first.
+                template <typename TransparentKey>
+                static std::size_t hash(const TransparentKey& key)
+                {
+                    return std::hash<Key>{}(key);
+                }
+
+                /// The default default equality, using `k == t`.
+                template <typename TransparentKey>
+                static auto equal(const Key& k, const TransparentKey& t) noexcept
+                    -> decltype(k == t)
+                {
+                    return k == t;
+                }
+            };
+
+            template <typename Key, typename TransparentKey>
+            static std::size_t hash(const TransparentKey& key)
+            {
+                return customize_for<Key>::hash(key);
+            }
+
+            template <typename Key, typename TransparentKey>
+            static auto equal(const Key& k, const TransparentKey& t) noexcept
+                -> decltype(customize_for<Key>::equal(k, t))
+            {
+                return customize_for<Key>::equal(k, t);
+            }
+        };
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_KEY_HASH_HPP_INCLUDED
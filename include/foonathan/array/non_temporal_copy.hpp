@@ -0,0 +1,69 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_NON_TEMPORAL_COPY_HPP_INCLUDED
+#define FOONATHAN_ARRAY_NON_TEMPORAL_COPY_HPP_INCLUDED
+
+#include <cstdint>
+#include <cstring>
+
+#include <foonathan/array/config.hpp>
+#include <foonathan/array/memory_block.hpp>
+
+#if FOONATHAN_ARRAY_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace foonathan
+{
+    namespace array
+    {
+        namespace detail
+        {
+            // std::memcpy() for non-overlapping memory that bypasses the cache for the destination,
+            // so copying a big block doesn't evict everything else
+            inline void non_temporal_copy_bytes(void* dest, const void* src,
+                                                size_type size) noexcept
+            {
+#if FOONATHAN_ARRAY_HAS_SSE2
+                auto dest_bytes = static_cast<char*>(dest);
+                auto src_bytes  = static_cast<const char*>(src);
+
+                // the streaming stores need an aligned destination
+                auto head = (16u - reinterpret_cast<std::uintptr_t>(dest_bytes) % 16u) % 16u;
+                if (head > size)
+                    head = size;
+                std::memcpy(dest_bytes, src_bytes, head);
+                dest_bytes += head;
+                src_bytes += head;
+                size -= head;
+
+                // one cache line at a time,
+                // the sequential reads don't need a software prefetch
+                for (; size >= 64u; size -= 64u, dest_bytes += 64u, src_bytes += 64u)
+                {
+                    auto src_vec  = reinterpret_cast<const __m128i*>(src_bytes);
+                    auto dest_vec = reinterpret_cast<__m128i*>(dest_bytes);
+                    auto a        = _mm_loadu_si128(src_vec);
+                    auto b        = _mm_loadu_si128(src_vec + 1);
+                    auto c        = _mm_loadu_si128(src_vec + 2);
+                    auto d        = _mm_loadu_si128(src_vec + 3);
+                    _mm_stream_si128(dest_vec, a);
+                    _mm_stream_si128(dest_vec + 1, b);
+                    _mm_stream_si128(dest_vec + 2, c);
+                    _mm_stream_si128(dest_vec + 3, d);
+                }
+                // streaming stores are weakly ordered
+                _mm_sfence();
+
+                std::memcpy(dest_bytes, src_bytes, size);
+#else
+                std::memcpy(dest, src, size);
+#endif
+            }
+        } // namespace detail
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_NON_TEMPORAL_COPY_HPP_INCLUDED
@@ -0,0 +1,223 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_PARALLEL_COPY_HPP_INCLUDED
+#define FOONATHAN_ARRAY_PARALLEL_COPY_HPP_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <foonathan/array/memory_block.hpp>
+
+namespace foonathan
+{
+    namespace array
+    {
+        namespace detail
+        {
+            // a fixed set of threads that help the calling thread with one job at a time
+            class worker_pool
+            {
+            public:
+                // creates up to the given number of workers, fewer if thread creation fails
+                explicit worker_pool(unsigned no_workers) noexcept
+                : job_(nullptr), generation_(0u), stop_(false)
+                {
+                    try
+                    {
+                        workers_.reserve(no_workers);
+                        for (auto i = 0u; i != no_workers; ++i)
+                            workers_.emplace_back([this] { run(); });
+                    }
+                    catch (...)
+                    {
+                        // use the workers we have
+                    }
+                }
+
+                worker_pool(const worker_pool&) = delete;
+                worker_pool& operator=(const worker_pool&) = delete;
+
+                ~worker_pool() noexcept
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        stop_ = true;
+                    }
+                    job_cv_.notify_all();
+                    for (auto& worker : workers_)
+                        worker.join();
+                }
+
+                // the pool used by the algorithms, created on first use
+                static worker_pool& global() noexcept
+                {
+                    // more threads don't help a copy that is limited by memory bandwidth
+                    static worker_pool pool(
+                        std::min(std::max(std::thread::hardware_concurrency(), 1u) - 1u, 7u));
+                    return pool;
+                }
+
+                size_type no_workers() const noexcept
+                {
+                    return workers_.size();
+                }
+
+                // calls f(begin, end) for disjoint ranges covering [0, n),
+                // the calling thread does all the work if the pool is busy with another job
+                template <typename Func>
+                void for_each_range(size_type n, Func& f) noexcept
+                {
+                    // a couple of ranges per thread, so a slow thread doesn't hold up everything
+                    auto no_ranges = 4u * (workers_.size() + 1u);
+                    job j(&invoke<Func>, &f, n, (n + no_ranges - 1u) / no_ranges);
+
+                    auto sequential = workers_.empty() || n <= 1u;
+                    if (!sequential)
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        if (job_ != nullptr)
+                            sequential = true;
+                        else
+                        {
+                            job_ = &j;
+                            ++generation_;
+                        }
+                    }
+                    if (sequential)
+                    {
+                        f(size_type(0), n);
+                        return;
+                    }
+
+                    job_cv_.notify_all();
+                    work(j);
+
+                    // wait for the workers that joined, no others can join afterwards
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    done_cv_.wait(lock, [&] { return j.active == 0u; });
+                    job_ = nullptr;
+                }
+
+            private:
+                struct job
+                {
+                    void (*invoke)(void*, size_type, size_type);
+                    void*                  f;
+                    size_type              n, grain;
+                    std::atomic<size_type> next;
+                    unsigned               active; // guarded by the mutex
+
+                    job(void (*invoke)(void*, size_type, size_type), void* f, size_type n,
+                        size_type grain) noexcept
+                    : invoke(invoke), f(f), n(n), grain(grain), next(0u), active(0u)
+                    {
+                    }
+                };
+
+                template <typename Func>
+                static void invoke(void* f, size_type begin, size_type end) noexcept
+                {
+                    (*static_cast<Func*>(f))(begin, end);
+                }
+
+                // takes ranges until there are none left
+                static void work(job& j) noexcept
+                {
+                    while (true)
+                    {
+                        auto begin = j.next.fetch_add(j.grain);
+                        if (begin >= j.n)
+                            break;
+                        j.invoke(j.f, begin, std::min(begin + j.grain, j.n));
+                    }
+                }
+
+                void run() noexcept
+                {
+                    auto                         seen = 0u;
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    while (true)
+                    {
+                        job_cv_.wait(lock, [&] {
+                            return stop_ || (job_ != nullptr && generation_ != seen);
+                        });
+                        if (stop_)
+                            return;
+
+                        seen   = generation_;
+                        auto j = job_;
+                        ++j->active;
+                        lock.unlock();
+
+                        work(*j);
+
+                        lock.lock();
+                        if (--j->active == 0u)
+                            done_cv_.notify_all();
+                    }
+                }
+
+                std::mutex              mutex_;
+                std::condition_variable job_cv_, done_cv_;
+                job*                    job_;
+                unsigned                generation_;
+                bool                    stop_;
+
+                std::vector<std::thread> workers_;
+            };
+
+            // bytes are split in units of cache lines
+            constexpr size_type parallel_copy_line = 64u;
+
+            // std::memcpy() split across the pool
+            inline void parallel_copy_bytes(worker_pool& pool, void* dest, const void* src,
+                                            size_type size) noexcept
+            {
+                auto dest_bytes = static_cast<char*>(dest);
+                auto src_bytes  = static_cast<const char*>(src);
+                auto copy       = [&](size_type begin, size_type end) {
+                    begin *= parallel_copy_line;
+                    end = std::min(end * parallel_copy_line, size);
+                    std::memcpy(dest_bytes + begin, src_bytes + begin, end - begin);
+                };
+                pool.for_each_range((size + parallel_copy_line - 1u) / parallel_copy_line, copy);
+            }
+
+            // std::memset() to zero split across the pool
+            inline void parallel_zero_bytes(worker_pool& pool, void* dest, size_type size) noexcept
+            {
+                auto dest_bytes = static_cast<char*>(dest);
+                auto zero       = [&](size_type begin, size_type end) {
+                    begin *= parallel_copy_line;
+                    end = std::min(end * parallel_copy_line, size);
+                    std::memset(dest_bytes + begin, 0, end - begin);
+                };
+                pool.for_each_range((size + parallel_copy_line - 1u) / parallel_copy_line, zero);
+            }
+
+            // copy constructs n objects split across the pool,
+            // T must be trivially copy constructible
+            template <typename T>
+            void parallel_fill(worker_pool& pool, T* dest, size_type n, const T& obj) noexcept
+            {
+                // obj might be one of the objects that are overwritten
+                const T value(obj);
+                auto    fill = [&](size_type begin, size_type end) {
+                    for (auto i = begin; i != end; ++i)
+                        ::new (static_cast<void*>(dest + i)) T(value);
+                };
+                pool.for_each_range(n, fill);
+            }
+        } // namespace detail
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_PARALLEL_COPY_HPP_INCLUDED
@@ -0,0 +1,197 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_PREFIX_SEARCH_HPP_INCLUDED
+#define FOONATHAN_ARRAY_PREFIX_SEARCH_HPP_INCLUDED
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <string>
+
+#include <foonathan/array/array.hpp>
+#include <foonathan/array/key_compare.hpp>
+
+namespace foonathan
+{
+    namespace array
+    {
+        /// The default normalized key prefix.
+        ///
+        /// A `KeyPrefix` provides a `static std::uint64_t prefix<Key>(const TransparentKey&)` function.
+        /// The prefix must preserve the ordering of the `KeyCompare`:
+        /// if a key is less than an other key, its prefix must be less than or equal to the other prefix.
+        /// Keys with equal prefixes are then ordered by the `KeyCompare` itself.
+        struct key_prefix_default
+        {
+            /// Helper struct to allow customization of the default prefix for specific keys.
+            ///
+            /// This is required because `key_prefix_default` itself shouldn't be a template,
+            /// but it should still be possible to provide prefixes for other keys.
+            ///
+            /// A specialization for a user-defined type must give it the same interface as required by the `KeyPrefix` concept.
+            /// There are only specializations for [std::string]() and [array::string_key]() by default.
+            template <typename Key>
+            struct customize_for;
+
+            template <typename Key, typename TransparentKey>
+            static std::uint64_t prefix(const TransparentKey& key) noexcept
+            {
+                return customize_for<Key>::prefix(key);
+            }
+        };
+
+        /// The prefix of a [std::string]() are its first eight bytes as big-endian integer,
+        /// padded with zeroes.
+        ///
+        /// This preserves the ordering of [std::string::compare]().
+        template <>
+        struct key_prefix_default::customize_for<std::string>
+        {
+            static std::uint64_t prefix(const std::string& str) noexcept
+            {
+                return prefix(str.data(), str.size());
+            }
+
+            static std::uint64_t prefix(const char* str) noexcept
+            {
+                std::uint64_t result = 0u;
+                auto          i      = 0u;
+                for (; i != 8u && str[i] != '\0'; ++i)
+                    result = (result << 8u) | static_cast<unsigned char>(str[i]);
+                for (; i != 8u; ++i)
+                    result <<= 8u;
+                return result;
+            }
+
+            static std::uint64_t prefix(const char* str, std::size_t size) noexcept
+            {
+                std::uint64_t result = 0u;
+                for (auto i = 0u; i != 8u; ++i)
+                {
+                    result <<= 8u;
+                    if (i < size)
+                        result |= static_cast<unsigned char>(str[i]);
+                }
+                return result;
+            }
+        };
+
+        /// A `SearchPolicy` that keeps a sorted array of normalized key prefixes.
+        ///
+        /// The containers store the prefix of each key as determined by the `KeyPrefix` in a separate array.
+        /// A search first searches the dense integer array, and only the keys that share the prefix of the searched key
+        /// are searched using the `Fallback` policy and the `KeyCompare`.
+        /// This is faster for keys that are expensive to compare and mostly differ in their prefix, like strings.
+        ///
+        /// \notes This requires additional memory for the prefix array and it must be updated on every modification.
+        template <class KeyPrefix = key_prefix_default, class Fallback = binary_search>
+        struct prefix_search
+        {
+            /// The index stored by the containers.
+            /// \exclude target
+            template <typename Key, class BlockStorage>
+            class index
+            {
+            public:
+                index() noexcept = default;
+
+                explicit index(const typename BlockStorage::arg_type& args) noexcept
+                : prefixes_(args)
+                {
+                }
+
+                friend void swap(index& lhs, index& rhs) noexcept(
+                    block_storage_nothrow_move<BlockStorage, std::uint64_t>{})
+                {
+                    swap(lhs.prefixes_, rhs.prefixes_);
+                }
+
+                //=== synchronization ===//
+                // requires: capacity for the new prefix was reserved
+                template <typename TransparentKey>
+                void insert(size_type pos, const TransparentKey& key) noexcept
+                {
+                    assert(prefixes_.size() < prefixes_.capacity());
+                    prefixes_.emplace(prefixes_.begin() + std::ptrdiff_t(pos),
+                                      KeyPrefix::template prefix<Key>(key));
+                }
+
+                void erase_range(size_type begin, size_type end) noexcept
+                {
+                    prefixes_.erase_range(prefixes_.begin() + std::ptrdiff_t(begin),
+                                          prefixes_.begin() + std::ptrdiff_t(end));
+                }
+
+                void clear() noexcept
+                {
+                    prefixes_.clear();
+                }
+
+                template <typename ForwardIt>
+                void assign(ForwardIt begin, ForwardIt end)
+                {
+                    prefixes_.clear();
+                    prefixes_.reserve(size_type(std::distance(begin, end)));
+                    for (auto cur = begin; cur != end; ++cur)
+                        prefixes_.push_back(KeyPrefix::template prefix<Key>(*cur));
+                }
+
+                void reserve(size_type new_capacity)
+                {
+                    prefixes_.reserve(new_capacity);
+                }
+
+                void shrink_to_fit()
+                {
+                    prefixes_.shrink_to_fit();
+                }
+
+                //=== search ===//
+                template <class Compare, typename RandomAccessIt, typename TransparentKey>
+                RandomAccessIt lower_bound(RandomAccessIt begin, RandomAccessIt,
+                                           const TransparentKey& key) const
+                {
+                    auto range = prefix_range(key);
+                    return Fallback::template lower_bound<Compare>(begin + range.first,
+                                                                   begin + range.second, key);
+                }
+
+                template <class Compare, typename RandomAccessIt, typename TransparentKey>
+                RandomAccessIt upper_bound(RandomAccessIt begin, RandomAccessIt,
+                                           const TransparentKey& key) const
+                {
+                    auto range = prefix_range(key);
+                    return Fallback::template upper_bound<Compare>(begin + range.first,
+                                                                   begin + range.second, key);
+                }
+
+                template <class Compare, typename RandomAccessIt, typename TransparentKey>
+                iter_pair<RandomAccessIt> equal_range(RandomAccessIt begin, RandomAccessIt,
+                                                      const TransparentKey& key) const
+                {
+                    auto range = prefix_range(key);
+                    return Fallback::template equal_range<Compare>(begin + range.first,
+                                                                   begin + range.second, key);
+                }
+
+            private:
+                // all keys outside the range are either less or greater than the key,
+                // as the prefix preserves the ordering
+                template <typename TransparentKey>
+                std::pair<std::ptrdiff_t, std::ptrdiff_t> prefix_range(
+                    const TransparentKey& key) const noexcept
+                {
+                    auto prefix = KeyPrefix::template prefix<Key>(key);
+                    auto range  = std::equal_range(prefixes_.begin(), prefixes_.end(), prefix);
+                    return {range.first - prefixes_.begin(), range.second - prefixes_.begin()};
+                }
+
+                array<std::uint64_t, BlockStorage> prefixes_;
+            };
+        };
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_PREFIX_SEARCH_HPP_INCLUDED
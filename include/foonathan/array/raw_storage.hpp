@@ -8,12 +8,22 @@
 #include <cassert>
 #include <cstring>
 #include <iterator>
+#include <limits>
 #include <new>
 #include <type_traits>
 
+#include <foonathan/array/config.hpp>
 #include <foonathan/array/contiguous_iterator.hpp>
 #include <foonathan/array/memory_block.hpp>
 
+#if FOONATHAN_ARRAY_PARALLEL_COPY_THRESHOLD
+#include <foonathan/array/parallel_copy.hpp>
+#endif
+
+#if FOONATHAN_ARRAY_NON_TEMPORAL_THRESHOLD
+#include <foonathan/array/non_temporal_copy.hpp>
+#endif
+
 namespace foonathan
 {
     namespace array
@@ -197,6 +207,21 @@ namespace foonathan
                 return result;
             }
 
+            /// \returns The memory that hasn't been used to create objects yet.
+            memory_block uninitialized_block() const noexcept
+            {
+                return memory_block(cur_end_, max_end_);
+            }
+
+            /// \effects Takes ownership over `n` objects at the beginning of the `uninitialized_block()`,
+            /// that have been created by other means,
+            /// e.g. by writing the bytes of a trivially copyable type.
+            void adopt_objects(size_type n) noexcept
+            {
+                assert(cur_end_ + n * sizeof(T) <= max_end_);
+                cur_end_ += n * sizeof(T);
+            }
+
             /// \effects Releases ownership over the created objects.
             /// \returns A pointer to the next free memory space.
             raw_pointer release() && noexcept
@@ -213,37 +238,188 @@ namespace foonathan
             raw_pointer cur_end_, max_end_;
         };
 
+        namespace detail
+        {
+            // std::memcpy() for non-overlapping memory,
+            // split across threads if it is bigger than FOONATHAN_ARRAY_PARALLEL_COPY_THRESHOLD
+            inline void copy_bytes(void* dest, const void* src, size_type size) noexcept
+            {
+                // an empty range may be given as null pointers, which std::memcpy() doesn't allow
+                if (size == 0u)
+                    return;
+#if FOONATHAN_ARRAY_PARALLEL_COPY_THRESHOLD
+                if (size >= FOONATHAN_ARRAY_PARALLEL_COPY_THRESHOLD)
+                    parallel_copy_bytes(worker_pool::global(), dest, src, size);
+                else
+#endif
+                    std::memcpy(dest, src, size);
+            }
+
+            // same as above, but for std::memset() to zero
+            inline void zero_bytes(void* dest, size_type size) noexcept
+            {
+                if (size == 0u)
+                    return;
+#if FOONATHAN_ARRAY_PARALLEL_COPY_THRESHOLD
+                if (size >= FOONATHAN_ARRAY_PARALLEL_COPY_THRESHOLD)
+                    parallel_zero_bytes(worker_pool::global(), dest, size);
+                else
+#endif
+                    std::memset(dest, 0, size);
+            }
+
+            // same as above, but copy constructs n objects,
+            // T must be trivially copy constructible
+            template <typename T>
+            void fill_trivial(T* dest, size_type n, const T& obj) noexcept
+            {
+#if FOONATHAN_ARRAY_PARALLEL_COPY_THRESHOLD
+                if (n * sizeof(T) >= FOONATHAN_ARRAY_PARALLEL_COPY_THRESHOLD)
+                    parallel_fill(worker_pool::global(), dest, n, obj);
+                else
+#endif
+                    // a plain loop without the bookkeeping, so it can be vectorized
+                    for (auto i = size_type(0); i != n; ++i)
+                        ::new (static_cast<void*>(dest + i)) T(obj);
+            }
+
+            template <typename T>
+            raw_pointer uninitialized_default_construct_impl(std::true_type,
+                                                             const memory_block& block,
+                                                             size_type           n) noexcept
+            {
+                // trivially default constructible, default initialization doesn't do anything
+                assert(n * sizeof(T) <= block.size());
+                return block.begin() + n * sizeof(T);
+            }
+
+            template <typename T>
+            raw_pointer uninitialized_default_construct_impl(std::false_type,
+                                                             const memory_block& block, size_type n)
+            {
+                partially_constructed_range<T> range(block);
+                for (auto i = size_type(0); i != n; ++i)
+                    range.default_construct_object();
+                return std::move(range).release();
+            }
+        } // namespace detail
+
         /// \effects Creates `n` objects of type `T` in the memory block using [array::default_construct_object]().
         /// \returns A pointer after the last created object.
+        /// \notes If `T` is trivially default constructible, this doesn't touch the memory at all.
         template <typename T>
         raw_pointer uninitialized_default_construct(const memory_block& block, size_type n)
         {
-            partially_constructed_range<T> range(block);
-            for (auto i = size_type(0); i != n; ++i)
-                range.default_construct_object();
-            return std::move(range).release();
+            return detail::uninitialized_default_construct_impl<T>(
+                std::is_trivially_default_constructible<T>{}, block, n);
         }
 
+        namespace detail
+        {
+            // whether the object representation of a value initialized object is all zero
+            template <typename T>
+            struct is_zero_value_initialized
+            : std::integral_constant<bool, std::is_integral<T>::value || std::is_enum<T>::value
+                                               || std::is_pointer<T>::value
+                                               || (std::is_floating_point<T>::value
+                                                   && std::numeric_limits<T>::is_iec559)>
+            {
+            };
+
+            // constructing copies can't throw, so there is no need to track the created ones
+            template <typename T>
+            raw_pointer uninitialized_fill_trivial(const memory_block& block, size_type n,
+                                                   const T& obj) noexcept
+            {
+                assert(n * sizeof(T) <= block.size());
+                fill_trivial(to_pointer<T>(block.begin()), n, obj);
+                return block.begin() + n * sizeof(T);
+            }
+
+            template <typename T>
+            raw_pointer uninitialized_fill_impl(std::true_type, const memory_block& block,
+                                                size_type n, const T& obj) noexcept
+            {
+                return uninitialized_fill_trivial(block, n, obj);
+            }
+
+            template <typename T>
+            raw_pointer uninitialized_fill_impl(std::false_type, const memory_block& block,
+                                                size_type n, const T& obj)
+            {
+                partially_constructed_range<T> range(block);
+                for (auto i = size_type(0); i != n; ++i)
+                    range.construct_object(obj);
+                return std::move(range).release();
+            }
+
+            enum class value_construct_kind
+            {
+                zero,    //< value initialization writes zero bytes
+                trivial, //< value initialization of a copy can't throw
+                other,
+            };
+
+            template <typename T>
+            using value_construct_tag = std::integral_constant<
+                value_construct_kind,
+                is_zero_value_initialized<T>::value
+                    ? value_construct_kind::zero
+                    : std::is_trivially_default_constructible<T>::value
+                              && std::is_trivially_copy_constructible<T>::value
+                          ? value_construct_kind::trivial
+                          : value_construct_kind::other>;
+
+            template <typename T>
+            raw_pointer uninitialized_value_construct_impl(
+                std::integral_constant<value_construct_kind, value_construct_kind::zero>,
+                const memory_block& block, size_type n) noexcept
+            {
+                assert(n * sizeof(T) <= block.size());
+                zero_bytes(to_void_pointer(block.begin()), n * sizeof(T));
+                return block.begin() + n * sizeof(T);
+            }
+
+            template <typename T>
+            raw_pointer uninitialized_value_construct_impl(
+                std::integral_constant<value_construct_kind, value_construct_kind::trivial>,
+                const memory_block& block, size_type n) noexcept
+            {
+                // value initialization might do more than zeroing, so copy a value initialized one
+                const T obj{};
+                return uninitialized_fill_trivial(block, n, obj);
+            }
+
+            template <typename T>
+            raw_pointer uninitialized_value_construct_impl(
+                std::integral_constant<value_construct_kind, value_construct_kind::other>,
+                const memory_block& block, size_type n)
+            {
+                partially_constructed_range<T> range(block);
+                for (auto i = size_type(0); i != n; ++i)
+                    range.value_construct_object();
+                return std::move(range).release();
+            }
+        } // namespace detail
+
         /// \effects Creates `n` objects of type `T` in the memory block using [array::value_construct_object]().
         /// \returns A pointer after the last created object.
+        /// \notes If `T` is an arithmetic, enumeration or pointer type, this is a single `std::memset()`.
         template <typename T>
         raw_pointer uninitialized_value_construct(const memory_block& block, size_type n)
         {
-            partially_constructed_range<T> range(block);
-            for (auto i = size_type(0); i != n; ++i)
-                range.value_construct_object();
-            return std::move(range).release();
+            return detail::uninitialized_value_construct_impl<T>(detail::value_construct_tag<T>{},
+                                                                 block, n);
         }
 
         /// \effects Creates `n` objects of type `T` in the memory block by copying the existing one.
         /// \returns A pointer after the last created object.
+        /// \notes If `T` is trivially copy constructible, the copies are created in a loop the compiler can vectorize.
         template <typename T>
         raw_pointer uninitialized_fill(const memory_block& block, size_type n, const T& obj)
         {
-            partially_constructed_range<T> range(block);
-            for (auto i = size_type(0); i != n; ++i)
-                range.construct_object(obj);
-            return std::move(range).release();
+            return detail::uninitialized_fill_impl(std::is_trivially_copy_constructible<T>{},
+                                                   block, n, obj);
         }
 
         namespace detail
@@ -262,7 +438,7 @@ namespace foonathan
                 auto no_elements = std::size_t(end - begin);
                 auto size        = no_elements * sizeof(T);
                 assert(block.size() >= size);
-                std::memcpy(to_void_pointer(block.begin()), iterator_to_pointer(begin), size);
+                copy_bytes(to_void_pointer(block.begin()), iterator_to_pointer(begin), size);
                 return block.begin() + size;
             }
 
@@ -283,6 +459,69 @@ namespace foonathan
                 return uninitialized_move_copy_impl<T, TargetT>(can_memcpy<InputIter, T>{}, begin,
                                                                 end, block);
             }
+
+            enum class convert_kind
+            {
+                memcpy,     //< same type, can be copied as bytes
+                arithmetic, //< conversion between arithmetic types, can't throw
+                other,
+            };
+
+            template <typename T, typename InputIter>
+            using convert_tag = std::integral_constant<
+                convert_kind,
+                !is_contiguous_iterator<InputIter>::value
+                    ? convert_kind::other
+                    : std::is_same<typename std::iterator_traits<InputIter>::value_type, T>::value
+                              && std::is_trivially_copyable<T>::value
+                          ? convert_kind::memcpy
+                          : std::is_arithmetic<typename std::iterator_traits<
+                                InputIter>::value_type>::value
+                                    && std::is_arithmetic<T>::value
+                                ? convert_kind::arithmetic
+                                : convert_kind::other>;
+
+            template <typename T, typename, typename ContIter>
+            raw_pointer uninitialized_convert_impl(
+                std::integral_constant<convert_kind, convert_kind::memcpy>, ContIter begin,
+                ContIter end, const memory_block& block) noexcept
+            {
+                return uninitialized_move_copy_impl<T, T>(std::true_type{}, begin, end, block);
+            }
+
+            template <typename T, typename, typename ContIter>
+            raw_pointer uninitialized_convert_impl(
+                std::integral_constant<convert_kind, convert_kind::arithmetic>, ContIter begin,
+                ContIter end, const memory_block& block) noexcept
+            {
+                auto no_elements = size_type(end - begin);
+                assert(no_elements * sizeof(T) <= block.size());
+                // a plain loop without the bookkeeping, so it can be vectorized
+                auto src  = iterator_to_pointer(begin);
+                auto dest = to_pointer<T>(block.begin());
+                for (auto i = size_type(0); i != no_elements; ++i)
+                    ::new (static_cast<void*>(dest + i)) T(src[i]);
+                return block.begin() + no_elements * sizeof(T);
+            }
+
+            template <typename T, typename Reference, typename InputIter>
+            raw_pointer uninitialized_convert_impl(
+                std::integral_constant<convert_kind, convert_kind::other>, InputIter begin,
+                InputIter end, const memory_block& block)
+            {
+                partially_constructed_range<T> range(block);
+                for (auto cur = begin; cur != end; ++cur)
+                    range.construct_object(static_cast<Reference>(*cur));
+                return std::move(range).release();
+            }
+
+            template <typename T, typename Reference, typename InputIter>
+            raw_pointer uninitialized_convert(InputIter begin, InputIter end,
+                                              const memory_block& block)
+            {
+                return uninitialized_convert_impl<T, Reference>(convert_tag<T, InputIter>{}, begin,
+                                                                end, block);
+            }
         } // namespace detail
 
         /// \effects Moves elements of the given range to the uninitialized memory of the given block.
@@ -328,10 +567,7 @@ namespace foonathan
         raw_pointer uninitialized_copy_convert(InputIter begin, InputIter end,
                                                const memory_block& block)
         {
-            partially_constructed_range<T> range(block);
-            for (auto cur = begin; cur != end; ++cur)
-                range.construct_object(*cur);
-            return std::move(range).release();
+            return detail::uninitialized_convert<T, decltype(*begin)>(begin, end, block);
         }
 
         /// \effects Moves elements of the given range to the uninitialized memory of the given block, implicitly converting all elements.
@@ -341,23 +577,55 @@ namespace foonathan
         raw_pointer uninitialized_move_convert(InputIter begin, InputIter end,
                                                const memory_block& block)
         {
-            partially_constructed_range<T> range(block);
-            for (auto cur = begin; cur != end; ++cur)
-                range.construct_object(std::move(*cur));
-            return std::move(range).release();
+            return detail::uninitialized_convert<T, decltype(std::move(*begin))>(begin, end,
+                                                                                 block);
         }
 
+        namespace detail
+        {
+            // relocates trivially copyable objects, they don't need to be destroyed
+            template <typename ContIter>
+            raw_pointer uninitialized_destructive_move_impl(std::true_type, ContIter begin,
+                                                            ContIter end,
+                                                            const memory_block& block) noexcept
+            {
+                using type = typename std::iterator_traits<ContIter>::value_type;
+
+                auto size = size_type(end - begin) * sizeof(type);
+                assert(block.size() >= size);
+#if FOONATHAN_ARRAY_NON_TEMPORAL_THRESHOLD
+                if (size >= FOONATHAN_ARRAY_NON_TEMPORAL_THRESHOLD)
+                    non_temporal_copy_bytes(to_void_pointer(block.begin()),
+                                            iterator_to_pointer(begin), size);
+                else
+#endif
+                    copy_bytes(to_void_pointer(block.begin()), iterator_to_pointer(begin), size);
+                return block.begin() + size;
+            }
+
+            template <typename FwdIter>
+            raw_pointer uninitialized_destructive_move_impl(std::false_type, FwdIter begin,
+                                                            FwdIter end, const memory_block& block)
+            {
+                auto result = uninitialized_move_if_noexcept(begin, end, block);
+                destroy_range(begin, end);
+                return result;
+            }
+        } // namespace detail
+
         /// \effects [std::move_if_noexcept]() elements of the given range to the uninitialized memory of the given block,
         /// then destroys them at the old location.
         /// \returns A pointer past the last created object.
         /// \notes If an exception is thrown, the old range has not been modified and all objects created at the new location will be destroyed.
+        /// \notes If the objects are trivially copyable and at least `FOONATHAN_ARRAY_NON_TEMPORAL_THRESHOLD` bytes big,
+        /// they are copied with non-temporal stores that bypass the cache.
         template <typename FwdIter>
         raw_pointer uninitialized_destructive_move(FwdIter begin, FwdIter end,
                                                    const memory_block& block)
         {
-            auto result = uninitialized_move_if_noexcept(begin, end, block);
-            destroy_range(begin, end);
-            return result;
+            using type = typename std::iterator_traits<FwdIter>::value_type;
+            return detail::uninitialized_destructive_move_impl(detail::can_memcpy<FwdIter, type>{},
+                                                               begin, end, block);
         }
     } // namespace array
 } // namespace foonathan
@@ -0,0 +1,582 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_ARRAY_SERIALIZATION_HPP_INCLUDED
+#define FOONATHAN_ARRAY_SERIALIZATION_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <foonathan/array/array.hpp>
+#include <foonathan/array/bag.hpp>
+#include <foonathan/array/byte_view.hpp>
+#include <foonathan/array/flat_map.hpp>
+#include <foonathan/array/flat_set.hpp>
+
+namespace foonathan
+{
+    namespace array
+    {
+        /// Exception thrown when deserializing invalid input.
+        class serialization_error : public std::exception
+        {
+        public:
+            explicit serialization_error(const char* msg) noexcept : msg_(msg) {}
+
+            const char* what() const noexcept override
+            {
+                return msg_;
+            }
+
+        private:
+            const char* msg_;
+        };
+
+        /// The flags stored in a [array::serialization_header]().
+        enum serialization_flags : std::uint32_t
+        {
+            serialization_sorted = 1u, //< The elements are sorted.
+            serialization_unique = 2u, //< The elements don't contain duplicates.
+        };
+
+        /// The header written in front of each sequence of elements.
+        ///
+        /// Everything is written in the native byte order,
+        /// so it can only be read on a platform with the same byte order and object layout.
+        struct serialization_header
+        {
+            /// The number of elements.
+            std::uint64_t size;
+            /// The size of each element if they were written bitwise, `0` otherwise.
+            std::uint32_t element_size;
+            /// A combination of [array::serialization_flags]().
+            std::uint32_t flags;
+        };
+
+        namespace detail
+        {
+            template <class Customization, typename = void>
+            struct codec_bitwise : std::false_type
+            {
+            };
+
+            template <class Customization>
+            struct codec_bitwise<Customization, decltype(void(Customization::bitwise))>
+            : std::integral_constant<bool, Customization::bitwise>
+            {
+            };
+        } // namespace detail
+
+        /// The default `Codec` of the serialization functions.
+        ///
+        /// A `Codec` has a `static constexpr bool is_bitwise<T>()` function,
+        /// which returns whether or not objects of the trivially copyable type `T` are written as their bytes.
+        /// If they are, all elements are written and read with a single call.
+        /// Otherwise, it has a `static void write(Writer& writer, const T& obj)` function
+        /// and a `static T read<T>(Reader& reader)` function that encode/decode a single object.
+        ///
+        /// A `Writer` has a function `write(const byte* data, size_type size)` that writes the bytes,
+        /// a `Reader` has a function `read(byte* data, size_type size)` that fills the bytes
+        /// or throws if that isn't possible.
+        struct codec_default
+        {
+            /// Helper struct to allow customization of the default encoding for specific types.
+            ///
+            /// This is required because `codec_default` itself shouldn't be a template,
+            /// but it should still be possible to encode user-defined types.
+            ///
+            /// A specialization for a user-defined type must provide the `write()` and `read()` functions.
+            /// It may also have a `static constexpr bool bitwise` member that is `true` if the type should be written bitwise.
+            template <typename T>
+            struct customize_for
+            {
+                static constexpr bool bitwise = std::is_trivially_copyable<T>::value;
+
+                template <class Writer>
+                static void write(Writer& writer, const T& obj)
+                {
+                    static_assert(bitwise, "specialize codec_default::customize_for for that type");
+                    auto bytes = byte_view(block_view<const T>(&obj, 1u));
+                    writer.write(bytes.data(), bytes.size());
+                }
+
+                template <class Reader>
+                static T read(Reader& reader)
+                {
+                    static_assert(bitwise, "specialize codec_default::customize_for for that type");
+                    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+                    reader.read(to_raw_pointer(&storage), sizeof(T));
+                    return *to_pointer<T>(to_raw_pointer(&storage));
+                }
+            };
+
+            template <typename T>
+            static constexpr bool is_bitwise() noexcept
+            {
+                return detail::codec_bitwise<customize_for<T>>::value;
+            }
+
+            template <class Writer, typename T>
+            static void write(Writer& writer, const T& obj)
+            {
+                customize_for<T>::write(writer, obj);
+            }
+
+            template <typename T, class Reader>
+            static T read(Reader& reader)
+            {
+                return customize_for<T>::read(reader);
+            }
+        };
+
+        /// Writes the size followed by the characters.
+        template <typename Char, class Traits, class Allocator>
+        struct codec_default::customize_for<std::basic_string<Char, Traits, Allocator>>
+        {
+            static_assert(std::is_trivially_copyable<Char>::value, "invalid character type");
+
+            using string = std::basic_string<Char, Traits, Allocator>;
+
+            template <class Writer>
+            static void write(Writer& writer, const string& str)
+            {
+                codec_default::write(writer, std::uint64_t(str.size()));
+                auto bytes = byte_view(block_view<const Char>(str.data(), str.size()));
+                writer.write(bytes.data(), bytes.size());
+            }
+
+            template <class Reader>
+            static string read(Reader& reader)
+            {
+                auto   size = codec_default::read<std::uint64_t>(reader);
+                string result(static_cast<size_type>(size), Char());
+                reader.read(to_raw_pointer(&result[0]), result.size() * sizeof(Char));
+                return result;
+            }
+        };
+
+        /// A `Writer` that appends the bytes to an [array::array]().
+        template <class BlockStorage = block_storage_default>
+        class memory_writer
+        {
+        public:
+            memory_writer() = default;
+
+            explicit memory_writer(typename BlockStorage::arg_type args) noexcept
+            : bytes_(std::move(args))
+            {
+            }
+
+            void write(const byte* data, size_type size)
+            {
+                bytes_.append_range(data, data + size);
+            }
+
+            /// \returns The bytes that have been written.
+            const array<byte, BlockStorage>& bytes() const noexcept
+            {
+                return bytes_;
+            }
+
+        private:
+            array<byte, BlockStorage> bytes_;
+        };
+
+        /// A `Reader` that reads the bytes from an [array::array_view]().
+        class memory_reader
+        {
+        public:
+            explicit memory_reader(array_view<const byte> bytes) noexcept : bytes_(bytes) {}
+
+            /// \throws [array::serialization_error]() if there are not enough bytes left.
+            void read(byte* data, size_type size)
+            {
+                if (size > bytes_.size())
+                    throw serialization_error("unexpected end of input");
+                else if (size != 0u)
+                {
+                    std::memcpy(data, bytes_.data(), size);
+                    bytes_ = array_view<const byte>(bytes_.data() + size, bytes_.size() - size);
+                }
+            }
+
+            /// \returns The number of bytes that haven't been read yet.
+            size_type remaining() const noexcept
+            {
+                return bytes_.size();
+            }
+
+        private:
+            array_view<const byte> bytes_;
+        };
+
+        namespace detail
+        {
+            template <class Codec, typename T>
+            using codec_is_bitwise = std::integral_constant<bool, Codec::template is_bitwise<T>()>;
+
+            template <class Codec, typename T, class Writer>
+            void write_header(Writer& writer, size_type size, std::uint32_t flags)
+            {
+                serialization_header header;
+                header.size         = size;
+                header.element_size = codec_is_bitwise<Codec, T>::value ? sizeof(T) : 0u;
+                header.flags        = flags;
+
+                auto bytes = byte_view(block_view<const serialization_header>(&header, 1u));
+                writer.write(bytes.data(), bytes.size());
+            }
+
+            template <class Codec, class Writer, typename T>
+            void write_element(std::true_type, Writer& writer, const T& obj)
+            {
+                auto bytes = byte_view(block_view<const T>(&obj, 1u));
+                writer.write(bytes.data(), bytes.size());
+            }
+            template <class Codec, class Writer, typename T>
+            void write_element(std::false_type, Writer& writer, const T& obj)
+            {
+                Codec::write(writer, obj);
+            }
+
+            template <class Codec, class Writer, typename T>
+            void write_elements(std::true_type, Writer& writer, block_view<const T> elements)
+            {
+                auto bytes = byte_view(elements);
+                writer.write(bytes.data(), bytes.size());
+            }
+            template <class Codec, class Writer, typename T>
+            void write_elements(std::false_type, Writer& writer, block_view<const T> elements)
+            {
+                for (auto& element : elements)
+                    Codec::write(writer, element);
+            }
+
+            template <class Codec, class Writer, typename T>
+            void write_sequence(Writer& writer, block_view<const T> elements, std::uint32_t flags)
+            {
+                write_header<Codec, T>(writer, elements.size(), flags);
+                write_elements<Codec>(codec_is_bitwise<Codec, T>{}, writer, elements);
+            }
+
+            template <class Codec, typename T, class BlockStorage, class Reader>
+            serialization_header read_header(Reader& reader, const BlockStorage& storage)
+            {
+                serialization_header header;
+                auto bytes = byte_view(block_view<serialization_header>(&header, 1u));
+                reader.read(bytes.data(), bytes.size());
+
+                if (header.element_size != (codec_is_bitwise<Codec, T>::value ? sizeof(T) : 0u))
+                    throw serialization_error("element size mismatch");
+                else if (header.size > BlockStorage::max_size(storage.arguments()) / sizeof(T))
+                    throw serialization_error("size exceeds max_size");
+                return header;
+            }
+
+            // reads a sequence of elements directly into a new block storage
+            template <typename T, class BlockStorage>
+            class read_block
+            {
+            public:
+                template <class Codec, class Reader>
+                read_block(Codec, Reader& reader, typename BlockStorage::arg_type args)
+                : storage_(std::move(args)),
+                  header_(read_header<Codec, T>(reader, storage_)),
+                  view_(empty, storage_.block().begin())
+                {
+                    // reserve once, then fill the memory
+                    auto bytes = size_type(header_.size) * sizeof(T);
+                    auto begin = clear_and_reserve(storage_, view_, bytes);
+                    auto end = read_elements<Codec>(codec_is_bitwise<Codec, T>{}, reader,
+                                                    memory_block(begin, bytes));
+                    view_    = block_view<T>(memory_block(begin, end));
+                }
+
+                read_block(const read_block&) = delete;
+                read_block& operator=(const read_block&) = delete;
+
+                ~read_block() noexcept
+                {
+                    destroy_range(view_.begin(), view_.end());
+                }
+
+                const serialization_header& header() const noexcept
+                {
+                    return header_;
+                }
+
+                bool has_flags(std::uint32_t flags) const noexcept
+                {
+                    return (header_.flags & flags) == flags;
+                }
+
+                T* begin() const noexcept
+                {
+                    return view_.data();
+                }
+
+                T* end() const noexcept
+                {
+                    return view_.data_end();
+                }
+
+                operator input_view<T, BlockStorage>() && noexcept
+                {
+                    auto result = input_view<T, BlockStorage>(std::move(storage_), view_);
+                    view_       = block_view<T>(empty, storage_.block().begin());
+                    return result;
+                }
+
+            private:
+                template <class Codec, class Reader>
+                static raw_pointer read_elements(std::true_type, Reader& reader,
+                                                 const memory_block& block)
+                {
+                    // trivially copyable, so the bytes are the objects
+                    reader.read(block.begin(), block.size());
+                    return block.end();
+                }
+                template <class Codec, class Reader>
+                static raw_pointer read_elements(std::false_type, Reader& reader,
+                                                 const memory_block& block)
+                {
+                    partially_constructed_range<T> range(block);
+                    for (auto i = size_type(0); i != block.size() / sizeof(T); ++i)
+                        range.construct_object(Codec::template read<T>(reader));
+                    return std::move(range).release();
+                }
+
+                BlockStorage         storage_;
+                serialization_header header_;
+                block_view<T>        view_;
+            };
+
+            template <class Container>
+            struct container_serializer;
+
+            template <typename T, class BlockStorage>
+            struct container_serializer<array<T, BlockStorage>>
+            {
+                template <class Codec, class Writer>
+                static void write(Writer& writer, const array<T, BlockStorage>& arr)
+                {
+                    write_sequence<Codec>(writer, block_view<const T>(arr.begin(), arr.end()), 0u);
+                }
+
+                template <class Codec, class Reader>
+                static array<T, BlockStorage> read(Reader&                          reader,
+                                                   typename BlockStorage::arg_type args)
+                {
+                    read_block<T, BlockStorage> block(Codec{}, reader, args);
+                    return array<T, BlockStorage>(std::move(block), std::move(args));
+                }
+            };
+
+            template <typename T, class BlockStorage>
+            struct container_serializer<bag<T, BlockStorage>>
+            {
+                template <class Codec, class Writer>
+                static void write(Writer& writer, const bag<T, BlockStorage>& b)
+                {
+                    write_sequence<Codec>(writer, block_view<const T>(b.begin(), b.end()), 0u);
+                }
+
+                template <class Codec, class Reader>
+                static bag<T, BlockStorage> read(Reader&                          reader,
+                                                 typename BlockStorage::arg_type args)
+                {
+                    read_block<T, BlockStorage> block(Codec{}, reader, args);
+                    return bag<T, BlockStorage>(std::move(block), std::move(args));
+                }
+            };
+
+            // the flags are part of the input, so they are only trusted after a linear check
+            template <class Compare, bool AllowDuplicates, typename Key, class BlockStorage>
+            bool has_sorted_keys(const read_block<Key, BlockStorage>& keys, std::uint32_t flags)
+            {
+                if (!keys.has_flags(flags))
+                    return false;
+                else if (keys.begin() == keys.end())
+                    return true;
+
+                for (auto cur = keys.begin() + 1; cur != keys.end(); ++cur)
+                {
+                    auto order = Compare::compare(*cur, cur[-1]);
+                    if (order == key_ordering::less
+                        || (!AllowDuplicates && order == key_ordering::equivalent))
+                        return false;
+                }
+                return true;
+            }
+
+            // sorts the keys together with their values by sorting their indices,
+            // so each key and value is moved exactly once,
+            // of equivalent keys the first one is kept unless duplicates are allowed
+            template <class Compare, bool AllowDuplicates, class Map, typename Key,
+                      typename Value, class BlockStorage>
+            void assign_unsorted(Map& result, read_block<Key, BlockStorage>& keys,
+                                 read_block<Value, BlockStorage>& values,
+                                 const typename BlockStorage::arg_type& args)
+            {
+                auto             size = size_type(keys.end() - keys.begin());
+                array<size_type> order;
+                order.reserve(size);
+                for (auto i = size_type(0); i != size; ++i)
+                    order.push_back(i);
+
+                auto key = keys.begin();
+                std::stable_sort(order.begin(), order.end(), [&](size_type lhs, size_type rhs) {
+                    return Compare::compare(key[lhs], key[rhs]) == key_ordering::less;
+                });
+                if (!AllowDuplicates)
+                {
+                    auto new_end =
+                        std::unique(order.begin(), order.end(), [&](size_type lhs, size_type rhs) {
+                            return Compare::compare(key[lhs], key[rhs])
+                                   == key_ordering::equivalent;
+                        });
+                    order.erase_range(new_end, order.end());
+                }
+
+                array<Key, BlockStorage>   sorted_keys(args);
+                array<Value, BlockStorage> sorted_values(args);
+                sorted_keys.reserve(order.size());
+                sorted_values.reserve(order.size());
+                for (auto index : order)
+                {
+                    sorted_keys.push_back(std::move(key[index]));
+                    sorted_values.push_back(std::move(values.begin()[index]));
+                }
+
+                result.assign_sorted(std::move(sorted_keys), std::move(sorted_values));
+            }
+
+            template <typename Key, class Compare, class BlockStorage, bool AllowDuplicates,
+                      class SearchPolicy>
+            struct container_serializer<
+                flat_set<Key, Compare, BlockStorage, AllowDuplicates, SearchPolicy>>
+            {
+                using set = flat_set<Key, Compare, BlockStorage, AllowDuplicates, SearchPolicy>;
+
+                static constexpr std::uint32_t flags =
+                    serialization_sorted | (AllowDuplicates ? 0u : serialization_unique);
+
+                template <class Codec, class Writer>
+                static void write(Writer& writer, const set& s)
+                {
+                    write_sequence<Codec>(writer, block_view<const Key>(s.begin(), s.end()),
+                                          flags);
+                }
+
+                template <class Codec, class Reader>
+                static set read(Reader& reader, typename BlockStorage::arg_type args)
+                {
+                    read_block<Key, BlockStorage> block(Codec{}, reader, args);
+
+                    set result(std::move(args));
+                    if (has_sorted_keys<Compare, AllowDuplicates>(block, flags))
+                        result.assign_sorted(std::move(block));
+                    else
+                        result.assign(std::move(block));
+                    return result;
+                }
+            };
+
+            template <typename Key, typename Value, class Compare, class BlockStorage,
+                      bool AllowDuplicates, class Layout, class SearchPolicy>
+            struct container_serializer<
+                flat_map<Key, Value, Compare, BlockStorage, AllowDuplicates, Layout, SearchPolicy>>
+            {
+                using map = flat_map<Key, Value, Compare, BlockStorage, AllowDuplicates, Layout,
+                                     SearchPolicy>;
+
+                static constexpr std::uint32_t flags =
+                    serialization_sorted | (AllowDuplicates ? 0u : serialization_unique);
+
+                // keys and values are contiguous
+                template <class Codec, class Writer, class L>
+                static void write(L, Writer& writer, const map& m)
+                {
+                    write_sequence<Codec>(writer,
+                                          block_view<const Key>(m.key_begin(), m.key_end()),
+                                          flags);
+                    write_sequence<Codec>(writer,
+                                          block_view<const Value>(m.value_begin(),
+                                                                  m.value_end()),
+                                          0u);
+                }
+                // keys and values are interleaved, write them one by one in the same format
+                template <class Codec, class Writer>
+                static void write(array_of_structs_layout, Writer& writer, const map& m)
+                {
+                    write_header<Codec, Key>(writer, m.size(), flags);
+                    for (auto pair : m)
+                        write_element<Codec>(codec_is_bitwise<Codec, Key>{}, writer, pair.key);
+
+                    write_header<Codec, Value>(writer, m.size(), 0u);
+                    for (auto pair : m)
+                        write_element<Codec>(codec_is_bitwise<Codec, Value>{}, writer,
+                                             pair.value);
+                }
+
+                template <class Codec, class Writer>
+                static void write(Writer& writer, const map& m)
+                {
+                    write<Codec>(Layout{}, writer, m);
+                }
+
+                template <class Codec, class Reader>
+                static map read(Reader& reader, typename BlockStorage::arg_type args)
+                {
+                    read_block<Key, BlockStorage>   keys(Codec{}, reader, args);
+                    read_block<Value, BlockStorage> values(Codec{}, reader, args);
+                    if (keys.header().size != values.header().size)
+                        throw serialization_error("different number of keys and values");
+
+                    map result(args);
+                    if (has_sorted_keys<Compare, AllowDuplicates>(keys, flags))
+                        result.assign_sorted(std::move(keys), std::move(values));
+                    else
+                        assign_unsorted<Compare, AllowDuplicates>(result, keys, values, args);
+                    return result;
+                }
+            };
+        } // namespace detail
+
+        /// \effects Writes the elements of the container to the `Writer`.
+        /// The container must be an [array::array](), [array::bag](), [array::flat_set]() or [array::flat_map]().
+        /// Each sequence of elements is preceded by a [array::serialization_header](),
+        /// a map writes the keys followed by the values.
+        /// If the `Codec` writes the elements bitwise, the entire sequence is written by a single call to `write()`,
+        /// otherwise each element is written by the `Codec`.
+        template <class Codec = codec_default, class Writer, class Container>
+        void serialize(Writer& writer, const Container& container)
+        {
+            detail::container_serializer<Container>::template write<Codec>(writer, container);
+        }
+
+        /// \returns A container created from the contents of the `Reader`,
+        /// as written by [array::serialize]().
+        /// The block storage is initialized with the given arguments.
+        /// \effects Reads the header of each sequence, reserves memory once,
+        /// and then reads the elements directly into it.
+        /// If the `Codec` writes the elements bitwise, it is filled by a single call to `read()`.
+        /// If the header records that the elements are sorted (and unique, if the container requires it),
+        /// and a linear check over the keys confirms it, a flat container takes them as they are,
+        /// otherwise it sorts them.
+        /// \throws [array::serialization_error]() if the header doesn't match the container,
+        /// or anything thrown by the `Reader`, `Codec` or allocation.
+        template <class Container, class Codec = codec_default, class Reader>
+        Container deserialize(Reader&                                              reader,
+                              typename Container::block_storage::arg_type args = {})
+        {
+            return detail::container_serializer<Container>::template read<Codec>(reader,
+                                                                                  std::move(args));
+        }
+    } // namespace array
+} // namespace foonathan
+
+#endif // FOONATHAN_ARRAY_SERIALIZATION_HPP_INCLUDED
@@ -4,6 +4,9 @@
 
 #include <foonathan/array/array.hpp>
 
+#include <cstring>
+#include <vector>
+
 #include <catch.hpp>
 
 #include <foonathan/array/block_storage_embedded.hpp>
@@ -156,6 +159,58 @@ namespace
                     array.erase_range(array.begin(), array.begin());
                     verify_array(array, {0xF0F0, 0xF5F5});
                 }
+                SECTION("erase_if")
+                {
+                    std::vector<int> visited;
+                    auto count = array.erase_if([&](const test_type& test) {
+                        visited.push_back(test.id);
+                        return test.id == 0xF1F1 || test.id == 0xF3F3;
+                    });
+                    REQUIRE(count == 3u);
+                    REQUIRE(visited
+                            == std::vector<int>({0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4, 0xF5F5,
+                                                 0xF3F3, 0xF4F4, 0xF5F5}));
+                    verify_array(array, {0xF0F0, 0xF2F2, 0xF4F4, 0xF5F5, 0xF4F4, 0xF5F5});
+
+                    REQUIRE(array.erase_if([](const test_type&) { return false; }) == 0u);
+                    verify_array(array, {0xF0F0, 0xF2F2, 0xF4F4, 0xF5F5, 0xF4F4, 0xF5F5});
+
+                    REQUIRE(array.erase_if([](const test_type&) { return true; }) == 6u);
+                    verify_array(array, {});
+                }
+                SECTION("erase_if throwing")
+                {
+                    REQUIRE_THROWS_AS(array.erase_if([](const test_type& test) {
+                        if (test.id == 0xF4F4)
+                            throw 42;
+                        return test.id == 0xF1F1;
+                    }),
+                                      int);
+                    verify_array(array, {0xF0F0, 0xF2F2, 0xF3F3, 0xF4F4, 0xF5F5, 0xF3F3, 0xF4F4,
+                                         0xF5F5});
+                }
+                SECTION("append_in_place")
+                {
+                    auto count =
+                        array.append_in_place(4u, [](partially_constructed_range<test_type>& r) {
+                            r.construct_object(0xA0A0);
+                            r.construct_object(0xA1A1);
+                        });
+                    REQUIRE(count == 2u);
+                    REQUIRE(array.capacity() >= 13u);
+                    verify_array(array, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4, 0xF5F5, 0xF3F3,
+                                         0xF4F4, 0xF5F5, 0xA0A0, 0xA1A1});
+
+                    REQUIRE_THROWS_AS(array.append_in_place(
+                                          2u,
+                                          [](partially_constructed_range<test_type>& r) {
+                                              r.construct_object(0xA2A2);
+                                              throw 42;
+                                          }),
+                                      int);
+                    verify_array(array, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4, 0xF5F5, 0xF3F3,
+                                         0xF4F4, 0xF5F5, 0xA0A0, 0xA1A1});
+                }
                 SECTION("move constructor")
                 {
                     using is_embedded = typename Array::block_storage::embedded_storage;
@@ -247,3 +302,50 @@ TEST_CASE("array block_storage_sbo", "[container]")
 {
     array_test_impl<test_array<block_storage_sbo<5 * sizeof(test_type), block_storage_default>>>();
 }
+
+TEST_CASE("array uninitialized growth", "[container]")
+{
+    array<char> arr;
+    arr.push_back('a');
+
+    arr.resize_for_overwrite(5u);
+    REQUIRE(arr.size() == 5u);
+    REQUIRE(arr[0] == 'a');
+    std::fill(arr.begin() + 1, arr.end(), 'b');
+
+    arr.resize_for_overwrite(3u);
+    REQUIRE(arr.size() == 3u);
+    REQUIRE(arr[0] == 'a');
+    REQUIRE(arr[2] == 'b');
+
+    auto count = arr.grow_uninitialized(10u, [](const memory_block& block) {
+        REQUIRE(block.size() == 10u);
+        std::memcpy(block.begin(), "cde", 3u);
+        return 3u;
+    });
+    REQUIRE(count == 3u);
+    REQUIRE(arr.size() == 6u);
+    REQUIRE(arr.capacity() >= 13u);
+    REQUIRE(std::equal(arr.begin(), arr.end(), "abbcde"));
+
+    REQUIRE(arr.grow_uninitialized(4u, [](const memory_block&) { return 0u; }) == 0u);
+    REQUIRE(arr.size() == 6u);
+
+    SECTION("non-trivial type")
+    {
+        leak_checker checker;
+
+        struct default_type : leak_tracked
+        {
+            int value = 42;
+        };
+
+        array<default_type> defaults;
+        defaults.resize_for_overwrite(4u);
+        REQUIRE(defaults.size() == 4u);
+        REQUIRE(defaults[3].value == 42);
+
+        defaults.resize_for_overwrite(1u);
+        REQUIRE(defaults.size() == 1u);
+    }
+}
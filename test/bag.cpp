@@ -145,6 +145,30 @@ TEST_CASE("bag", "[container]")
             verify_bag(bag, {0xF0F0, 0xF3F3});
             REQUIRE(next == bag.begin() + 1);
         }
+        SECTION("erase_if")
+        {
+            auto calls = 0;
+            auto count = bag.erase_if([&](const test_type& test) {
+                ++calls;
+                return test.id == 0xF0F0 || test.id == 0xF3F3 || test.id == 0xF5F5;
+            });
+            REQUIRE(calls == 9);
+            REQUIRE(count == 5u);
+            verify_bag(bag, {0xF4F4, 0xF1F1, 0xF2F2, 0xF4F4});
+
+            REQUIRE(bag.erase_if([](const test_type& test) { return test.id == 0xF4F4; }) == 2u);
+            verify_bag(bag, {0xF2F2, 0xF1F1});
+        }
+        SECTION("erase_if throwing")
+        {
+            REQUIRE_THROWS_AS(bag.erase_if([](const test_type& test) {
+                if (test.id == 0xF2F2)
+                    throw 42;
+                return test.id == 0xF0F0;
+            }),
+                              int);
+            verify_bag(bag, {0xF5F5, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4, 0xF5F5, 0xF3F3, 0xF4F4});
+        }
         SECTION("move constructor")
         {
             auto     data = iterator_to_pointer(bag.begin());
@@ -0,0 +1,201 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/bitmap_set.hpp>
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <foonathan/array/block_storage_sbo.hpp>
+#include <foonathan/array/flat_set.hpp>
+
+using namespace foonathan::array;
+
+namespace
+{
+    template <class Set, typename T>
+    void verify_set(const Set& set, const std::set<T>& keys)
+    {
+        REQUIRE(set.empty() == keys.empty());
+        REQUIRE(set.size() == keys.size());
+        REQUIRE(std::equal(set.begin(), set.end(), keys.begin()));
+        REQUIRE(size_type(std::distance(set.begin(), set.end())) == keys.size());
+
+        std::vector<T> decoded;
+        set.decode(std::back_inserter(decoded));
+        REQUIRE(std::equal(decoded.begin(), decoded.end(), keys.begin()));
+
+        if (!keys.empty())
+        {
+            REQUIRE(set.min() == *keys.begin());
+            REQUIRE(set.max() == *keys.rbegin());
+        }
+
+        for (auto key = size_type(0); key != set.universe() + 70u; ++key)
+        {
+            auto t = T(key);
+            REQUIRE(set.contains(t) == (keys.count(t) == 1u));
+            REQUIRE(set.count(t) == keys.count(t));
+            REQUIRE(set.rank(t) == size_type(std::distance(keys.begin(), keys.lower_bound(t))));
+
+            auto lower = keys.lower_bound(t);
+            if (lower == keys.end())
+                REQUIRE(set.lower_bound(t) == set.end());
+            else
+                REQUIRE(*set.lower_bound(t) == *lower);
+
+            auto upper = keys.upper_bound(t);
+            if (upper == keys.end())
+                REQUIRE(set.upper_bound(t) == set.end());
+            else
+                REQUIRE(*set.upper_bound(t) == *upper);
+
+            if (keys.count(t))
+                REQUIRE(*set.find(t) == t);
+            else
+                REQUIRE(set.find(t) == set.end());
+        }
+    }
+} // namespace
+
+TEST_CASE("bitmap_set", "[container]")
+{
+    bitmap_set<std::uint32_t> set;
+    std::set<std::uint32_t>   keys;
+    verify_set(set, keys);
+    REQUIRE(set.universe() == 0u);
+
+    for (auto i = 0u; i != 200u; ++i)
+    {
+        auto key    = i * 37u % 701u;
+        auto result = set.insert(key);
+        REQUIRE(result.was_inserted() == keys.insert(key).second);
+        REQUIRE(!result.was_duplicate() == result.was_inserted());
+        REQUIRE(*result.iter() == key);
+    }
+    verify_set(set, keys);
+    REQUIRE(set.universe() >= 700u);
+
+    SECTION("erase")
+    {
+        REQUIRE(set.erase_all(37u));
+        REQUIRE(!set.erase_all(37u));
+        REQUIRE(!set.erase_all(100000u));
+        keys.erase(37u);
+        verify_set(set, keys);
+
+        auto next = set.erase(set.find(74u));
+        REQUIRE(*next == *keys.upper_bound(74u));
+        keys.erase(74u);
+        verify_set(set, keys);
+
+        // range over multiple words
+        set.erase_range(set.lower_bound(50u), set.lower_bound(300u));
+        keys.erase(keys.lower_bound(50u), keys.lower_bound(300u));
+        verify_set(set, keys);
+
+        set.erase_range(set.lower_bound(650u), set.end());
+        keys.erase(keys.lower_bound(650u), keys.end());
+        verify_set(set, keys);
+
+        auto universe = set.universe();
+        set.clear();
+        keys.clear();
+        verify_set(set, keys);
+        REQUIRE(set.universe() == universe);
+
+        set.shrink_to_fit();
+        REQUIRE(set.universe() == 0u);
+    }
+    SECTION("copy")
+    {
+        auto copy = set;
+        REQUIRE(copy == set);
+        verify_set(copy, keys);
+
+        copy.insert(1000u);
+        REQUIRE(copy != set);
+        copy.erase_all(1000u);
+        REQUIRE(copy == set);
+
+        copy.shrink_to_fit();
+        REQUIRE(copy.universe() == 704u);
+        verify_set(copy, keys);
+
+        auto moved = std::move(copy);
+        verify_set(moved, keys);
+        verify_set(copy, std::set<std::uint32_t>{});
+
+        swap(copy, moved);
+        verify_set(copy, keys);
+        verify_set(moved, std::set<std::uint32_t>{});
+    }
+    SECTION("flat_set")
+    {
+        flat_set<std::uint32_t> flat;
+        flat.assign_range(set.begin(), set.end());
+        REQUIRE(std::equal(flat.begin(), flat.end(), keys.begin()));
+
+        bitmap_set<std::uint32_t, block_storage_sbo<128, block_storage_new<default_growth>>>
+            converted(flat);
+        verify_set(converted, keys);
+        REQUIRE(converted.memory_size() == 11u * sizeof(std::uint64_t));
+    }
+}
+
+TEST_CASE("bitmap_set operations", "[container]")
+{
+    std::set<std::uint16_t> keys_a, keys_b;
+    for (auto i = 0u; i != 300u; ++i)
+        keys_a.insert(std::uint16_t(i * 3u));
+    for (auto i = 0u; i != 200u; ++i)
+        keys_b.insert(std::uint16_t(i * 5u + 128u));
+
+    bitmap_set<std::uint16_t> a, b;
+    a.insert_range(keys_a.begin(), keys_a.end());
+    b.insert_range(keys_b.begin(), keys_b.end());
+    verify_set(a, keys_a);
+    verify_set(b, keys_b);
+
+    auto apply = [&](bool (*pred)(bool, bool)) {
+        std::set<std::uint16_t> result;
+        for (auto key = 0u; key != 2000u; ++key)
+            if (pred(keys_a.count(std::uint16_t(key)) != 0u,
+                     keys_b.count(std::uint16_t(key)) != 0u))
+                result.insert(std::uint16_t(key));
+        return result;
+    };
+
+    auto set_union        = apply([](bool a, bool b) { return a || b; });
+    auto set_intersection = apply([](bool a, bool b) { return a && b; });
+    auto a_without_b      = apply([](bool a, bool b) { return a && !b; });
+    auto b_without_a      = apply([](bool a, bool b) { return b && !a; });
+
+    verify_set(a | b, set_union);
+    verify_set(b | a, set_union);
+    verify_set(a & b, set_intersection);
+    verify_set(b & a, set_intersection);
+    verify_set(a - b, a_without_b);
+    verify_set(b - a, b_without_a);
+
+    REQUIRE((a | b) == (b | a));
+    REQUIRE((a & b) == (b & a));
+    REQUIRE((a - b) != (b - a));
+
+    bitmap_set<std::uint16_t> empty;
+    REQUIRE((a | empty) == a);
+    REQUIRE((a & empty).empty());
+    REQUIRE((a - empty) == a);
+    REQUIRE((empty - a).empty());
+
+    a &= b;
+    verify_set(a, set_intersection);
+    a |= b;
+    verify_set(a, keys_b);
+    a -= b;
+    verify_set(a, std::set<std::uint16_t>{});
+}
@@ -0,0 +1,106 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/block_storage_external.hpp>
+
+#include <catch.hpp>
+
+#include <foonathan/array/array.hpp>
+#include <foonathan/array/block_storage_new.hpp>
+
+#include "block_storage_algorithm.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    using storage      = block_storage_external<block_storage_new<no_extra_growth>>;
+    using test_array   = array<int, storage>;
+    using storage_args = storage::arg_type;
+
+    storage_args make_args(memory_block buffer)
+    {
+        return block_storage_args(buffer, block_storage_new<no_extra_growth>::arg_type{});
+    }
+
+    bool is_in(const test_array& a, const memory_block& buffer)
+    {
+        auto ptr = to_raw_pointer(const_cast<int*>(iterator_to_pointer(a.begin())));
+        return buffer.begin() <= ptr && ptr < buffer.end();
+    }
+} // namespace
+
+TEST_CASE("block_storage_external", "[BlockStorage]")
+{
+    test::test_block_storage_algorithm<storage>({});
+
+    alignas(int) unsigned char buffer[4 * sizeof(int)];
+    auto block = memory_block(buffer, sizeof(buffer));
+
+    SECTION("uses the buffer")
+    {
+        test_array a(make_args(block));
+        REQUIRE(a.capacity() == 4u);
+
+        for (auto i = 0; i != 4; ++i)
+            a.push_back(i);
+        REQUIRE(is_in(a, block));
+        REQUIRE(a.capacity() == 4u);
+
+        // falls back to the big storage
+        a.push_back(4);
+        REQUIRE(!is_in(a, block));
+        REQUIRE(a.size() == 5u);
+        for (auto i = 0; i != 5; ++i)
+            REQUIRE(a[size_type(i)] == i);
+
+        // and back into the buffer
+        a.pop_back();
+        a.shrink_to_fit();
+        REQUIRE(is_in(a, block));
+        REQUIRE(a.capacity() == 4u);
+        for (auto i = 0; i != 4; ++i)
+            REQUIRE(a[size_type(i)] == i);
+    }
+    SECTION("copy and move")
+    {
+        test_array a(make_args(block));
+        a.push_back(0);
+        a.push_back(1);
+
+        // copy does not share the buffer
+        test_array copy(a);
+        REQUIRE(!is_in(copy, block));
+        REQUIRE(copy.size() == 2u);
+
+        // move transfers the buffer
+        test_array moved(std::move(a));
+        REQUIRE(is_in(moved, block));
+        REQUIRE(moved.size() == 2u);
+        REQUIRE(a.empty());
+        a.push_back(2);
+        REQUIRE(!is_in(a, block));
+        REQUIRE(moved[0u] == 0);
+        REQUIRE(moved[1u] == 1);
+
+        swap(moved, copy);
+        REQUIRE(is_in(copy, block));
+        REQUIRE(!is_in(moved, block));
+        REQUIRE(copy[1u] == 1);
+        REQUIRE(moved[1u] == 1);
+
+        // the buffer follows a move assignment as well,
+        // even to a container that never got it
+        test_array assigned;
+        assigned = std::move(copy);
+        REQUIRE(is_in(assigned, block));
+        REQUIRE(!is_in(copy, block));
+        REQUIRE(assigned.size() == 2u);
+
+        // the moved-from container doesn't get the buffer back
+        copy.push_back(3);
+        REQUIRE(!is_in(copy, block));
+        REQUIRE(is_in(assigned, block));
+    }
+}
@@ -0,0 +1,139 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/block_storage_instrumented.hpp>
+
+#include <catch.hpp>
+
+#include <foonathan/array/array.hpp>
+#include <foonathan/array/block_storage_heap_sbo.hpp>
+#include <foonathan/array/block_storage_new.hpp>
+
+#include "block_storage_algorithm.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    struct algorithm_tag
+    {
+    };
+    struct counting_tag
+    {
+    };
+    struct sbo_tag
+    {
+    };
+
+    std::size_t             callback_count = 0u;
+    block_storage_operation last_operation;
+
+    void record_event(const block_storage_event& event)
+    {
+        ++callback_count;
+        last_operation = event.operation;
+    }
+} // namespace
+
+TEST_CASE("block_storage_instrumented", "[BlockStorage]")
+{
+    REQUIRE(sizeof(block_storage_instrumented<block_storage_new<>, counting_sink<>>)
+            == sizeof(block_storage_new<>));
+    REQUIRE((std::is_same<maybe_instrumented<block_storage_new<>, counting_sink<>>,
+                          block_storage_new<>>::value));
+
+    test::test_block_storage_algorithm<
+        block_storage_instrumented<block_storage_new<>, counting_sink<algorithm_tag>>>({});
+    REQUIRE(counting_sink<algorithm_tag>::statistics().reserve_calls > 0u);
+
+    SECTION("counting_sink")
+    {
+        using sink = counting_sink<counting_tag>;
+        sink::reset();
+        {
+            array<int, block_storage_instrumented<block_storage_new<no_extra_growth>, sink>> a;
+            a.push_back(0);
+            a.push_back(1);
+            a.push_back(2);
+
+            auto stats = sink::statistics();
+            REQUIRE(stats.reserve_calls == 3u);
+            REQUIRE(stats.shrink_calls == 0u);
+            REQUIRE(stats.allocated_bytes == 6u * sizeof(int));
+            REQUIRE(stats.freed_bytes == 3u * sizeof(int));
+            REQUIRE(stats.relocated_objects == 3u);
+            REQUIRE(stats.relocated_bytes == 3u * sizeof(int));
+            REQUIRE(stats.peak_capacity == 3u * sizeof(int));
+            REQUIRE(stats.peak_wasted_bytes == sizeof(int));
+
+            a.reserve(10u);
+            a.shrink_to_fit();
+            stats = sink::statistics();
+            REQUIRE(stats.reserve_calls == 4u);
+            REQUIRE(stats.shrink_calls == 1u);
+            REQUIRE(stats.peak_capacity == 10u * sizeof(int));
+            REQUIRE(stats.peak_wasted_bytes == 7u * sizeof(int));
+        }
+        auto stats = sink::statistics();
+        REQUIRE(stats.allocated_bytes == stats.freed_bytes);
+
+        sink::reset();
+        REQUIRE(sink::statistics().reserve_calls == 0u);
+    }
+    SECTION("sbo")
+    {
+        using sink    = counting_sink<sbo_tag>;
+        using storage = block_storage_heap_sbo<4u * sizeof(int), new_heap, no_extra_growth>;
+        sink::reset();
+        {
+            array<int, block_storage_instrumented<storage, sink>> a;
+            for (auto i = 0; i != 4; ++i)
+                a.push_back(i);
+            REQUIRE(sink::statistics().allocated_bytes == 0u);
+
+            // the small buffer is not freed
+            a.push_back(4);
+            REQUIRE(sink::statistics().allocated_bytes > 0u);
+            REQUIRE(sink::statistics().freed_bytes == 0u);
+        }
+        REQUIRE(sink::statistics().allocated_bytes == sink::statistics().freed_bytes);
+    }
+    SECTION("histogram_sink")
+    {
+        using sink = histogram_sink<void>;
+        REQUIRE(sink::bucket_of(0u) == 0u);
+        REQUIRE(sink::bucket_of(1u) == 1u);
+        REQUIRE(sink::bucket_of(4u) == 3u);
+        REQUIRE(sink::bucket_of(7u) == 3u);
+
+        sink::reset();
+        array<char, block_storage_instrumented<block_storage_new<no_extra_growth>, sink>> a;
+        a.reserve(4u);
+        a.reserve(7u);
+        a.reserve(64u);
+        REQUIRE(sink::local().buckets[3u] == 2u);
+        REQUIRE(sink::local().buckets[7u] == 1u);
+    }
+    SECTION("callback_sink")
+    {
+        using sink = callback_sink<void>;
+        callback_count = 0u;
+
+        array<char, block_storage_instrumented<block_storage_new<>, sink>> a;
+        a.push_back('a');
+        REQUIRE(callback_count == 0u);
+
+        sink::set_callback(&record_event);
+        a.push_back('b');
+        REQUIRE(callback_count == 1u);
+        REQUIRE(last_operation == block_storage_operation::reserve);
+        a.shrink_to_fit();
+        REQUIRE(callback_count == 2u);
+        REQUIRE(last_operation == block_storage_operation::shrink_to_fit);
+
+        sink::set_callback(nullptr);
+        a.push_back('c');
+        REQUIRE(callback_count == 2u);
+    }
+}
@@ -0,0 +1,72 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/block_storage_malloc.hpp>
+
+#include <catch.hpp>
+
+#include <foonathan/array/array.hpp>
+
+#include "block_storage_algorithm.hpp"
+
+using namespace foonathan::array;
+
+TEST_CASE("block_storage_malloc", "[BlockStorage]")
+{
+    REQUIRE(sizeof(block_storage_malloc<default_growth>) == sizeof(memory_block));
+
+    test::test_block_storage_algorithm<block_storage_malloc<default_growth>>({});
+    test::test_block_storage_algorithm<block_storage_malloc<no_extra_growth>>({});
+    test::test_block_storage_algorithm<block_storage_malloc<size_class_growth<>>>({});
+
+    SECTION("usable size")
+    {
+        array<char, block_storage_malloc<no_extra_growth>> a;
+        a.push_back('a');
+        REQUIRE(a.capacity() >= 1u);
+
+        // no reallocation while there is usable capacity left
+        auto data     = iterator_to_pointer(a.begin());
+        auto capacity = a.capacity();
+        while (a.size() < capacity)
+            a.push_back('b');
+        REQUIRE(iterator_to_pointer(a.begin()) == data);
+        REQUIRE(a.capacity() == capacity);
+    }
+    SECTION("shrink with realloc")
+    {
+        // realloc() may or may not move the block, the elements have to be there either way
+        array<int, block_storage_malloc<no_extra_growth>> a;
+        a.reserve(1024u);
+        for (auto i = 0; i != 16; ++i)
+            a.push_back(i);
+
+        a.shrink_to_fit();
+        REQUIRE(a.size() == 16u);
+        REQUIRE(a.capacity() >= 16u);
+        REQUIRE(a.capacity() < 1024u);
+        for (auto i = 0; i != 16; ++i)
+            REQUIRE(a[size_type(i)] == i);
+
+        // no change
+        auto data = iterator_to_pointer(a.begin());
+        a.shrink_to_fit();
+        REQUIRE(iterator_to_pointer(a.begin()) == data);
+
+        a.clear();
+        a.shrink_to_fit();
+        REQUIRE(a.capacity() == 0u);
+    }
+    SECTION("hysteresis")
+    {
+        array<int, block_storage_malloc<shrink_hysteresis<no_extra_growth>>> a;
+        a.reserve(100u);
+        auto capacity = a.capacity();
+        for (auto i = 0; i != 90; ++i)
+            a.push_back(i);
+
+        a.shrink_to_fit();
+        REQUIRE(a.capacity() == capacity);
+    }
+}
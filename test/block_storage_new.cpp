@@ -17,4 +17,12 @@ TEST_CASE("block_storage_new", "[BlockStorage]")
 
     test::test_block_storage_algorithm<block_storage_new<default_growth>>({});
     test::test_block_storage_algorithm<block_storage_new<no_extra_growth>>({});
+    test::test_block_storage_algorithm<block_storage_new<size_class_growth<>>>({});
+
+    REQUIRE(sizeof(block_storage_new<decaying_growth>)
+            == sizeof(memory_block) + sizeof(decaying_growth_config));
+    decaying_growth_config config;
+    config.small_limit = 32u;
+    test::test_block_storage_algorithm<block_storage_new<decaying_growth>>(
+        block_storage_args(new_heap::handle_type{}, config));
 }
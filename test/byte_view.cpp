@@ -29,4 +29,10 @@ TEST_CASE("byte_view")
     auto block_view = reinterpret_block<std::int8_t>(bytes);
     REQUIRE((static_cast<void*>(block_view.data()) == array));
     REQUIRE(block_view.size() == 3u);
+
+    const std::uint16_t const_array[] = {0, 1};
+
+    auto const_bytes = byte_view(make_array_view(const_array));
+    REQUIRE((static_cast<const void*>(const_bytes.data()) == const_array));
+    REQUIRE(const_bytes.size() == 2u * sizeof(std::uint16_t));
 }
@@ -0,0 +1,146 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/chunked_reader.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "leak_checker.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    struct test_type : leak_tracked
+    {
+        int id;
+
+        test_type(int i) : id(i) {}
+    };
+
+    // reads at most 7 bytes at a time, like a pipe
+    struct short_reads
+    {
+        const std::vector<std::uint32_t>* input;
+        size_type                         offset, end;
+
+        short_reads(const std::vector<std::uint32_t>& input, size_type end_bytes)
+        : input(&input), offset(0u), end(end_bytes)
+        {
+        }
+
+        size_type operator()(byte* data, size_type size)
+        {
+            auto n = std::min({size, size_type(7u), end - offset});
+            std::memcpy(data, reinterpret_cast<const byte*>(input->data()) + offset, n);
+            offset += n;
+            return n;
+        }
+    };
+
+    // creates the objects [0, count)
+    template <typename T>
+    struct generator
+    {
+        int count, next;
+
+        void operator()(partially_constructed_range<T>& range, size_type n)
+        {
+            for (auto i = size_type(0); i != n && next != count; ++i)
+                range.construct_object(next++);
+        }
+    };
+} // namespace
+
+TEST_CASE("read_chunked", "[chunked_reader]")
+{
+    std::vector<std::uint32_t> input;
+    for (auto i = 0u; i != 1000u; ++i)
+        input.push_back(i * 7u);
+
+    array<std::uint32_t> arr;
+    arr.push_back(42u);
+
+    auto source = make_byte_chunk_source<std::uint32_t>(short_reads(input, 4000u));
+    REQUIRE(read_chunked(arr, source, 64u) == 1000u);
+    REQUIRE(arr.size() == 1001u);
+    REQUIRE(arr[0] == 42u);
+    REQUIRE(std::equal(input.begin(), input.end(), arr.begin() + 1));
+
+    SECTION("ends in the middle of an object")
+    {
+        arr.clear();
+        auto partial = make_byte_chunk_source<std::uint32_t>(short_reads(input, 1001u));
+        REQUIRE_THROWS_AS(read_chunked(arr, partial, 100u), serialization_error);
+        // the first two chunks are complete
+        REQUIRE(arr.size() == 200u);
+        REQUIRE(std::equal(arr.begin(), arr.end(), input.begin()));
+    }
+    SECTION("read error")
+    {
+        arr.clear();
+        // like ::read() on a bad file descriptor
+        auto failing =
+            make_byte_chunk_source<std::uint32_t>([](byte*, size_type) -> long { return -1; });
+        REQUIRE_THROWS_AS(read_chunked(arr, failing, 100u), serialization_error);
+        REQUIRE(arr.empty());
+    }
+    SECTION("bag")
+    {
+        leak_checker checker;
+
+        bag<test_type> b;
+        REQUIRE(read_chunked(b, generator<test_type>{100, 0}, 32u) == 100u);
+        REQUIRE(b.size() == 100u);
+
+        auto sum = 0;
+        for (auto& element : b)
+            sum += element.id;
+        REQUIRE(sum == 99 * 100 / 2);
+    }
+}
+
+TEST_CASE("read_chunked_double_buffered", "[chunked_reader]")
+{
+    // the objects are created on the worker thread,
+    // so they can't be leak tracked
+    std::vector<int> ids;
+    auto             total = read_chunked_double_buffered<int>(
+        generator<int>{1000, 0}, 64u, [&](array_view<int> chunk) {
+            REQUIRE(chunk.size() <= 64u);
+            ids.insert(ids.end(), chunk.begin(), chunk.end());
+        });
+    REQUIRE(total == 1000u);
+    REQUIRE(ids.size() == 1000u);
+    for (auto i = 0u; i != ids.size(); ++i)
+        REQUIRE(ids[i] == int(i));
+
+    SECTION("exception while processing")
+    {
+        auto chunks  = 0;
+        auto process = [&](array_view<int>) {
+            if (++chunks == 3)
+                throw std::runtime_error("error");
+        };
+        REQUIRE_THROWS_AS(read_chunked_double_buffered<int>(generator<int>{1000, 0}, 64u, process),
+                          std::runtime_error);
+        REQUIRE(chunks == 3);
+    }
+    SECTION("exception while reading")
+    {
+        std::vector<std::uint32_t> input(100u, 1u);
+
+        auto chunks  = 0;
+        auto partial = make_byte_chunk_source<std::uint32_t>(short_reads(input, 398u));
+        REQUIRE_THROWS_AS(read_chunked_double_buffered<std::uint32_t>(
+                              partial, 16u, [&](array_view<std::uint32_t>) { ++chunks; }),
+                          serialization_error);
+        REQUIRE(chunks == 6);
+    }
+}
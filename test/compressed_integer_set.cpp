@@ -0,0 +1,169 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/compressed_integer_set.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <foonathan/array/block_storage_sbo.hpp>
+#include <foonathan/array/flat_set.hpp>
+
+using namespace foonathan::array;
+
+namespace
+{
+    template <class Set, typename T>
+    void verify_set(const Set& set, const std::vector<T>& keys)
+    {
+        REQUIRE(set.empty() == keys.empty());
+        REQUIRE(set.size() == keys.size());
+        REQUIRE(set.block_count() == (keys.size() + Set::block_size - 1u) / Set::block_size);
+        REQUIRE(std::equal(set.begin(), set.end(), keys.begin()));
+        REQUIRE(size_type(std::distance(set.begin(), set.end())) == keys.size());
+
+        std::vector<T> decoded;
+        set.decode(std::back_inserter(decoded));
+        REQUIRE(decoded == keys);
+
+        if (!keys.empty())
+        {
+            REQUIRE(set.min() == keys.front());
+            REQUIRE(set.max() == keys.back());
+        }
+
+        for (auto key : keys)
+        {
+            REQUIRE(set.contains(key));
+            REQUIRE(set.count(key) == 1u);
+            REQUIRE(*set.lower_bound(key) == key);
+
+            // the next integer may or may not be in the set
+            auto next = T(key + 1u);
+            auto iter = std::lower_bound(keys.begin(), keys.end(), next);
+            REQUIRE(set.contains(next) == (iter != keys.end() && *iter == next));
+            if (iter == keys.end())
+                REQUIRE(set.lower_bound(next) == set.end());
+            else
+                REQUIRE(*set.lower_bound(next) == *iter);
+        }
+    }
+
+    template <typename T>
+    std::vector<T> make_keys(std::size_t size, T max_gap, std::uint32_t seed)
+    {
+        std::mt19937_64                  engine(seed);
+        std::uniform_int_distribution<T> dist(1u, max_gap);
+
+        std::vector<T> result;
+        auto           cur = T(dist(engine));
+        for (auto i = 0u; i != size; ++i, cur = T(cur + dist(engine)))
+            result.push_back(cur);
+        return result;
+    }
+
+    template <typename T>
+    compressed_integer_set<T> make_set(const std::vector<T>& keys)
+    {
+        return compressed_integer_set<T>(make_sorted_view(keys.data(), keys.size()));
+    }
+} // namespace
+
+TEST_CASE("compressed_integer_set", "[container]")
+{
+    compressed_integer_set<std::uint32_t> empty;
+    verify_set(empty, std::vector<std::uint32_t>{});
+    REQUIRE(!empty.contains(0u));
+    REQUIRE(empty.lower_bound(0u) == empty.end());
+
+    SECTION("dense")
+    {
+        auto keys = make_keys<std::uint32_t>(1000u, 3u, 1u);
+        auto set  = make_set(keys);
+        verify_set(set, keys);
+        REQUIRE(set.memory_size() < keys.size() * sizeof(std::uint32_t) / 2u);
+        REQUIRE(!set.contains(0u));
+        REQUIRE(*set.lower_bound(0u) == keys.front());
+    }
+    SECTION("sparse")
+    {
+        auto keys = make_keys<std::uint32_t>(1000u, 1u << 20, 2u);
+        verify_set(make_set(keys), keys);
+    }
+    SECTION("consecutive")
+    {
+        // same base and offset per block
+        std::vector<std::uint8_t> keys = {0u, 255u};
+        verify_set(make_set(keys), keys);
+
+        keys.clear();
+        keys.push_back(42u);
+        verify_set(make_set(keys), keys);
+    }
+    SECTION("64 bit")
+    {
+        auto keys = make_keys<std::uint64_t>(300u, std::uint64_t(1) << 54, 3u);
+        verify_set(make_set(keys), keys);
+
+        keys = {0u, ~std::uint64_t(0)};
+        verify_set(make_set(keys), keys);
+    }
+    SECTION("flat_set")
+    {
+        flat_multiset<std::uint16_t> multiset;
+        for (auto i = 0u; i != 500u; ++i)
+            multiset.insert(std::uint16_t(i * 7u % 256u));
+
+        compressed_integer_set<std::uint16_t,
+                               block_storage_sbo<256, block_storage_new<default_growth>>>
+            set(multiset);
+
+        std::vector<std::uint16_t> keys;
+        std::unique_copy(multiset.begin(), multiset.end(), std::back_inserter(keys));
+        verify_set(set, keys);
+
+        auto other = std::move(set);
+        verify_set(other, keys);
+        verify_set(set, std::vector<std::uint16_t>{});
+
+        swap(set, other);
+        verify_set(set, keys);
+        set.clear();
+        verify_set(set, std::vector<std::uint16_t>{});
+    }
+}
+
+TEST_CASE("compressed_integer_set intersection", "[container]")
+{
+    auto a = make_keys<std::uint32_t>(2000u, 10u, 4u);
+    auto b = make_keys<std::uint32_t>(3000u, 7u, 5u);
+    // some keys far away to skip blocks
+    b.push_back(b.back() + 100000u);
+
+    std::vector<std::uint32_t> expected;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    REQUIRE(!expected.empty());
+
+    auto set_a = make_set(a);
+    auto set_b = make_set(b);
+
+    std::vector<std::uint32_t> result;
+    set_a.intersection(set_b, std::back_inserter(result));
+    REQUIRE(result == expected);
+
+    result.clear();
+    set_b.intersection(set_a, std::back_inserter(result));
+    REQUIRE(result == expected);
+
+    result.clear();
+    set_a.intersection(make_sorted_view(b.data(), b.size()), std::back_inserter(result));
+    REQUIRE(result == expected);
+
+    result.clear();
+    set_a.intersection(compressed_integer_set<std::uint32_t>(), std::back_inserter(result));
+    REQUIRE(result.empty());
+}
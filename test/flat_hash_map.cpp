@@ -0,0 +1,187 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/flat_hash_map.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <foonathan/array/block_storage_sbo.hpp>
+
+using namespace foonathan::array;
+
+namespace
+{
+    using test_map     = flat_hash_map<int, std::string>;
+    using test_sbo_map = flat_hash_map<int, std::string, key_hash_default,
+                                       block_storage_sbo<512, block_storage_new<default_growth>>>;
+
+    template <class Map>
+    void verify_map_impl(Map& map, std::vector<std::pair<int, std::string>> pairs)
+    {
+        REQUIRE(map.empty() == (map.size() == 0u));
+        REQUIRE(map.size() == pairs.size());
+        REQUIRE(map.capacity() >= map.size());
+        REQUIRE(map.capacity() <= map.max_size());
+
+        std::vector<std::pair<int, std::string>> elements;
+        for (auto pair : map)
+            elements.emplace_back(pair.key, pair.value);
+        std::sort(elements.begin(), elements.end());
+        std::sort(pairs.begin(), pairs.end());
+        REQUIRE(elements == pairs);
+
+        for (auto& pair : pairs)
+        {
+            REQUIRE(map.contains(pair.first));
+            REQUIRE(map.count(pair.first) == 1u);
+
+            auto ptr = map.try_lookup(pair.first);
+            REQUIRE(ptr);
+            REQUIRE(*ptr == pair.second);
+            REQUIRE(&map.lookup(pair.first) == ptr);
+            REQUIRE(&map.find(pair.first)->value == ptr);
+            REQUIRE(map.find(pair.first)->key == pair.first);
+        }
+    }
+
+    template <class Map>
+    void verify_map(const Map& map, std::vector<std::pair<int, std::string>> pairs)
+    {
+        verify_map_impl(map, pairs);
+        verify_map_impl(const_cast<Map&>(map), pairs); // to test non-const overloads
+
+        // copy constructor
+        Map copy(map);
+        verify_map_impl(copy, pairs);
+
+        // shrink to fit
+        copy.shrink_to_fit();
+        verify_map_impl(copy, pairs);
+
+        // copy assignment
+        copy.insert(0xFFFF, "");
+        copy = map;
+        verify_map_impl(copy, pairs);
+
+        // pair range assignment
+        copy.insert(0xFFFF, "");
+        copy.assign_pair_range(map.begin(), map.end());
+        verify_map_impl(copy, pairs);
+    }
+
+    template <class Map>
+    void test_hash_map()
+    {
+        Map map;
+        verify_map(map, {});
+        REQUIRE(!map.contains(0));
+        REQUIRE(map.try_lookup(0) == nullptr);
+        REQUIRE(map.find(0) == map.end());
+
+        auto result = map.try_emplace(1, "a");
+        REQUIRE(result.was_inserted());
+        REQUIRE(result.iter()->key == 1);
+        REQUIRE(result.iter()->value == "a");
+
+        result = map.insert(2, "b");
+        REQUIRE(result.was_inserted());
+        result = map.insert_pair(std::make_pair(3, "c"));
+        REQUIRE(result.was_inserted());
+        verify_map(map, {{1, "a"}, {2, "b"}, {3, "c"}});
+
+        SECTION("duplicate insert")
+        {
+            result = map.insert(1, "A");
+            REQUIRE(result.was_duplicate());
+            REQUIRE(result.iter()->value == "a");
+            verify_map(map, {{1, "a"}, {2, "b"}, {3, "c"}});
+
+            result = map.insert_or_assign(1, "A");
+            REQUIRE(result.was_duplicate());
+            REQUIRE(result.iter()->value == "A");
+
+            result = map.emplace_or_assign(2, 3u, 'B');
+            REQUIRE(result.was_duplicate());
+            verify_map(map, {{1, "A"}, {2, "BBB"}, {3, "c"}});
+        }
+        SECTION("modify")
+        {
+            map.lookup(1) = "A";
+            map.find(2)->value += "b";
+            map.begin()->value += "!";
+            verify_map(map, {{1, map.lookup(1)}, {2, map.lookup(2)}, {3, map.lookup(3)}});
+            REQUIRE(map.lookup(2).substr(0, 2) == "bb");
+        }
+        SECTION("erase")
+        {
+            auto next = map.erase(map.find(2));
+            REQUIRE((next == map.end() || next->key != 2));
+            REQUIRE(!map.erase_all(2));
+            REQUIRE(map.erase_all(3));
+            verify_map(map, {{1, "a"}});
+
+            map.clear();
+            verify_map(map, {});
+        }
+        SECTION("rehash")
+        {
+            std::vector<std::pair<int, std::string>> pairs;
+            for (auto i = 0; i != 500; ++i)
+                pairs.emplace_back(i * 7, std::to_string(i));
+
+            map.clear();
+            map.insert_pair_range(pairs.begin(), pairs.end());
+            verify_map(map, pairs);
+
+            Map other(std::move(map));
+            verify_map(other, pairs);
+            verify_map(map, {});
+
+            map.insert(0, "0");
+            swap(map, other);
+            verify_map(map, pairs);
+            verify_map(other, {{0, "0"}});
+        }
+    }
+} // namespace
+
+TEST_CASE("flat_hash_map", "[container]")
+{
+    test_hash_map<test_map>();
+}
+
+TEST_CASE("flat_hash_map sbo", "[container]")
+{
+    test_hash_map<test_sbo_map>();
+}
+
+TEST_CASE("flat_hash_map input_view", "[container]")
+{
+    using pair = key_value_pair<int, std::string>;
+
+    array<pair> pairs;
+    pairs.emplace_back(1, "a");
+    pairs.emplace_back(2, "b");
+    pairs.emplace_back(1, "c");
+
+    test_map map(std::move(pairs));
+    verify_map(map, {{1, "a"}, {2, "b"}});
+}
+
+TEST_CASE("flat_hash_map transparent", "[container]")
+{
+    flat_hash_map<std::string, int> map;
+    map.insert("a", 1);
+    map.try_emplace(std::string("bc"), 2);
+
+    REQUIRE(map.lookup("a") == 1);
+    REQUIRE(*map.try_lookup("bc") == 2);
+    REQUIRE(map.try_lookup("b") == nullptr);
+    REQUIRE(map.erase_all("a"));
+    REQUIRE(map.size() == 1u);
+}
@@ -0,0 +1,307 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/flat_hash_set.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <foonathan/array/array.hpp>
+#include <foonathan/array/block_storage_sbo.hpp>
+
+#include "leak_checker.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    struct test_type : leak_tracked
+    {
+        std::uint16_t id;
+
+        test_type(int i) : id(static_cast<std::uint16_t>(i)) {}
+    };
+} // namespace
+
+namespace foonathan
+{
+    namespace array
+    {
+        template <>
+        struct key_hash_default::customize_for<test_type>
+        {
+            // a bad hash, so there are a lot of collisions
+            static std::size_t hash(const test_type& test)
+            {
+                return hash(int(test.id));
+            }
+            static std::size_t hash(int i)
+            {
+                return std::size_t(i % 7);
+            }
+
+            static bool equal(const test_type& test, const test_type& other) noexcept
+            {
+                return test.id == other.id;
+            }
+            static bool equal(const test_type& test, int i) noexcept
+            {
+                return test.id == i;
+            }
+        };
+    } // namespace array
+} // namespace foonathan
+
+namespace
+{
+    using test_set     = flat_hash_set<test_type>;
+    using test_sbo_set = flat_hash_set<test_type, key_hash_default,
+                                       block_storage_sbo<256, block_storage_new<default_growth>>>;
+
+    template <class Set>
+    void verify_set_impl(const Set& set, std::vector<int> ids)
+    {
+        REQUIRE(set.empty() == (set.size() == 0u));
+        REQUIRE(set.size() == ids.size());
+        REQUIRE(set.capacity() >= set.size());
+        REQUIRE(set.capacity() <= set.max_size());
+
+        std::vector<int> elements;
+        for (auto& element : set)
+            elements.push_back(element.id);
+        REQUIRE(size_type(std::distance(set.cbegin(), set.cend())) == set.size());
+
+        std::sort(elements.begin(), elements.end());
+        std::sort(ids.begin(), ids.end());
+        REQUIRE(elements == ids);
+
+        for (auto id : ids)
+        {
+            REQUIRE(set.contains(id));
+            REQUIRE(set.count(id) == 1u);
+
+            auto ptr = set.try_lookup(id);
+            REQUIRE(ptr);
+            REQUIRE(ptr->id == id);
+            REQUIRE(&set.lookup(id) == ptr);
+            REQUIRE(&*set.find(id) == ptr);
+            REQUIRE(&*set.find(test_type(id)) == ptr);
+        }
+    }
+
+    template <class Set>
+    void verify_set(const Set& set, std::vector<int> ids)
+    {
+        verify_set_impl(set, ids);
+
+        // copy constructor
+        Set copy(set);
+        verify_set_impl(copy, ids);
+
+        // shrink to fit
+        auto old_cap = copy.capacity();
+        copy.shrink_to_fit();
+        verify_set_impl(copy, ids);
+        REQUIRE(copy.capacity() <= old_cap);
+
+        // reserve
+        copy.reserve(copy.size() + 4u);
+        REQUIRE(copy.capacity() >= copy.size() + 4u);
+        verify_set_impl(copy, ids);
+
+        // copy assignment
+        copy.insert(0xFFFF);
+        copy = set;
+        verify_set_impl(copy, ids);
+
+        // range assignment
+        copy.insert(0xFFFF);
+        copy.assign_range(set.begin(), set.end());
+        verify_set_impl(copy, ids);
+    }
+
+    std::vector<int> make_ids(int begin, int end, int step = 1)
+    {
+        std::vector<int> result;
+        for (auto i = begin; i < end; i += step)
+            result.push_back(i);
+        return result;
+    }
+
+    template <class Set>
+    void test_hash_set()
+    {
+        leak_checker checker;
+
+        Set set;
+        verify_set(set, {});
+        REQUIRE(!set.contains(0));
+        REQUIRE(set.try_lookup(0) == nullptr);
+        REQUIRE(set.find(0) == set.end());
+        REQUIRE(set.count(0) == 0u);
+
+        SECTION("insertion")
+        {
+            auto result = set.try_emplace(0xF0F0);
+            REQUIRE(result.was_inserted());
+            REQUIRE(!result.was_duplicate());
+            REQUIRE(result.iter()->id == 0xF0F0);
+            verify_set(set, {0xF0F0});
+
+            result = set.insert(test_type(0xF3F3));
+            REQUIRE(result.was_inserted());
+            REQUIRE(result.iter()->id == 0xF3F3);
+            verify_set(set, {0xF0F0, 0xF3F3});
+
+            result = set.insert(0xF0F0);
+            REQUIRE(!result.was_inserted());
+            REQUIRE(result.was_duplicate());
+            REQUIRE(result.iter()->id == 0xF0F0);
+            REQUIRE(result.iter() == set.find(0xF0F0));
+            verify_set(set, {0xF0F0, 0xF3F3});
+
+            test_type tests[] = {0xF4F4, 0xF5F5, 0xF0F0};
+            set.insert(tests);
+            verify_set(set, {0xF0F0, 0xF3F3, 0xF4F4, 0xF5F5});
+
+            set.insert_range(std::begin(tests), std::end(tests));
+            verify_set(set, {0xF0F0, 0xF3F3, 0xF4F4, 0xF5F5});
+        }
+        SECTION("rehash")
+        {
+            auto ids = make_ids(0, 1000);
+            for (auto id : ids)
+                REQUIRE(set.insert(id).was_inserted());
+            verify_set(set, ids);
+
+            set.clear();
+            verify_set(set, {});
+            REQUIRE(set.capacity() >= 1000u);
+
+            set.reserve(2000u);
+            REQUIRE(set.capacity() >= 2000u);
+            set.insert_range(ids.begin(), ids.end());
+            verify_set(set, ids);
+
+            set.clear();
+            set.shrink_to_fit();
+            REQUIRE(set.capacity() == 0u);
+            verify_set(set, {});
+        }
+        SECTION("erase")
+        {
+            auto ids = make_ids(0, 200);
+            set.insert_range(ids.begin(), ids.end());
+
+            // erase all odd ones using iterators
+            for (auto iter = set.begin(); iter != set.end();)
+            {
+                if (iter->id % 2 == 1)
+                    iter = set.erase(iter);
+                else
+                    ++iter;
+            }
+            verify_set(set, make_ids(0, 200, 2));
+
+            // erase some even ones using the key
+            for (auto id : make_ids(0, 100, 2))
+                REQUIRE(set.erase_all(id));
+            REQUIRE(!set.erase_all(0));
+            verify_set(set, make_ids(100, 200, 2));
+
+            // reuse the tombstones, at most 150 elements are in the set at a time
+            for (auto round = 0; round != 10; ++round)
+            {
+                for (auto id : make_ids(0, 100))
+                    REQUIRE(set.insert(id).was_inserted());
+                for (auto id : make_ids(0, 100))
+                    REQUIRE(set.erase_all(id));
+                REQUIRE(set.capacity() < 512u);
+            }
+            verify_set(set, make_ids(100, 200, 2));
+        }
+        SECTION("move")
+        {
+            auto ids = make_ids(0, 50);
+            set.insert_range(ids.begin(), ids.end());
+
+            Set other(std::move(set));
+            verify_set(other, ids);
+            verify_set(set, {});
+
+            set.insert(0xF0F0);
+            swap(set, other);
+            verify_set(set, ids);
+            verify_set(other, {0xF0F0});
+
+            other = std::move(set);
+            verify_set(other, ids);
+        }
+    }
+} // namespace
+
+TEST_CASE("flat_hash_set", "[container]")
+{
+    test_hash_set<test_set>();
+}
+
+TEST_CASE("flat_hash_set sbo", "[container]")
+{
+    test_hash_set<test_sbo_set>();
+
+    SECTION("small")
+    {
+        test_sbo_set set;
+        set.insert(0xF0F0);
+        set.insert(0xF1F1);
+
+        auto         ids = make_ids(0, 100);
+        test_sbo_set big;
+        big.insert_range(ids.begin(), ids.end());
+
+        swap(set, big);
+        verify_set(set, ids);
+        verify_set(big, {0xF0F0, 0xF1F1});
+    }
+}
+
+TEST_CASE("flat_hash_set input_view", "[container]")
+{
+    leak_checker checker;
+
+    SECTION("move")
+    {
+        array<test_type> elements;
+        for (auto id : {0xF0F0, 0xF1F1, 0xF2F2, 0xF0F0})
+            elements.push_back(id);
+
+        test_set set(std::move(elements));
+        verify_set(set, {0xF0F0, 0xF1F1, 0xF2F2});
+    }
+    SECTION("copy")
+    {
+        test_type elements[] = {0xF0F0, 0xF1F1, 0xF2F2};
+
+        test_set set;
+        set.insert(0xF3F3);
+        set = input_view<test_type, block_storage_default>(block_view<const test_type>(elements));
+        verify_set(set, {0xF0F0, 0xF1F1, 0xF2F2});
+    }
+}
+
+TEST_CASE("flat_hash_set transparent", "[container]")
+{
+    flat_hash_set<std::string> set;
+    set.insert("hello");
+    set.insert(std::string("world"));
+    REQUIRE(set.size() == 2u);
+
+    REQUIRE(set.contains("hello"));
+    REQUIRE(set.lookup("world") == "world");
+    REQUIRE(!set.contains("hello world"));
+    REQUIRE(set.erase_all("hello"));
+    REQUIRE(!set.contains("hello"));
+}
@@ -37,15 +37,60 @@ namespace
 
     using test_map = flat_map<test_type, std::string>;
 
-    template <class Map>
-    void verify_map_impl(Map& map, std::initializer_list<int> ids,
-                         std::initializer_list<std::string> strs)
+    // a value whose move assignment throws once it is armed
+    struct throwing_value
     {
-        REQUIRE(map.empty() == (map.size() == 0u));
-        REQUIRE(map.size() == size_type(ids.end() - ids.begin()));
-        REQUIRE(map.capacity() >= map.size());
-        REQUIRE(map.capacity() <= map.max_size());
+        static bool armed;
+
+        int id;
+
+        throwing_value(int i) : id(i) {}
 
+        throwing_value(const throwing_value&) = default;
+        throwing_value(throwing_value&&)      = default;
+
+        throwing_value& operator=(const throwing_value&) = default;
+        throwing_value& operator=(throwing_value&& other)
+        {
+            if (armed)
+            {
+                armed = false;
+                throw 42;
+            }
+            id = other.id;
+            return *this;
+        }
+    };
+
+    bool throwing_value::armed = false;
+
+    template <class Layout>
+    void test_throwing_value()
+    {
+        flat_map<int, throwing_value, key_compare_default, block_storage_default, false, Layout>
+            map;
+        for (auto i = 0; i != 4; ++i)
+            map.insert(i, i);
+
+        // moving the value of 1 to the front throws
+        REQUIRE_THROWS_AS(map.erase_if([](typename decltype(map)::iterator::value_type pair) {
+            throwing_value::armed = true;
+            return pair.key == 0;
+        }),
+                          int);
+        throwing_value::armed = false;
+
+        REQUIRE(map.size() == 2u);
+        REQUIRE(!map.contains(0));
+        REQUIRE(!map.contains(1));
+        REQUIRE(map.lookup(2).id == 2);
+        REQUIRE(map.lookup(3).id == 3);
+    }
+
+    template <class Map, class Layout>
+    void verify_views(Map& map, std::initializer_list<int> ids,
+                      std::initializer_list<std::string> strs, Layout)
+    {
         auto keys = map.keys();
         REQUIRE(keys.size() == map.size());
         REQUIRE(keys.data() == iterator_to_pointer(map.key_begin()));
@@ -66,6 +111,32 @@ namespace
                     [](const std::string& test, const std::string& str) { return test == str; },
                     [&](const std::string& test) { FAIL_CHECK(test); });
 
+        REQUIRE(map.value_end() == map.value_iter(map.end()));
+        REQUIRE(map.value_end() == map.value_iter(map.key_end()));
+        REQUIRE(map.key_end() == map.key_iter(map.end()));
+        REQUIRE(map.key_end() == map.key_iter(map.value_end()));
+        REQUIRE(map.end() == map.key_value_iter(map.key_end()));
+        REQUIRE(map.end() == map.key_value_iter(map.value_end()));
+    }
+
+    template <class Map>
+    void verify_views(Map&, std::initializer_list<int>, std::initializer_list<std::string>,
+                      array_of_structs_layout)
+    {
+        // no separate keys and values
+    }
+
+    template <class Map>
+    void verify_map_impl(Map& map, std::initializer_list<int> ids,
+                         std::initializer_list<std::string> strs)
+    {
+        REQUIRE(map.empty() == (map.size() == 0u));
+        REQUIRE(map.size() == size_type(ids.end() - ids.begin()));
+        REQUIRE(map.capacity() >= map.size());
+        REQUIRE(map.capacity() <= map.max_size());
+
+        verify_views(map, ids, strs, typename Map::layout{});
+
         auto cur_id  = ids.begin();
         auto cur_str = strs.begin();
         for (auto pair : map)
@@ -76,13 +147,6 @@ namespace
             ++cur_str;
         }
 
-        REQUIRE(map.value_end() == map.value_iter(map.end()));
-        REQUIRE(map.value_end() == map.value_iter(map.key_end()));
-        REQUIRE(map.key_end() == map.key_iter(map.end()));
-        REQUIRE(map.key_end() == map.key_iter(map.value_end()));
-        REQUIRE(map.end() == map.key_value_iter(map.key_end()));
-        REQUIRE(map.end() == map.key_value_iter(map.value_end()));
-
         if (!map.empty())
         {
             REQUIRE(map.min().key.id == *ids.begin());
@@ -103,7 +167,7 @@ namespace
             REQUIRE(ptr);
             REQUIRE(*ptr == *cur_str);
             REQUIRE(&map.lookup(id) == ptr);
-            REQUIRE(size_type(ptr - iterator_to_pointer(map.value_begin())) == cur_index);
+            REQUIRE(&map.begin()[std::ptrdiff_t(cur_index)].value == ptr);
 
             REQUIRE(size_type(map.find(id) - map.begin()) == cur_index);
 
@@ -119,6 +183,19 @@ namespace
         }
     }
 
+    template <class Map, class Layout>
+    void assign_views(Map& copy, const Map& map, Layout)
+    {
+        copy.insert(0xFFFF, "");
+        copy.assign_range(map.key_begin(), map.key_end(), map.value_begin(), map.value_end());
+    }
+
+    template <class Map>
+    void assign_views(Map& copy, const Map& map, array_of_structs_layout)
+    {
+        copy = map;
+    }
+
     template <class Map>
     void verify_map(const Map& map, std::initializer_list<int> ids,
                     std::initializer_list<std::string> strs)
@@ -148,8 +225,7 @@ namespace
         verify_map_impl(copy, ids, strs);
 
         // range assignment
-        copy.insert(0xFFFF, "");
-        copy.assign_range(map.key_begin(), map.key_end(), map.value_begin(), map.value_end());
+        assign_views(copy, map, typename Map::layout{});
         verify_map_impl(copy, ids, strs);
 
         // pair range assignment
@@ -158,8 +234,9 @@ namespace
         verify_map_impl(copy, ids, strs);
     }
 
-    void verify_result(const test_map& map, test_map::insert_result result, int id, std::string str,
-                       std::size_t pos, bool duplicate = false)
+    template <class Map>
+    void verify_result(const Map& map, typename Map::insert_result result, int id,
+                       std::string str, std::size_t pos, bool duplicate = false)
     {
         if (duplicate)
         {
@@ -176,162 +253,388 @@ namespace
         REQUIRE(result.iter()->value == str);
         REQUIRE(std::size_t(result.iter() - map.begin()) == pos);
     }
-} // namespace
-
-TEST_CASE("flat_map", "[container]")
-{
-    leak_checker checker;
 
-    SECTION("insertion")
+    template <class Map>
+    void test_flat_map()
     {
-        test_map map;
-        verify_map(map, {}, {});
+        leak_checker checker;
 
-        // fill with non duplicates
-        auto result = map.try_emplace(0xF0F0, "a");
-        verify_result(map, result, 0xF0F0, "a", 0);
-        verify_map(map, {0xF0F0}, {"a"});
+        SECTION("insertion")
+        {
+            Map map;
+            verify_map(map, {}, {});
 
-        result = map.insert(test_type(0xF3F3), "d");
-        verify_result(map, result, 0xF3F3, "d", 1);
-        verify_map(map, {0xF0F0, 0xF3F3}, {"a", "d"});
+            // fill with non duplicates
+            auto result = map.try_emplace(0xF0F0, "a");
+            verify_result(map, result, 0xF0F0, "a", 0);
+            verify_map(map, {0xF0F0}, {"a"});
 
-        result = map.insert(0xF1F1, "b");
-        verify_result(map, result, 0xF1F1, "b", 1);
-        verify_map(map, {0xF0F0, 0xF1F1, 0xF3F3}, {"a", "b", "d"});
+            result = map.insert(test_type(0xF3F3), "d");
+            verify_result(map, result, 0xF3F3, "d", 1);
+            verify_map(map, {0xF0F0, 0xF3F3}, {"a", "d"});
 
-        result = map.insert_pair(std::make_pair(test_type(0xF2F2), "c"));
-        verify_result(map, result, 0xF2F2, "c", 2);
-        verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
+            result = map.insert(0xF1F1, "b");
+            verify_result(map, result, 0xF1F1, "b", 1);
+            verify_map(map, {0xF0F0, 0xF1F1, 0xF3F3}, {"a", "b", "d"});
 
-        SECTION("range insert")
-        {
-            test_type   keys[]   = {test_type(0xF4F4), test_type(0xF6F6), test_type(0xF5F5),
-                                test_type(0xF1F1)};
-            std::string values[] = {"e", "g", "f", "x"};
-            map.insert_range(std::begin(keys), std::end(keys), std::begin(values),
-                             std::end(values));
-            verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4, 0xF5F5, 0xF6F6},
-                       {"a", "b", "c", "d", "e", "f", "g"});
-
-            std::pair<int, std::string> pairs[] = {{0xF8F8, "i"}, {0xF7F7, "h"}};
-            map.insert_pair_range(std::begin(pairs), std::end(pairs));
-            verify_map(map,
-                       {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4, 0xF5F5, 0xF6F6, 0xF7F7, 0xF8F8},
-                       {"a", "b", "c", "d", "e", "f", "g", "h", "i"});
-        }
-        SECTION("duplicate insert")
-        {
-            result = map.insert(0xF1F1, "x");
-            verify_result(map, result, 0xF1F1, "b", 1, true);
+            result = map.insert_pair(std::make_pair(test_type(0xF2F2), "c"));
+            verify_result(map, result, 0xF2F2, "c", 2);
             verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
 
-            result = map.insert(0xF3F3, "x");
-            verify_result(map, result, 0xF3F3, "d", 3, true);
-            verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
-        }
-        SECTION("assign insert")
-        {
-            result = map.emplace_or_assign(0xF1F1, 2, 'b');
-            verify_result(map, result, 0xF1F1, "bb", 1, true);
-            verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "bb", "c", "d"});
+            SECTION("range insert")
+            {
+                test_type   keys[]   = {test_type(0xF4F4), test_type(0xF6F6), test_type(0xF5F5),
+                                    test_type(0xF1F1)};
+                std::string values[] = {"e", "g", "f", "x"};
+                map.insert_range(std::begin(keys), std::end(keys), std::begin(values),
+                                 std::end(values));
+                verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4, 0xF5F5, 0xF6F6},
+                           {"a", "b", "c", "d", "e", "f", "g"});
+
+                std::pair<int, std::string> pairs[] = {{0xF8F8, "i"}, {0xF7F7, "h"}};
+                map.insert_pair_range(std::begin(pairs), std::end(pairs));
+                verify_map(map,
+                           {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4, 0xF5F5, 0xF6F6, 0xF7F7, 0xF8F8},
+                           {"a", "b", "c", "d", "e", "f", "g", "h", "i"});
+            }
+            SECTION("hint insert")
+            {
+                result = map.try_emplace_hint(map.begin(), 0xF1F1, "x");
+                verify_result(map, result, 0xF1F1, "b", 1, true);
 
-            result = map.insert_or_assign(0xF4F4, "e");
-            verify_result(map, result, 0xF4F4, "e", 4);
-            verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4}, {"a", "bb", "c", "d", "e"});
+                result = map.try_emplace_hint(map.end(), 0xF4F4, "e");
+                verify_result(map, result, 0xF4F4, "e", 4);
 
-            result = map.insert_or_assign_pair(std::make_pair(0xF2F2, "cc"));
-            verify_result(map, result, 0xF2F2, "cc", 2, true);
-            verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4}, {"a", "bb", "cc", "d", "e"});
-        }
-        SECTION("clear")
-        {
-            auto old_cap = map.capacity();
-            map.clear();
-            REQUIRE(old_cap == map.capacity());
-            verify_map(map, {}, {});
-        }
-        SECTION("erase")
-        {
-            auto iter = map.erase(map.begin());
-            verify_map(map, {0xF1F1, 0xF2F2, 0xF3F3}, {"b", "c", "d"});
-            REQUIRE(iter == map.begin());
+                // wrong hint
+                result = map.try_emplace_hint(map.end(), 0xF0F1, "a2");
+                verify_result(map, result, 0xF0F1, "a2", 1);
+                verify_map(map, {0xF0F0, 0xF0F1, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4},
+                           {"a", "a2", "b", "c", "d", "e"});
+            }
+            SECTION("append sorted")
+            {
+                test_type   keys[]   = {test_type(0xF4F4), test_type(0xF5F5), test_type(0xF5F5),
+                                    test_type(0xF6F6)};
+                std::string values[] = {"e", "f", "x", "g"};
+                REQUIRE(map.append_sorted_range(std::begin(keys), std::end(keys),
+                                                std::begin(values), std::end(values))
+                        == 2u);
+                verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4, 0xF5F5},
+                           {"a", "b", "c", "d", "e", "f"});
+
+                std::pair<int, std::string> pairs[] = {{0xF6F6, "g"}, {0xF7F7, "h"}, {0xF0F0, "x"}};
+                REQUIRE(map.append_sorted_pair_range(std::begin(pairs), std::end(pairs)) == 2u);
+                verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4, 0xF5F5, 0xF6F6, 0xF7F7},
+                           {"a", "b", "c", "d", "e", "f", "g", "h"});
+            }
+            SECTION("duplicate insert")
+            {
+                result = map.insert(0xF1F1, "x");
+                verify_result(map, result, 0xF1F1, "b", 1, true);
+                verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
 
-            iter = map.erase(std::prev(map.end(), 2));
-            verify_map(map, {0xF1F1, 0xF3F3}, {"b", "d"});
-            REQUIRE(iter == std::prev(map.end()));
-        }
-        SECTION("erase range")
-        {
-            auto iter = map.erase_range(std::next(map.begin()), std::next(map.begin(), 2));
-            verify_map(map, {0xF0F0, 0xF2F2, 0xF3F3}, {"a", "c", "d"});
-            REQUIRE(iter == std::next(map.begin()));
+                result = map.insert(0xF3F3, "x");
+                verify_result(map, result, 0xF3F3, "d", 3, true);
+                verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
+            }
+            SECTION("assign insert")
+            {
+                result = map.emplace_or_assign(0xF1F1, 2, 'b');
+                verify_result(map, result, 0xF1F1, "bb", 1, true);
+                verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "bb", "c", "d"});
+
+                result = map.insert_or_assign(0xF4F4, "e");
+                verify_result(map, result, 0xF4F4, "e", 4);
+                verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4},
+                           {"a", "bb", "c", "d", "e"});
+
+                result = map.insert_or_assign_pair(std::make_pair(0xF2F2, "cc"));
+                verify_result(map, result, 0xF2F2, "cc", 2, true);
+                verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4},
+                           {"a", "bb", "cc", "d", "e"});
+            }
+            SECTION("clear")
+            {
+                auto old_cap = map.capacity();
+                map.clear();
+                REQUIRE(old_cap == map.capacity());
+                verify_map(map, {}, {});
+            }
+            SECTION("erase")
+            {
+                auto iter = map.erase(map.begin());
+                verify_map(map, {0xF1F1, 0xF2F2, 0xF3F3}, {"b", "c", "d"});
+                REQUIRE(iter == map.begin());
 
-            iter = map.erase_range(std::next(map.begin()), map.end());
-            verify_map(map, {0xF0F0}, {"a"});
-            REQUIRE(iter == map.end());
+                iter = map.erase(std::prev(map.end(), 2));
+                verify_map(map, {0xF1F1, 0xF3F3}, {"b", "d"});
+                REQUIRE(iter == std::prev(map.end()));
+            }
+            SECTION("erase range")
+            {
+                auto iter = map.erase_range(std::next(map.begin()), std::next(map.begin(), 2));
+                verify_map(map, {0xF0F0, 0xF2F2, 0xF3F3}, {"a", "c", "d"});
+                REQUIRE(iter == std::next(map.begin()));
 
-            iter = map.erase_range(map.begin(), map.begin());
-            verify_map(map, {0xF0F0}, {"a"});
-            REQUIRE(iter == map.begin());
+                iter = map.erase_range(std::next(map.begin()), map.end());
+                verify_map(map, {0xF0F0}, {"a"});
+                REQUIRE(iter == map.end());
 
-            iter = map.erase_range(map.begin(), map.end());
-            verify_map(map, {}, {});
-            REQUIRE(iter == map.end());
-        }
-        SECTION("erase all")
-        {
-            auto erased = map.erase_all(0xF2F2);
-            verify_map(map, {0xF0F0, 0xF1F1, 0xF3F3}, {"a", "b", "d"});
-            REQUIRE(erased);
+                iter = map.erase_range(map.begin(), map.begin());
+                verify_map(map, {0xF0F0}, {"a"});
+                REQUIRE(iter == map.begin());
 
-            erased = map.erase_all(0xF5F5);
-            verify_map(map, {0xF0F0, 0xF1F1, 0xF3F3}, {"a", "b", "d"});
-            REQUIRE(!erased);
-        }
-        SECTION("lookup")
-        {
-            // lookup of existing items already checked in verify_map()
-
-            REQUIRE(!map.contains(0xF4F4));
-            REQUIRE(map.try_lookup(0xF4F4) == nullptr);
-            REQUIRE(map.find(0xF4F4) == map.end());
-            REQUIRE(map.lower_bound(0xF4F4) == map.end());
-            REQUIRE(map.upper_bound(0xF4F4) == map.end());
-
-            auto range = map.equal_range(0xF4F4);
-            REQUIRE(range.empty());
-            REQUIRE(range.begin() == map.end());
-            REQUIRE(range.end() == map.end());
-        }
-        SECTION("move constructor")
-        {
-            auto     data = iterator_to_pointer(map.key_begin());
-            test_map other(std::move(map));
-            verify_map(other, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
-            verify_map(map, {}, {});
-            REQUIRE(iterator_to_pointer(other.key_begin()) == data);
+                iter = map.erase_range(map.begin(), map.end());
+                verify_map(map, {}, {});
+                REQUIRE(iter == map.end());
+            }
+            SECTION("erase all")
+            {
+                auto erased = map.erase_all(0xF2F2);
+                verify_map(map, {0xF0F0, 0xF1F1, 0xF3F3}, {"a", "b", "d"});
+                REQUIRE(erased);
 
-            SECTION("copy assignment")
+                erased = map.erase_all(0xF5F5);
+                verify_map(map, {0xF0F0, 0xF1F1, 0xF3F3}, {"a", "b", "d"});
+                REQUIRE(!erased);
+            }
+            SECTION("erase_if")
             {
-                map = other;
-                verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
-                verify_map(other, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
+                auto count = map.erase_if([](typename Map::iterator::value_type pair) {
+                    pair.value += "x";
+                    return pair.key.id == 0xF1F1;
+                });
+                verify_map(map, {0xF0F0, 0xF2F2, 0xF3F3}, {"ax", "cx", "dx"});
+                REQUIRE(count == 1u);
+
+                int keys[] = {0xF0F0, 0xF1F1, 0xF3F3};
+                REQUIRE(map.erase_all(make_sorted_view(keys)) == 2u);
+                verify_map(map, {0xF2F2}, {"cx"});
             }
-            SECTION("move assignment")
+            SECTION("erase_if throwing")
             {
-                map = std::move(other);
-                verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
-                verify_map(other, {}, {});
-                REQUIRE(iterator_to_pointer(map.key_begin()) == data);
+                REQUIRE_THROWS_AS(map.erase_if([](typename Map::iterator::value_type pair) {
+                    if (pair.key.id == 0xF2F2)
+                        throw 42;
+                    return pair.key.id == 0xF0F0;
+                }),
+                                  int);
+                verify_map(map, {0xF1F1, 0xF2F2, 0xF3F3}, {"b", "c", "d"});
+                REQUIRE(!map.contains(0xF0F0));
             }
-            SECTION("swap")
+            SECTION("lookup")
             {
-                swap(map, other);
-                verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
-                verify_map(other, {}, {});
-                REQUIRE(iterator_to_pointer(map.key_begin()) == data);
+                // lookup of existing items already checked in verify_map()
+
+                REQUIRE(!map.contains(0xF4F4));
+                REQUIRE(map.try_lookup(0xF4F4) == nullptr);
+                REQUIRE(map.find(0xF4F4) == map.end());
+                REQUIRE(map.lower_bound(0xF4F4) == map.end());
+                REQUIRE(map.upper_bound(0xF4F4) == map.end());
+
+                auto range = map.equal_range(0xF4F4);
+                REQUIRE(range.empty());
+                REQUIRE(range.begin() == map.end());
+                REQUIRE(range.end() == map.end());
             }
+            SECTION("move constructor")
+            {
+                auto     data = &map.begin()->key;
+                Map      other(std::move(map));
+                verify_map(other, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
+                verify_map(map, {}, {});
+                REQUIRE(&other.begin()->key == data);
+
+                SECTION("copy assignment")
+                {
+                    map = other;
+                    verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
+                    verify_map(other, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
+                }
+                SECTION("move assignment")
+                {
+                    map = std::move(other);
+                    verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
+                    verify_map(other, {}, {});
+                    REQUIRE(&map.begin()->key == data);
+                }
+                SECTION("swap")
+                {
+                    swap(map, other);
+                    verify_map(map, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3}, {"a", "b", "c", "d"});
+                    verify_map(other, {}, {});
+                    REQUIRE(&map.begin()->key == data);
+                }
+            }
+        }
+    }
+} // namespace
+
+TEST_CASE("flat_map", "[container]")
+{
+    test_flat_map<test_map>();
+
+    SECTION("same key and value type")
+    {
+        flat_map<int, int> map;
+        map.insert(1, 2);
+        REQUIRE(map.key_value_iter(map.key_begin()) == map.begin());
+        REQUIRE(map.key_value_iter(map.value_begin()) == map.begin());
+        REQUIRE(*map.value_iter(map.key_begin()) == 2);
+    }
+}
+
+TEST_CASE("flat_map erase_if throwing value", "[container]")
+{
+    test_throwing_value<separate_arrays_layout>();
+    test_throwing_value<single_block_layout>();
+    test_throwing_value<array_of_structs_layout>();
+}
+
+TEST_CASE("flat_map linear_search", "[container]")
+{
+    // the keys in the tests aren't arithmetic, so the default uses binary search
+    test_flat_map<flat_map<test_type, std::string, key_compare_default, block_storage_default,
+                           false, separate_arrays_layout, linear_search>>();
+}
+
+TEST_CASE("flat_map positional access", "[container]")
+{
+    flat_map<int, char>                                                      map;
+    flat_map<int, char, key_compare_default, block_storage_default, false,
+             array_of_structs_layout>                                        aos;
+    for (auto c = 'a'; c != 'k'; ++c)
+    {
+        map.insert((c - 'a') * 10, c);
+        aos.insert((c - 'a') * 10, c);
+    }
+
+    for (auto i = 0u; i != map.size(); ++i)
+    {
+        REQUIRE(map.nth(i).key == int(i) * 10);
+        REQUIRE(map.nth(i).value == char('a' + i));
+        REQUIRE(aos.nth(i).key == int(i) * 10);
+        REQUIRE(aos.nth(i).value == char('a' + i));
+    }
+    map.nth(3).value = 'x';
+    REQUIRE(map.lookup(30) == 'x');
+
+    REQUIRE(map.rank(0) == 0u);
+    REQUIRE(map.rank(35) == 4u);
+    REQUIRE(aos.rank(35) == 4u);
+    REQUIRE(map.rank(100) == 10u);
+
+    REQUIRE(map.count_range(10, 40) == 3u);
+    REQUIRE(aos.count_range(10, 40) == 3u);
+    REQUIRE(map.count_range(40, 10) == 0u);
+
+    auto range = map.range(10, 40);
+    REQUIRE(range.size() == 3u);
+    REQUIRE(range.min() == 10);
+    REQUIRE(range.max() == 30);
+    REQUIRE(&range.min() == &*map.key_iter(map.lower_bound(10)));
+
+    for (auto key = -5; key != 105; key += 5)
+        for (auto i = 0u; i <= map.size(); ++i)
+        {
+            REQUIRE(map.lower_bound(map.cbegin() + std::ptrdiff_t(i), key) == map.lower_bound(key));
+            REQUIRE(map.upper_bound(map.cbegin() + std::ptrdiff_t(i), key) == map.upper_bound(key));
+            REQUIRE(aos.lower_bound(aos.cbegin() + std::ptrdiff_t(i), key) == aos.lower_bound(key));
+        }
+}
+
+TEST_CASE("flat_map single_block_layout", "[container]")
+{
+    using map_type = flat_map<test_type, std::string, key_compare_default, block_storage_default,
+                              false, single_block_layout>;
+    REQUIRE(sizeof(map_type) < sizeof(test_map));
+    test_flat_map<map_type>();
+
+    SECTION("layout")
+    {
+        flat_map<char, double, key_compare_default, block_storage_default, false,
+                 single_block_layout>
+            map;
+        REQUIRE(map.capacity() == 0u);
+
+        for (auto c = 'a'; c != 'k'; ++c)
+            map.insert(c, c * 0.5);
+        REQUIRE(map.size() == 10u);
+        REQUIRE(map.capacity() >= 10u);
+        for (auto c = 'a'; c != 'k'; ++c)
+            REQUIRE(map.lookup(c) == c * 0.5);
+
+        // values are aligned and follow the keys
+        auto keys   = reinterpret_cast<std::uintptr_t>(iterator_to_pointer(map.key_begin()));
+        auto values = reinterpret_cast<std::uintptr_t>(iterator_to_pointer(map.value_begin()));
+        REQUIRE(values % alignof(double) == 0u);
+        REQUIRE(values >= keys + map.capacity());
+        REQUIRE(values < keys + map.capacity() + alignof(double));
+
+        map.shrink_to_fit();
+        REQUIRE(map.capacity() == 10u);
+        for (auto c = 'a'; c != 'k'; ++c)
+            REQUIRE(map.lookup(c) == c * 0.5);
+
+        map.clear();
+        map.shrink_to_fit();
+        REQUIRE(map.capacity() == 0u);
+    }
+    SECTION("growth policy")
+    {
+        // grows one element at a time instead of doubling
+        flat_map<int, int, key_compare_default, block_storage_new<no_extra_growth>, false,
+                 single_block_layout>
+            map;
+        for (auto i = 0; i != 5; ++i)
+        {
+            map.insert(i, i);
+            REQUIRE(map.capacity() == map.size());
+        }
+        for (auto i = 0; i != 5; ++i)
+            REQUIRE(map.lookup(i) == i);
+    }
+    SECTION("throwing value")
+    {
+        // erasing moves the values after it, which may throw
+        flat_map<int, throwing_value, key_compare_default, block_storage_default, false,
+                 single_block_layout>
+            map;
+        REQUIRE(!noexcept(map.erase(map.begin())));
+        REQUIRE(!noexcept(map.erase_range(map.begin(), map.end())));
+        REQUIRE(!noexcept(map.erase_all(0)));
+
+        flat_map<int, int, key_compare_default, block_storage_default, false,
+                 single_block_layout>
+            nothrow_map;
+        REQUIRE(noexcept(nothrow_map.erase(nothrow_map.begin())));
+    }
+}
+
+TEST_CASE("flat_map array_of_structs_layout", "[container]")
+{
+    using map_type = flat_map<test_type, std::string, key_compare_default, block_storage_default,
+                              false, array_of_structs_layout>;
+    REQUIRE(sizeof(map_type) < sizeof(test_map));
+    test_flat_map<map_type>();
+
+    SECTION("layout")
+    {
+        flat_map<char, double, key_compare_default, block_storage_default, false,
+                 array_of_structs_layout>
+            map;
+        for (auto c = 'a'; c != 'k'; ++c)
+            map.insert(c, c * 0.5);
+        REQUIRE(map.size() == 10u);
+
+        // value is stored right after its key
+        for (auto pair : map)
+        {
+            auto key   = reinterpret_cast<std::uintptr_t>(&pair.key);
+            auto value = reinterpret_cast<std::uintptr_t>(&pair.value);
+            REQUIRE(value == key + alignof(double));
+            REQUIRE(*map.try_lookup(pair.key) == pair.key * 0.5);
         }
+        REQUIRE(std::prev(map.end()) - map.begin() == 9);
     }
 }
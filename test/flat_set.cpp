@@ -189,6 +189,31 @@ TEST_CASE("flat_set", "[container]")
             set.insert_range(std::begin(tests), std::end(tests));
             verify_set(set, {0xF0F0, 0xF2F2, 0xF3F3, 0xF4F4, 0xF5F5});
         }
+        SECTION("hint insert")
+        {
+            result = set.try_emplace_hint(set.begin(), 0xF1F1);
+            verify_result(set, result, 0xF1F1, 1);
+            verify_set(set, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3});
+
+            result = set.try_emplace_hint(set.end(), 0xF2F2);
+            verify_result(set, result, 0xF2F2, 2, true);
+            verify_set(set, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3});
+
+            // wrong hint
+            result = set.try_emplace_hint(set.begin(), 0xF4F4);
+            verify_result(set, result, 0xF4F4, 4);
+            verify_set(set, {0xF0F0, 0xF1F1, 0xF2F2, 0xF3F3, 0xF4F4});
+        }
+        SECTION("append sorted")
+        {
+            test_type tests[] = {0xF4F4, 0xF5F5, 0xF5F5, 0xF6F6};
+            REQUIRE(set.append_sorted_range(std::begin(tests), std::end(tests)) == 2u);
+            verify_set(set, {0xF0F0, 0xF2F2, 0xF3F3, 0xF4F4, 0xF5F5});
+
+            REQUIRE(set.append_sorted_range(std::begin(tests), std::end(tests)) == 0u);
+            REQUIRE(set.append_sorted_range(std::end(tests) - 1, std::end(tests)) == 1u);
+            verify_set(set, {0xF0F0, 0xF2F2, 0xF3F3, 0xF4F4, 0xF5F5, 0xF6F6});
+        }
         SECTION("duplicate insert")
         {
             result = set.insert(0xF0F0);
@@ -253,6 +278,27 @@ TEST_CASE("flat_set", "[container]")
             verify_set(set, {0xF1F1, 0xF2F2, 0xF3F3});
             REQUIRE(!erased);
         }
+        SECTION("erase_if")
+        {
+            auto count = set.erase_if([](const test_type& test) { return test.id != 0xF2F2; });
+            verify_set(set, {0xF2F2});
+            REQUIRE(count == 2u);
+
+            int keys[] = {0xF0F0, 0xF2F2, 0xF4F4};
+            REQUIRE(set.erase_all(make_sorted_view(keys)) == 1u);
+            verify_set(set, {});
+        }
+        SECTION("erase_if throwing")
+        {
+            REQUIRE_THROWS_AS(set.erase_if([](const test_type& test) {
+                if (test.id == 0xF3F3)
+                    throw 42;
+                return test.id == 0xF0F0;
+            }),
+                              int);
+            verify_set(set, {0xF2F2, 0xF3F3});
+            REQUIRE(!set.contains(0xF0F0));
+        }
         SECTION("lookup")
         {
             // lookup of existing items already checked in verify_set()
@@ -357,4 +403,107 @@ TEST_CASE("flat_multiset", "[container]")
     result = set.insert(0xF1F1);
     verify_set(set, {0xF0F0, 0xF0F0, 0xF1F1, 0xF1F1, 0xF2F2, 0xF3F3});
     verify_result(set, result, 0xF1F1, 3, true);
+
+    result = set.insert(0xF3F3);
+    verify_set(set, {0xF0F0, 0xF0F0, 0xF1F1, 0xF1F1, 0xF2F2, 0xF3F3, 0xF3F3});
+    verify_result(set, result, 0xF3F3, 6, true);
+
+    result = set.try_emplace_hint(set.begin(), 0xF0F0);
+    verify_set(set, {0xF0F0, 0xF0F0, 0xF0F0, 0xF1F1, 0xF1F1, 0xF2F2, 0xF3F3, 0xF3F3});
+    verify_result(set, result, 0xF0F0, 2, true);
+
+    int keys[] = {0xF1F1, 0xF3F3, 0xF5F5};
+    REQUIRE(set.erase_all(make_sorted_view(keys)) == 4u);
+    verify_set(set, {0xF0F0, 0xF0F0, 0xF0F0, 0xF2F2});
+
+    test_type tests[] = {0xF3F3, 0xF4F4, 0xF2F2};
+    REQUIRE(set.append_sorted_range(std::begin(tests), std::end(tests)) == 2u);
+    verify_set(set, {0xF0F0, 0xF0F0, 0xF0F0, 0xF2F2, 0xF3F3, 0xF4F4});
+}
+
+TEST_CASE("flat_set search policy", "[container]")
+{
+    // insert in an order that hits every position and compare with the default
+    flat_multiset<int>                                                            def;
+    flat_multiset<int, key_compare_default, block_storage_default, linear_search> linear;
+    flat_multiset<int, key_compare_default, block_storage_default, binary_search> binary;
+    flat_multiset<int, key_compare_default, block_storage_default, interpolation_search<>>
+        interpolation;
+    flat_multiset<int, key_compare_default, block_storage_default, branchless_search> branchless;
+    flat_multiset<int, key_compare_default, block_storage_default, exponential_search> exponential;
+    for (auto i = 0; i != 64; ++i)
+    {
+        auto value = (i * 37) % 41;
+        def.insert(value);
+        linear.insert(value);
+        binary.insert(value);
+        interpolation.insert(value);
+        branchless.insert(value);
+        exponential.insert(value);
+        REQUIRE(std::equal(def.begin(), def.end(), linear.begin()));
+        REQUIRE(std::equal(def.begin(), def.end(), binary.begin()));
+        REQUIRE(std::equal(def.begin(), def.end(), interpolation.begin()));
+        REQUIRE(std::equal(def.begin(), def.end(), branchless.begin()));
+        REQUIRE(std::equal(def.begin(), def.end(), exponential.begin()));
+    }
+
+    for (auto value = -1; value != 42; ++value)
+    {
+        REQUIRE(linear.lower_bound(value) - linear.begin() == def.lower_bound(value) - def.begin());
+        REQUIRE(binary.lower_bound(value) - binary.begin() == def.lower_bound(value) - def.begin());
+        REQUIRE(linear.upper_bound(value) - linear.begin() == def.upper_bound(value) - def.begin());
+        REQUIRE(binary.upper_bound(value) - binary.begin() == def.upper_bound(value) - def.begin());
+        REQUIRE(interpolation.lower_bound(value) - interpolation.begin()
+                == def.lower_bound(value) - def.begin());
+        REQUIRE(interpolation.upper_bound(value) - interpolation.begin()
+                == def.upper_bound(value) - def.begin());
+        REQUIRE(linear.count(value) == def.count(value));
+        REQUIRE(binary.count(value) == def.count(value));
+        REQUIRE(interpolation.count(value) == def.count(value));
+        REQUIRE(branchless.lower_bound(value) - branchless.begin()
+                == def.lower_bound(value) - def.begin());
+        REQUIRE(branchless.count(value) == def.count(value));
+        REQUIRE(exponential.lower_bound(value) - exponential.begin()
+                == def.lower_bound(value) - def.begin());
+        REQUIRE(exponential.count(value) == def.count(value));
+
+        for (auto hint = def.begin(); hint != def.end(); ++hint)
+        {
+            REQUIRE(def.lower_bound(hint, value) == def.lower_bound(value));
+            REQUIRE(def.upper_bound(hint, value) == def.upper_bound(value));
+        }
+        REQUIRE(def.lower_bound(def.end(), value) == def.lower_bound(value));
+    }
+}
+
+TEST_CASE("flat_set positional access", "[container]")
+{
+    flat_multiset<int> set;
+    for (auto i = 0; i != 20; ++i)
+        set.insert(i / 2 * 10);
+    // 0, 0, 10, 10, ..., 90, 90
+
+    for (auto i = 0u; i != set.size(); ++i)
+        REQUIRE(set.nth(i) == set.begin()[std::ptrdiff_t(i)]);
+
+    REQUIRE(set.rank(-1) == 0u);
+    REQUIRE(set.rank(0) == 0u);
+    REQUIRE(set.rank(5) == 2u);
+    REQUIRE(set.rank(10) == 2u);
+    REQUIRE(set.rank(90) == 18u);
+    REQUIRE(set.rank(100) == 20u);
+
+    REQUIRE(set.count_range(0, 100) == 20u);
+    REQUIRE(set.count_range(10, 30) == 4u);
+    REQUIRE(set.count_range(10, 11) == 2u);
+    REQUIRE(set.count_range(10, 10) == 0u);
+    REQUIRE(set.count_range(30, 10) == 0u);
+
+    auto range = set.range(15, 50);
+    REQUIRE(range.size() == 6u);
+    REQUIRE(range.min() == 20);
+    REQUIRE(range.max() == 40);
+    REQUIRE(&range.min() == &*set.lower_bound(20));
+    REQUIRE(set.range(50, 15).empty());
+    REQUIRE(set.range(100, 200).empty());
 }
@@ -0,0 +1,264 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/flat_string_set.hpp>
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <foonathan/array/block_storage_sbo.hpp>
+
+using namespace foonathan::array;
+
+namespace
+{
+    template <class Set>
+    void verify_set_impl(const Set& set, const std::multiset<std::string>& strings)
+    {
+        REQUIRE(set.empty() == (set.size() == 0u));
+        REQUIRE(set.size() == strings.size());
+        REQUIRE(set.capacity() >= set.size());
+        REQUIRE(set.capacity() <= set.max_size());
+
+        auto length = size_type(0);
+        for (auto& str : strings)
+            length += str.size();
+        REQUIRE(set.total_length() == length);
+        REQUIRE(set.arena_capacity() >= length);
+
+        REQUIRE(size_type(std::distance(set.begin(), set.end())) == set.size());
+        REQUIRE(std::equal(set.begin(), set.end(), strings.begin(),
+                           [](string_key key, const std::string& str) { return key == str; }));
+        if (!set.empty())
+        {
+            REQUIRE(set.min() == *strings.begin());
+            REQUIRE(set.max() == *strings.rbegin());
+        }
+
+        for (auto& str : strings)
+        {
+            REQUIRE(set.contains(str));
+            if (str.find('\0') == std::string::npos)
+                REQUIRE(set.contains(str.c_str()));
+            REQUIRE(set.count(str) == strings.count(str));
+            REQUIRE(*set.find(str) == str);
+            REQUIRE(set.find(str)->size() == str.size());
+
+            auto range = set.equal_range(str);
+            REQUIRE(range.begin() == set.lower_bound(str));
+            REQUIRE(range.end() == set.upper_bound(str));
+        }
+    }
+
+    template <class Set>
+    void verify_set(const Set& set, const std::multiset<std::string>& strings)
+    {
+        verify_set_impl(set, strings);
+
+        // copy constructor
+        Set copy(set);
+        verify_set_impl(copy, strings);
+
+        // shrink to fit
+        copy.shrink_to_fit();
+        verify_set_impl(copy, strings);
+        REQUIRE(copy.arena_capacity() <= set.arena_capacity());
+
+        // copy assignment
+        copy.insert("a string that is not in the set");
+        copy = set;
+        verify_set_impl(copy, strings);
+
+        // range assignment
+        copy.insert("a string that is not in the set");
+        copy.assign_range(set.begin(), set.end());
+        verify_set_impl(copy, strings);
+    }
+
+    std::vector<std::string> make_strings(int begin, int end)
+    {
+        std::vector<std::string> result;
+        for (auto i = begin; i != end; ++i)
+            result.push_back(std::string(std::size_t(i % 7), 'x') + std::to_string(i));
+        return result;
+    }
+
+    template <class Set>
+    void test_string_set()
+    {
+        Set set;
+        verify_set(set, {});
+        REQUIRE(!set.contains(""));
+        REQUIRE(set.find("abc") == set.end());
+
+        auto result = set.insert("hello");
+        REQUIRE(result.was_inserted());
+        REQUIRE(!result.was_duplicate());
+        REQUIRE(*result.iter() == "hello");
+
+        result = set.insert(std::string("world"));
+        REQUIRE(result.was_inserted());
+        result = set.insert("");
+        REQUIRE(result.was_inserted());
+        REQUIRE(result.iter() == set.begin());
+        verify_set(set, {"", "hello", "world"});
+
+        SECTION("duplicate")
+        {
+            result = set.insert("hello");
+            REQUIRE(!result.was_inserted());
+            REQUIRE(result.was_duplicate());
+            REQUIRE(result.iter() == set.find("hello"));
+
+            // insert a string that is in the arena itself
+            result = set.insert(*set.find("world"));
+            REQUIRE(result.was_duplicate());
+            verify_set(set, {"", "hello", "world"});
+        }
+        SECTION("embedded null")
+        {
+            std::string str("hel\0lo", 6u);
+            set.insert(str);
+            REQUIRE(set.contains(str));
+            REQUIRE(!set.contains("hel"));
+            verify_set(set, {"", "hello", "world", str});
+        }
+        SECTION("erase")
+        {
+            REQUIRE(set.erase_all("hello"));
+            REQUIRE(!set.erase_all("hello"));
+            verify_set(set, {"", "world"});
+
+            auto next = set.erase(set.begin());
+            REQUIRE(*next == "world");
+            verify_set(set, {"world"});
+
+            set.clear();
+            verify_set(set, {});
+        }
+        SECTION("range")
+        {
+            auto strings = make_strings(0, 200);
+            set.insert_range(strings.begin(), strings.end());
+
+            std::multiset<std::string> expected(strings.begin(), strings.end());
+            expected.insert({"", "hello", "world"});
+            verify_set(set, expected);
+
+            set.erase_range(set.lower_bound("x"), set.upper_bound("xxxx"));
+            expected.erase(expected.lower_bound("x"), expected.upper_bound("xxxx"));
+            verify_set(set, expected);
+
+            set.assign_range(strings.rbegin(), strings.rend());
+            verify_set(set, std::multiset<std::string>(strings.begin(), strings.end()));
+        }
+        SECTION("assign duplicates")
+        {
+            // duplicates of different lengths, the removed ones must not count
+            std::vector<std::string> strings = {"a", "a", "bbbbb", "cc", "bbbbb", "a"};
+            set.assign_range(strings.begin(), strings.end());
+            REQUIRE(set.total_length() == 8u);
+            verify_set(set, {"a", "bbbbb", "cc"});
+
+            REQUIRE(set.erase_all("bbbbb"));
+            REQUIRE(set.erase_all("a"));
+            REQUIRE(set.total_length() == 2u);
+            set.shrink_to_fit();
+            verify_set(set, {"cc"});
+        }
+        SECTION("compact")
+        {
+            // the arena would grow without bounds if erased strings were never removed
+            for (auto round = 0; round != 20; ++round)
+            {
+                for (auto& str : make_strings(0, 100))
+                    REQUIRE(set.insert(str).was_inserted());
+                for (auto& str : make_strings(0, 100))
+                    REQUIRE(set.erase_all(str));
+            }
+            REQUIRE(set.arena_capacity() < 20u * set.total_length() + 4096u);
+            verify_set(set, {"", "hello", "world"});
+
+            auto old_capacity = set.arena_capacity();
+            set.shrink_to_fit();
+            REQUIRE(set.arena_capacity() <= old_capacity);
+            verify_set(set, {"", "hello", "world"});
+        }
+        SECTION("move")
+        {
+            Set other(std::move(set));
+            verify_set(other, {"", "hello", "world"});
+
+            set.insert("a");
+            swap(set, other);
+            verify_set(set, {"", "hello", "world"});
+            verify_set(other, {"a"});
+
+            set = std::move(other);
+            verify_set(set, {"a"});
+            verify_set(other, {});
+        }
+    }
+} // namespace
+
+TEST_CASE("string_key", "[util]")
+{
+    string_key empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty.size() == 0u);
+
+    string_key hello("hello");
+    REQUIRE(hello.size() == 5u);
+    REQUIRE(hello[1] == 'e');
+    REQUIRE(std::string(hello) == "hello");
+    REQUIRE(std::string(hello.begin(), hello.end()) == "hello");
+
+    std::string str = "help";
+    REQUIRE(string_key(str).data() == str.data());
+    REQUIRE(hello.compare(str) < 0);
+    REQUIRE(hello.compare("hell") > 0);
+    REQUIRE(hello.compare("hello") == 0);
+    REQUIRE(empty.compare("") == 0);
+    REQUIRE(empty < hello);
+    REQUIRE(string_key("\xFF") > hello);
+    REQUIRE(key_compare_default::compare(hello, "hellp") == key_ordering::less);
+}
+
+TEST_CASE("flat_string_set", "[container]")
+{
+    test_string_set<flat_string_set<>>();
+}
+
+TEST_CASE("flat_string_set sbo", "[container]")
+{
+    test_string_set<flat_string_set<key_compare_default,
+                                    block_storage_sbo<256, block_storage_new<default_growth>>>>();
+}
+
+TEST_CASE("flat_string_set prefix_search", "[container]")
+{
+    test_string_set<
+        flat_string_set<key_compare_default, block_storage_default, false, prefix_search<>>>();
+}
+
+TEST_CASE("flat_string_multiset", "[container]")
+{
+    flat_string_multiset<> set;
+    set.insert("a");
+    set.insert("b");
+    REQUIRE(set.insert("a").was_duplicate());
+    REQUIRE(set.count("a") == 2u);
+    verify_set(set, {"a", "a", "b"});
+
+    std::vector<std::string> strings = {"c", "a", "c", "b"};
+    set.assign_range(strings.begin(), strings.end());
+    verify_set(set, {"a", "b", "c", "c"});
+
+    REQUIRE(set.erase_all("c") == 2u);
+    verify_set(set, {"a", "b"});
+}
@@ -0,0 +1,170 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/gap_buffer.hpp>
+
+#include <vector>
+
+#include <catch.hpp>
+
+#include <foonathan/array/block_storage_sbo.hpp>
+
+#include "leak_checker.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    struct test_type : leak_tracked
+    {
+        std::uint16_t id;
+
+        test_type(int i) : id(static_cast<std::uint16_t>(i)) {}
+    };
+
+    template <class Buffer>
+    void verify_buffer(const Buffer& buffer, const std::vector<int>& ids)
+    {
+        REQUIRE(buffer.empty() == ids.empty());
+        REQUIRE(buffer.size() == ids.size());
+        REQUIRE(buffer.capacity() >= buffer.size());
+        REQUIRE(buffer.gap_position() <= buffer.size());
+        REQUIRE(buffer.end() - buffer.begin() == std::ptrdiff_t(ids.size()));
+
+        auto iter = buffer.begin();
+        for (auto i = 0u; i != ids.size(); ++i, ++iter)
+        {
+            REQUIRE(buffer[i].id == ids[i]);
+            REQUIRE(iter->id == ids[i]);
+            REQUIRE(buffer.begin()[std::ptrdiff_t(i)].id == ids[i]);
+        }
+        REQUIRE(iter == buffer.end());
+
+        if (!ids.empty())
+        {
+            REQUIRE(buffer.front().id == ids.front());
+            REQUIRE(buffer.back().id == ids.back());
+        }
+    }
+
+    template <class Buffer>
+    void test_gap_buffer()
+    {
+        leak_checker checker;
+
+        Buffer           buffer;
+        std::vector<int> ids;
+        verify_buffer(buffer, ids);
+
+        for (auto i = 0; i != 10; ++i)
+        {
+            buffer.push_back(i);
+            ids.push_back(i);
+        }
+        verify_buffer(buffer, ids);
+        REQUIRE(buffer.gap_position() == 10u);
+
+        // edits at a cursor
+        auto cursor = buffer.begin() + 4;
+        for (auto i = 100; i != 120; ++i)
+        {
+            cursor = std::next(buffer.insert(cursor, test_type(i)));
+            ids.insert(ids.begin() + std::ptrdiff_t(i - 100 + 4), i);
+            REQUIRE(buffer.gap_position() == size_type(i - 100 + 5));
+        }
+        verify_buffer(buffer, ids);
+
+        auto next = buffer.erase(buffer.begin() + 23);
+        ids.erase(ids.begin() + 23);
+        REQUIRE(next->id == ids[23]);
+        REQUIRE(buffer.gap_position() == 23u);
+        verify_buffer(buffer, ids);
+
+        // edits somewhere else
+        buffer.emplace(buffer.begin() + 1, 200);
+        ids.insert(ids.begin() + 1, 200);
+        REQUIRE(buffer.gap_position() == 2u);
+        verify_buffer(buffer, ids);
+
+        test_type range[] = {300, 301, 302};
+        auto first = buffer.insert_range(buffer.begin() + 27, std::begin(range), std::end(range));
+        ids.insert(ids.begin() + 27, {300, 301, 302});
+        REQUIRE(first - buffer.begin() == 27);
+        verify_buffer(buffer, ids);
+
+        buffer.erase_range(buffer.begin() + 2, buffer.begin() + 12);
+        ids.erase(ids.begin() + 2, ids.begin() + 12);
+        verify_buffer(buffer, ids);
+
+        buffer.pop_back();
+        ids.pop_back();
+        verify_buffer(buffer, ids);
+
+        SECTION("make_contiguous")
+        {
+            buffer.insert(buffer.begin() + 3, 400);
+            ids.insert(ids.begin() + 3, 400);
+
+            auto view = buffer.make_contiguous();
+            REQUIRE(buffer.gap_position() == buffer.size());
+            REQUIRE(view.size() == ids.size());
+            for (auto i = 0u; i != ids.size(); ++i)
+                REQUIRE(view[i].id == ids[i]);
+            verify_buffer(buffer, ids);
+        }
+        SECTION("capacity")
+        {
+            buffer.insert(buffer.begin() + 3, 400);
+            ids.insert(ids.begin() + 3, 400);
+
+            buffer.reserve(100u);
+            REQUIRE(buffer.capacity() >= 100u);
+            verify_buffer(buffer, ids);
+
+            buffer.shrink_to_fit();
+            verify_buffer(buffer, ids);
+
+            auto capacity = buffer.capacity();
+            buffer.clear();
+            ids.clear();
+            verify_buffer(buffer, ids);
+            REQUIRE(buffer.capacity() == capacity);
+        }
+        SECTION("copy")
+        {
+            buffer.insert(buffer.begin() + 3, 400);
+            ids.insert(ids.begin() + 3, 400);
+
+            auto copy = buffer;
+            verify_buffer(copy, ids);
+
+            copy.erase(copy.begin());
+            copy = buffer;
+            verify_buffer(copy, ids);
+
+            auto moved = std::move(copy);
+            verify_buffer(moved, ids);
+            verify_buffer(copy, {});
+
+            copy.push_back(0);
+            copy = std::move(moved);
+            verify_buffer(copy, ids);
+            verify_buffer(moved, {});
+
+            swap(copy, moved);
+            verify_buffer(copy, {});
+            verify_buffer(moved, ids);
+        }
+    }
+} // namespace
+
+TEST_CASE("gap_buffer", "[container]")
+{
+    test_gap_buffer<gap_buffer<test_type>>();
+}
+
+TEST_CASE("gap_buffer block_storage_sbo", "[container]")
+{
+    test_gap_buffer<gap_buffer<test_type, block_storage_sbo<64, block_storage_default>>>();
+}
@@ -26,8 +26,8 @@ TEST_CASE("factor_growth", "[GrowthPolicy]")
     REQUIRE(factor1dot5::growth_size(5u, 1u, memory_block::max_size()) == 7u);
     REQUIRE(factor1dot5::growth_size(4u, 8u, memory_block::max_size()) == 12u);
 
-    REQUIRE(factor1dot5::shrink_size(4u, 2u) == 2u);
-    REQUIRE(factor1dot5::shrink_size(8u, 8u) == 8u);
+    REQUIRE(factor1dot5::shrink_size(4u, 2u, memory_block::max_size()) == 2u);
+    REQUIRE(factor1dot5::shrink_size(8u, 8u, memory_block::max_size()) == 8u);
 
     using factor2 = factor_growth<4, 2>;
 
@@ -35,8 +35,8 @@ TEST_CASE("factor_growth", "[GrowthPolicy]")
     REQUIRE(factor2::growth_size(4u, 1u, memory_block::max_size()) == 8u);
     REQUIRE(factor2::growth_size(4u, 8u, memory_block::max_size()) == 12u);
 
-    REQUIRE(factor2::shrink_size(4u, 2u) == 2u);
-    REQUIRE(factor2::shrink_size(8u, 8u) == 8u);
+    REQUIRE(factor2::shrink_size(4u, 2u, memory_block::max_size()) == 2u);
+    REQUIRE(factor2::shrink_size(8u, 8u, memory_block::max_size()) == 8u);
 
     SECTION("whole_growth")
     {
@@ -70,3 +70,124 @@ TEST_CASE("factor_growth", "[GrowthPolicy]")
         REQUIRE(detail::frac_growth<5, 3>::grow(5u) == 8); // 8.3..
     }
 }
+
+namespace
+{
+    struct test_heap
+    {
+        struct handle_type
+        {
+        };
+
+        static size_type max_size(const handle_type&) noexcept
+        {
+            return 1024u;
+        }
+    };
+
+    struct good_size_heap : test_heap
+    {
+        static size_type good_size(const handle_type&, size_type size) noexcept
+        {
+            return (size + 99u) / 100u * 100u;
+        }
+    };
+
+    template <class GrowthPolicy>
+    growth_context<test_heap, GrowthPolicy> make_context(
+        size_type element_size, growth_policy_config<GrowthPolicy> config = {})
+    {
+        return growth_context<test_heap, GrowthPolicy>({}, config, element_size, 1u);
+    }
+} // namespace
+
+TEST_CASE("grow_block_size/shrink_block_size", "[GrowthPolicy]")
+{
+    // forwards to the plain functions
+    auto context = make_context<no_extra_growth>(1u);
+    REQUIRE(context.max_size() == 1024u);
+    REQUIRE(grow_block_size<no_extra_growth>(context, 4u, 8u) == 12u);
+    REQUIRE(shrink_block_size<no_extra_growth>(context, 8u, 2u) == 2u);
+    REQUIRE(grow_block_size<factor_growth<2>>(context, 4u, 1u) == 8u);
+    REQUIRE(shrink_block_size<factor_growth<2>>(context, 8u, 2u) == 2u);
+
+    REQUIRE(!has_growth_config<no_extra_growth>::value);
+    REQUIRE(has_growth_config<decaying_growth>::value);
+    REQUIRE(!has_growth_config<size_class_growth<>>::value);
+    REQUIRE(has_growth_config<size_class_growth<decaying_growth>>::value);
+}
+
+TEST_CASE("decaying_growth", "[GrowthPolicy]")
+{
+    decaying_growth_config config;
+    config.small_limit  = 64u;
+    config.medium_limit = 256u;
+    config.chunk_size   = 100u;
+
+    auto context = make_context<decaying_growth>(1u, config);
+    REQUIRE(grow_block_size<decaying_growth>(context, 0u, 4u) == 4u);
+    REQUIRE(grow_block_size<decaying_growth>(context, 16u, 1u) == 32u);
+    REQUIRE(grow_block_size<decaying_growth>(context, 16u, 32u) == 48u);
+    REQUIRE(grow_block_size<decaying_growth>(context, 64u, 1u) == 96u);
+    REQUIRE(grow_block_size<decaying_growth>(context, 256u, 1u) == 356u);
+    REQUIRE(grow_block_size<decaying_growth>(context, 1000u, 1u) == 1024u);  // max_size
+    REQUIRE(grow_block_size<decaying_growth>(context, 1000u, 100u) == 1100u); // needed
+    REQUIRE(shrink_block_size<decaying_growth>(context, 100u, 10u) == 10u);
+
+    // rounds to whole elements
+    auto element_context = make_context<decaying_growth>(12u, config);
+    REQUIRE(grow_block_size<decaying_growth>(element_context, 24u, 12u) == 48u);
+    REQUIRE(grow_block_size<decaying_growth>(element_context, 72u, 12u) == 108u);
+    REQUIRE(grow_block_size<decaying_growth>(element_context, 100u, 1u) == 144u); // 150
+}
+
+TEST_CASE("size_class_growth", "[GrowthPolicy]")
+{
+    REQUIRE(round_to_size_class(0u) == 0u);
+    REQUIRE(round_to_size_class(1u) == 16u);
+    REQUIRE(round_to_size_class(16u) == 16u);
+    REQUIRE(round_to_size_class(17u) == 32u);
+    REQUIRE(round_to_size_class(100u) == 112u);
+    REQUIRE(round_to_size_class(128u) == 128u);
+    REQUIRE(round_to_size_class(129u) == 160u);
+    REQUIRE(round_to_size_class(3000u) == 3072u);
+    REQUIRE(round_to_size_class(4097u) == 8192u);
+    REQUIRE(round_to_size_class(4097u, 1024u) == 5120u);
+    REQUIRE(round_to_size_class(memory_block::max_size() - 1u) == memory_block::max_size() - 1u);
+
+    using policy = size_class_growth<no_extra_growth>;
+    auto context = make_context<policy>(1u);
+    REQUIRE(grow_block_size<policy>(context, 0u, 4u) == 16u);
+    REQUIRE(grow_block_size<policy>(context, 96u, 4u) == 112u);
+    REQUIRE(grow_block_size<policy>(context, 1000u, 20u) == 1024u);
+    REQUIRE(grow_block_size<policy>(context, 1020u, 10u) == 1030u); // exceeds max_size
+    REQUIRE(shrink_block_size<policy>(context, 128u, 100u) == 112u);
+}
+
+TEST_CASE("growth_context::good_size", "[GrowthPolicy]")
+{
+    auto context = make_context<no_extra_growth>(1u);
+    REQUIRE(context.good_size(17u) == 17u);
+
+    using policy = size_class_growth<no_extra_growth>;
+    growth_context<good_size_heap, policy> good_context({}, {}, 1u, 1u);
+    REQUIRE(good_context.good_size(17u) == 100u);
+    REQUIRE(grow_block_size<policy>(good_context, 0u, 4u) == 100u);
+    REQUIRE(grow_block_size<policy>(good_context, 96u, 8u) == 200u); // 112 -> 200
+    REQUIRE(grow_block_size<policy>(good_context, 1000u, 20u) == 1020u); // 1100 > max_size
+}
+
+TEST_CASE("shrink_hysteresis", "[GrowthPolicy]")
+{
+    using policy = shrink_hysteresis<no_extra_growth, 1u, 4u>;
+    auto context = make_context<policy>(1u);
+    REQUIRE(grow_block_size<policy>(context, 4u, 8u) == 12u);
+
+    REQUIRE(shrink_block_size<policy>(context, 100u, 80u) == 100u);
+    REQUIRE(shrink_block_size<policy>(context, 100u, 75u) == 100u);
+    REQUIRE(shrink_block_size<policy>(context, 100u, 74u) == 74u);
+    REQUIRE(shrink_block_size<policy>(context, 100u, 0u) == 0u);
+    REQUIRE(shrink_block_size<policy>(context, 100u, 100u) == 100u);
+    REQUIRE(shrink_block_size<policy>(context, 7u, 6u) == 7u);
+    REQUIRE(shrink_block_size<policy>(context, 7u, 5u) == 5u);
+}
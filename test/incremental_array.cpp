@@ -0,0 +1,190 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/incremental_array.hpp>
+
+#include <vector>
+
+#include <catch.hpp>
+
+#include <foonathan/array/block_storage_sbo.hpp>
+
+#include "leak_checker.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    struct test_type : leak_tracked
+    {
+        std::uint16_t id;
+
+        test_type(int i) : id(static_cast<std::uint16_t>(i)) {}
+    };
+
+    template <class Array>
+    void verify_array(const Array& array, const std::vector<int>& ids)
+    {
+        REQUIRE(array.empty() == ids.empty());
+        REQUIRE(array.size() == ids.size());
+        REQUIRE(array.capacity() >= array.size());
+        REQUIRE(array.migration_remaining() <= array.size());
+        REQUIRE(array.end() - array.begin() == std::ptrdiff_t(ids.size()));
+
+        auto iter = array.begin();
+        for (auto i = 0u; i != ids.size(); ++i, ++iter)
+        {
+            REQUIRE(array[i].id == ids[i]);
+            REQUIRE(iter->id == ids[i]);
+            REQUIRE(array.begin()[std::ptrdiff_t(i)].id == ids[i]);
+        }
+        REQUIRE(iter == array.end());
+
+        if (!ids.empty())
+        {
+            REQUIRE(array.front().id == ids.front());
+            REQUIRE(array.back().id == ids.back());
+        }
+    }
+
+    template <class Array>
+    void test_incremental_array()
+    {
+        leak_checker checker;
+
+        Array            array;
+        std::vector<int> ids;
+        verify_array(array, ids);
+        REQUIRE(!array.is_migrating());
+        REQUIRE(!array.step());
+
+        // fill it up until it starts migrating
+        auto i = 0;
+        while (!array.is_migrating())
+        {
+            array.push_back(i);
+            ids.push_back(i);
+            ++i;
+            REQUIRE(array.size() <= 1000u);
+        }
+        verify_array(array, ids);
+
+        // the migration is done before it has to grow again
+        auto capacity = array.capacity();
+        while (array.is_migrating())
+        {
+            REQUIRE(array.size() < capacity);
+
+            auto remaining = array.migration_remaining();
+            array.emplace_back(i);
+            ids.push_back(i);
+            ++i;
+            REQUIRE(array.migration_remaining() < remaining);
+            verify_array(array, ids);
+        }
+        REQUIRE(array.capacity() == capacity);
+
+        // grow again
+        while (!array.is_migrating())
+        {
+            array.push_back(i);
+            ids.push_back(i);
+            ++i;
+        }
+        verify_array(array, ids);
+
+        SECTION("step")
+        {
+            auto remaining = array.migration_remaining();
+            REQUIRE(array.step() == array.is_migrating());
+            REQUIRE(array.migration_remaining() < remaining);
+            verify_array(array, ids);
+
+            array.finish_migration();
+            REQUIRE(!array.is_migrating());
+            REQUIRE(!array.step());
+            verify_array(array, ids);
+        }
+        SECTION("make_contiguous")
+        {
+            auto view = array.make_contiguous();
+            REQUIRE(!array.is_migrating());
+            REQUIRE(view.size() == ids.size());
+            for (auto j = 0u; j != ids.size(); ++j)
+                REQUIRE(view[j].id == ids[j]);
+            verify_array(array, ids);
+        }
+        SECTION("pop_back")
+        {
+            // pop the elements that are still in the old memory block,
+            // the ones that are already migrated remain
+            array.step();
+            while (array.is_migrating())
+            {
+                array.pop_back();
+                ids.pop_back();
+                verify_array(array, ids);
+            }
+            REQUIRE(!array.empty());
+
+            array.push_back(i);
+            ids.push_back(i);
+            verify_array(array, ids);
+        }
+        SECTION("capacity")
+        {
+            array.reserve(array.capacity() + 100u);
+            REQUIRE(!array.is_migrating());
+            REQUIRE(array.capacity() >= ids.size() + 100u);
+            verify_array(array, ids);
+
+            array.shrink_to_fit();
+            verify_array(array, ids);
+        }
+        SECTION("clear")
+        {
+            array.clear();
+            ids.clear();
+            REQUIRE(!array.is_migrating());
+            verify_array(array, ids);
+
+            array.push_back(0);
+            ids.push_back(0);
+            verify_array(array, ids);
+        }
+        SECTION("copy")
+        {
+            auto copy = array;
+            verify_array(copy, ids);
+
+            copy.pop_back();
+            copy = array;
+            verify_array(copy, ids);
+
+            auto moved = std::move(copy);
+            verify_array(moved, ids);
+            verify_array(copy, {});
+
+            copy.push_back(0);
+            copy = std::move(moved);
+            verify_array(copy, ids);
+            verify_array(moved, {});
+
+            swap(copy, moved);
+            verify_array(copy, {});
+            verify_array(moved, ids);
+        }
+    }
+} // namespace
+
+TEST_CASE("incremental_array", "[container]")
+{
+    test_incremental_array<incremental_array<test_type>>();
+}
+
+TEST_CASE("incremental_array block_storage_sbo", "[container]")
+{
+    test_incremental_array<
+        incremental_array<test_type, block_storage_sbo<64, block_storage_default>>>();
+}
@@ -6,6 +6,7 @@
 
 #include <foonathan/array/key_compare.hpp>
 
+#include <algorithm>
 #include <vector>
 
 using namespace foonathan::array;
@@ -23,6 +24,25 @@ namespace
         }
     };
 
+    template <class SearchPolicy, class Compare, typename T>
+    void test_policy(const std::vector<T>& container, T value,
+                     typename std::vector<T>::const_iterator lower,
+                     typename std::vector<T>::const_iterator upper)
+    {
+        auto policy_lower =
+            SearchPolicy::template lower_bound<Compare>(container.begin(), container.end(), value);
+        REQUIRE(policy_lower == lower);
+
+        auto policy_upper =
+            SearchPolicy::template upper_bound<Compare>(container.begin(), container.end(), value);
+        REQUIRE(policy_upper == upper);
+
+        auto range =
+            SearchPolicy::template equal_range<Compare>(container.begin(), container.end(), value);
+        REQUIRE(range.begin() == lower);
+        REQUIRE(range.end() == upper);
+    }
+
     template <typename Compare>
     void test_impl(const std::vector<int>& container, int value, std::size_t index,
                    std::size_t count = 1)
@@ -49,6 +69,26 @@ namespace
             foonathan::array::equal_range<Compare>(container.begin(), container.end(), value);
         REQUIRE(range.begin() == lower);
         REQUIRE(range.end() == upper);
+
+        test_policy<linear_search, Compare>(container, value, lower, upper);
+        test_policy<binary_search, Compare>(container, value, lower, upper);
+        test_policy<adaptive_search<4>, Compare>(container, value, lower, upper);
+        test_policy<adaptive_search<>, Compare>(container, value, lower, upper);
+        test_policy<search_default, Compare>(container, value, lower, upper);
+        test_policy<interpolation_search<>, Compare>(container, value, lower, upper);
+        test_policy<branchless_search, Compare>(container, value, lower, upper);
+        test_policy<exponential_search, Compare>(container, value, lower, upper);
+
+        // every position as hint
+        for (auto hint = container.begin();; ++hint)
+        {
+            REQUIRE(lower_bound_hint<Compare>(container.begin(), container.end(), hint, value)
+                    == lower);
+            REQUIRE(upper_bound_hint<Compare>(container.begin(), container.end(), hint, value)
+                    == upper);
+            if (hint == container.end())
+                break;
+        }
     }
 } // namespace
 
@@ -113,6 +153,56 @@ TEST_CASE("lower_bound/upper_bound/equal_range", "[util]")
     }
 }
 
+TEST_CASE("search policies", "[util]")
+{
+    auto verify = [](const std::vector<long long>& vec) {
+        for (auto value = vec.front() - 2; value <= vec.back() + 2;
+             value += 1 + (vec.back() - vec.front()) / 500)
+        {
+            auto lower = std::lower_bound(vec.begin(), vec.end(), value);
+            auto upper = std::upper_bound(vec.begin(), vec.end(), value);
+            test_policy<interpolation_search<>, key_compare_default>(vec, value, lower, upper);
+            test_policy<interpolation_search<linear_search>, key_compare_default>(vec, value,
+                                                                                   lower, upper);
+            test_policy<branchless_search, key_compare_default>(vec, value, lower, upper);
+            test_policy<exponential_search, key_compare_default>(vec, value, lower, upper);
+
+            for (auto hint : {vec.begin(), vec.begin() + 1, lower, upper, vec.end() - 1, vec.end()})
+            {
+                REQUIRE(lower_bound_hint<key_compare_default>(vec.begin(), vec.end(), hint, value)
+                        == lower);
+                REQUIRE(upper_bound_hint<key_compare_default>(vec.begin(), vec.end(), hint, value)
+                        == upper);
+            }
+        }
+    };
+
+    std::vector<long long> vec;
+    SECTION("uniform")
+    {
+        for (auto i = 0; i != 1000; ++i)
+            vec.push_back(i * 10 + (i * 7) % 10);
+        verify(vec);
+    }
+    SECTION("skewed")
+    {
+        for (auto i = 0; i != 60; ++i)
+            vec.push_back(1ll << i);
+        for (auto i = 0; i != 100; ++i)
+            vec.push_back((1ll << 60) + i);
+        verify(vec);
+    }
+    SECTION("duplicates")
+    {
+        for (auto i = 0; i != 1000; ++i)
+            vec.push_back(i / 100);
+        verify(vec);
+
+        vec.assign(100, 42);
+        verify(vec);
+    }
+}
+
 TEST_CASE("sorted_view", "[view]")
 {
     // just test min/max here
@@ -139,4 +229,14 @@ TEST_CASE("sorted_view", "[view]")
 
     REQUIRE(view.min() == 1);
     REQUIRE(view.max() == 4);
+
+    REQUIRE(*view.lower_bound(2) == 2);
+    REQUIRE(*view.lower_bound<branchless_search>(2) == 2);
+    REQUIRE(*view.upper_bound<exponential_search>(2) == 3);
+    REQUIRE(view.equal_range<binary_search>(3).begin() == view.begin() + 2);
+    REQUIRE(view.equal_range<binary_search>(3).end() == view.begin() + 3);
+    REQUIRE(view.contains(4));
+    REQUIRE(!view.contains<interpolation_search<>>(5));
+    REQUIRE(*view.lower_bound(view.begin(), 3) == 3);
+    REQUIRE(view.upper_bound(view.end(), 3) == view.end() - 1);
 }
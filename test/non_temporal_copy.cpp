@@ -0,0 +1,32 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/non_temporal_copy.hpp>
+
+#include <catch.hpp>
+#include <vector>
+
+using namespace foonathan::array;
+
+TEST_CASE("detail::non_temporal_copy_bytes", "[non_temporal_copy]")
+{
+    std::vector<unsigned char> src(1024u);
+    for (auto i = 0u; i != src.size(); ++i)
+        src[i] = static_cast<unsigned char>(i * 7u);
+
+    // every alignment of the destination, with and without a partial cache line at the end
+    for (auto offset : {0u, 1u, 8u, 15u})
+        for (auto size : {0u, 5u, 64u, 100u, 1000u})
+        {
+            std::vector<unsigned char> dest(1024u + 16u, 0xFFu);
+            detail::non_temporal_copy_bytes(dest.data() + offset, src.data() + 3u, size);
+
+            for (auto i = 0u; i != offset; ++i)
+                REQUIRE(dest[i] == 0xFFu);
+            for (auto i = 0u; i != size; ++i)
+                REQUIRE(dest[offset + i] == src[3u + i]);
+            for (auto i = offset + size; i != dest.size(); ++i)
+                REQUIRE(dest[i] == 0xFFu);
+        }
+}
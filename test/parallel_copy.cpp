@@ -0,0 +1,108 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/parallel_copy.hpp>
+
+#include <atomic>
+#include <catch.hpp>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace foonathan::array;
+
+TEST_CASE("detail::worker_pool", "[parallel_copy]")
+{
+    detail::worker_pool pool(3u);
+    REQUIRE(pool.no_workers() == 3u);
+
+    // Catch isn't thread-safe, so the workers only count
+    std::vector<std::atomic<int>> calls(1001u);
+    for (auto& c : calls)
+        c = 0;
+    std::atomic<int> empty_ranges(0);
+    auto             count = [&](size_type begin, size_type end) {
+        if (begin >= end)
+            ++empty_ranges;
+        for (auto i = begin; i != end; ++i)
+            ++calls[i];
+    };
+
+    SECTION("for_each_range")
+    {
+        pool.for_each_range(calls.size(), count);
+        for (auto& c : calls)
+            REQUIRE(c == 1);
+
+        // it can be used again
+        pool.for_each_range(calls.size(), count);
+        for (auto& c : calls)
+            REQUIRE(c == 2);
+    }
+    SECTION("small")
+    {
+        pool.for_each_range(1u, count);
+        REQUIRE(calls[0] == 1);
+        REQUIRE(calls[1] == 0);
+    }
+    SECTION("concurrent")
+    {
+        // the second job might find the pool busy and do all the work itself
+        std::thread other([&] {
+            for (auto i = 0; i != 100; ++i)
+                pool.for_each_range(calls.size(), count);
+        });
+        for (auto i = 0; i != 100; ++i)
+            pool.for_each_range(calls.size(), count);
+        other.join();
+
+        for (auto& c : calls)
+            REQUIRE(c == 200);
+    }
+    SECTION("no workers")
+    {
+        detail::worker_pool empty(0u);
+        REQUIRE(empty.no_workers() == 0u);
+        empty.for_each_range(calls.size(), count);
+        for (auto& c : calls)
+            REQUIRE(c == 1);
+    }
+
+    REQUIRE(empty_ranges == 0);
+}
+
+TEST_CASE("detail::parallel_copy_bytes/zero_bytes/fill", "[parallel_copy]")
+{
+    detail::worker_pool pool(3u);
+
+    // not a multiple of the line size
+    std::vector<std::uint32_t> src(10007u), dest(10007u, 42u);
+    for (auto i = 0u; i != src.size(); ++i)
+        src[i] = i;
+
+    SECTION("copy")
+    {
+        detail::parallel_copy_bytes(pool, dest.data(), src.data(),
+                                    (src.size() - 1u) * sizeof(std::uint32_t));
+        for (auto i = 0u; i != src.size() - 1u; ++i)
+            REQUIRE(dest[i] == i);
+        REQUIRE(dest.back() == 42u);
+    }
+    SECTION("zero")
+    {
+        detail::parallel_zero_bytes(pool, dest.data(), (dest.size() - 1u) * sizeof(std::uint32_t));
+        for (auto i = 0u; i != dest.size() - 1u; ++i)
+            REQUIRE(dest[i] == 0u);
+        REQUIRE(dest.back() == 42u);
+    }
+    SECTION("fill")
+    {
+        // fill with one of the overwritten objects
+        dest[5] = 7u;
+        detail::parallel_fill(pool, dest.data(), dest.size() - 1u, dest[5]);
+        for (auto i = 0u; i != dest.size() - 1u; ++i)
+            REQUIRE(dest[i] == 7u);
+        REQUIRE(dest.back() == 42u);
+    }
+}
@@ -0,0 +1,192 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/prefix_search.hpp>
+
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <foonathan/array/flat_map.hpp>
+#include <foonathan/array/flat_set.hpp>
+
+using namespace foonathan::array;
+
+namespace
+{
+    std::vector<std::string> make_strings()
+    {
+        // a lot of strings share a prefix longer than eight characters
+        std::vector<std::string> result;
+        for (auto i = 0; i != 40; ++i)
+        {
+            auto str = std::to_string((i * 37) % 41);
+            result.push_back(str);
+            result.push_back("prefix_shared_" + str);
+            result.push_back("prefix_" + str);
+        }
+        result.push_back("");
+        result.push_back("prefix_s");
+        return result;
+    }
+
+    std::vector<std::string> make_queries()
+    {
+        auto result = make_strings();
+        result.push_back("prefix");
+        result.push_back("prefix_shared_");
+        result.push_back("prefix_shared_9999");
+        result.push_back("prefix_t");
+        result.push_back("zzz");
+        return result;
+    }
+
+    template <class Set, class Expected>
+    void verify_set(const Set& set, const Expected& expected)
+    {
+        REQUIRE(set.size() == expected.size());
+        REQUIRE(std::equal(set.begin(), set.end(), expected.begin()));
+
+        for (auto& query : make_queries())
+        {
+            REQUIRE(set.lower_bound(query) - set.begin()
+                    == expected.lower_bound(query) - expected.begin());
+            REQUIRE(set.upper_bound(query) - set.begin()
+                    == expected.upper_bound(query) - expected.begin());
+            REQUIRE(set.count(query) == expected.count(query));
+            REQUIRE(set.count(query.c_str()) == expected.count(query));
+        }
+    }
+} // namespace
+
+TEST_CASE("key_prefix_default", "[util]")
+{
+    auto prefix = [](const std::string& str) {
+        return key_prefix_default::prefix<std::string>(str);
+    };
+
+    REQUIRE(prefix("") == 0u);
+    REQUIRE(prefix("a") == 0x6100000000000000u);
+    REQUIRE(prefix("abcdefgh") == 0x6162636465666768u);
+    REQUIRE(prefix("abcdefghij") == prefix("abcdefgh"));
+    REQUIRE(prefix("\xFF") > prefix("a"));
+    REQUIRE(prefix("ab") < prefix("b"));
+
+    for (auto& str : make_queries())
+        REQUIRE(key_prefix_default::prefix<std::string>(str.c_str()) == prefix(str));
+}
+
+TEST_CASE("flat_set prefix_search", "[container]")
+{
+    using set_type = flat_multiset<std::string, key_compare_default, block_storage_default,
+                                   prefix_search<>>;
+
+    set_type                   set;
+    flat_multiset<std::string> expected;
+    for (auto& str : make_strings())
+    {
+        set.insert(str);
+        expected.insert(str);
+    }
+    verify_set(set, expected);
+
+    SECTION("erase")
+    {
+        set.erase(set.find("prefix_shared_7"));
+        expected.erase(expected.find("prefix_shared_7"));
+        set.erase_range(set.lower_bound("prefix_1"), set.upper_bound("prefix_3"));
+        expected.erase_range(expected.lower_bound("prefix_1"), expected.upper_bound("prefix_3"));
+        set.erase_all("prefix_s");
+        expected.erase_all("prefix_s");
+        verify_set(set, expected);
+
+        auto pred = [](const std::string& str) { return str.size() % 3u == 0u; };
+        REQUIRE(set.erase_if(pred) == expected.erase_if(pred));
+        verify_set(set, expected);
+
+        set.clear();
+        expected.clear();
+        verify_set(set, expected);
+    }
+    SECTION("copy")
+    {
+        set_type copy(set);
+        verify_set(copy, expected);
+
+        copy.shrink_to_fit();
+        verify_set(copy, expected);
+
+        set_type other;
+        other.insert("prefix_shared_");
+        swap(copy, other);
+        verify_set(other, expected);
+        REQUIRE(copy.contains("prefix_shared_"));
+        REQUIRE(!copy.contains("prefix_shared_1"));
+    }
+    SECTION("assign")
+    {
+        auto strings = make_strings();
+        set.assign_range(strings.rbegin(), strings.rend());
+        verify_set(set, expected);
+
+        array<std::string> arr;
+        arr.assign_range(strings.begin(), strings.end());
+        set_type stolen(std::move(arr));
+        verify_set(stolen, expected);
+    }
+}
+
+TEST_CASE("flat_map prefix_search", "[container]")
+{
+    auto strings = make_strings();
+
+    flat_map<std::string, int, key_compare_default, block_storage_default, false,
+             separate_arrays_layout, prefix_search<>>
+        separate;
+    flat_map<std::string, int, key_compare_default, block_storage_default, false,
+             array_of_structs_layout, prefix_search<>>
+        aos;
+    for (auto i = 0u; i != strings.size(); ++i)
+    {
+        separate.insert(strings[i], int(i));
+        aos.insert(strings[i], int(i));
+    }
+
+    auto verify = [&] {
+        REQUIRE(separate.size() == aos.size());
+        for (auto i = 0u; i != strings.size(); ++i)
+        {
+            REQUIRE(separate.contains(strings[i]) == aos.contains(strings[i].c_str()));
+            if (separate.contains(strings[i]))
+            {
+                REQUIRE(separate.lookup(strings[i]) == int(i));
+                REQUIRE(aos.lookup(strings[i]) == int(i));
+            }
+        }
+    };
+    verify();
+
+    separate.erase(separate.find("prefix_shared_3"));
+    aos.erase(aos.find("prefix_shared_3"));
+    separate.erase_range(separate.lower_bound("prefix_shared_1"),
+                         separate.upper_bound("prefix_shared_2"));
+    aos.erase_range(aos.lower_bound("prefix_shared_1"), aos.upper_bound("prefix_shared_2"));
+    REQUIRE(!separate.contains("prefix_shared_3"));
+    REQUIRE(!aos.contains("prefix_shared_15"));
+    REQUIRE(aos.contains("prefix_shared_5"));
+    verify();
+
+    const char* keys[] = {"prefix_2", "prefix_shared_6", "prefix_shared_9"};
+    REQUIRE(separate.erase_all(make_sorted_view(keys)) == 3u);
+    REQUIRE(aos.erase_all(make_sorted_view(keys)) == 3u);
+    REQUIRE(!aos.contains("prefix_shared_6"));
+    verify();
+
+    auto copy = separate;
+    separate.clear();
+    REQUIRE(separate.empty());
+    REQUIRE(!separate.contains("prefix_shared_5"));
+    REQUIRE(copy.contains("prefix_shared_5"));
+}
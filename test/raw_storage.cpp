@@ -6,7 +6,9 @@
 
 #include <catch.hpp>
 #include <cstdint>
+#include <cstring>
 #include <initializer_list>
+#include <list>
 
 #include "leak_checker.hpp"
 
@@ -166,6 +168,60 @@ TEST_CASE("uninitialized_ construction", "[core]")
     destroy_range(to_pointer<test_type>(block.begin()), to_pointer<test_type>(end));
 }
 
+TEST_CASE("uninitialized_ construction for trivial type", "[core]")
+{
+    struct test_type
+    {
+        std::uint16_t id;
+        double        value;
+        const char*   ptr;
+    };
+    REQUIRE(std::is_trivially_copyable<test_type>::value);
+
+    std::aligned_storage<4 * sizeof(test_type)>::type storage;
+    std::memset(&storage, 0xFF, sizeof(storage));
+    auto block = memory_block(to_raw_pointer(&storage), 4 * sizeof(test_type));
+
+    SECTION("value construct")
+    {
+        auto end = uninitialized_value_construct<test_type>(block, 4);
+        REQUIRE(end == block.end());
+
+        auto ptr = to_pointer<test_type>(block.begin());
+        for (auto i = 0; i != 4; ++i)
+        {
+            REQUIRE(ptr[i].id == 0);
+            REQUIRE(ptr[i].value == 0.0);
+            REQUIRE(ptr[i].ptr == nullptr);
+        }
+    }
+    SECTION("value construct arithmetic")
+    {
+        auto end = uninitialized_value_construct<double>(block, 8);
+        REQUIRE(end == block.begin() + 8 * sizeof(double));
+
+        auto ptr = to_pointer<double>(block.begin());
+        for (auto i = 0; i != 8; ++i)
+            REQUIRE(ptr[i] == 0.0);
+        // the rest of the block isn't touched
+        REQUIRE(static_cast<unsigned char>(*end) == 0xFFu);
+    }
+    SECTION("fill")
+    {
+        auto end = uninitialized_fill(block, 3, test_type{0xF0F0, 3.14, "abc"});
+        REQUIRE(end == block.begin() + 3 * sizeof(test_type));
+
+        auto ptr = to_pointer<test_type>(block.begin());
+        for (auto i = 0; i != 3; ++i)
+        {
+            REQUIRE(ptr[i].id == 0xF0F0);
+            REQUIRE(ptr[i].value == 3.14);
+            REQUIRE(std::strcmp(ptr[i].ptr, "abc") == 0);
+        }
+        REQUIRE(static_cast<unsigned char>(*end) == 0xFFu);
+    }
+}
+
 TEST_CASE("uninitialized_move/move_if_noexcept/copy for trivial type", "[core]")
 {
     struct test_type
@@ -471,6 +527,41 @@ TEST_CASE("uninitialized_move_convert", "[core]")
     }
 }
 
+TEST_CASE("uninitialized_copy/move_convert for arithmetic type", "[core]")
+{
+    int array[] = {-2, 0, 1, 1000};
+
+    std::aligned_storage<4 * sizeof(double)>::type storage{};
+    auto block = memory_block(to_raw_pointer(&storage), 4 * sizeof(double));
+
+    raw_pointer end;
+    SECTION("same type")
+    {
+        double doubles[] = {-2.0, 0.0, 1.0, 1000.0};
+        end = uninitialized_copy_convert<double>(std::begin(doubles), std::end(doubles), block);
+    }
+    SECTION("uninitialized_copy_convert")
+    {
+        end = uninitialized_copy_convert<double>(std::begin(array), std::end(array), block);
+    }
+    SECTION("uninitialized_move_convert")
+    {
+        end = uninitialized_move_convert<double>(std::begin(array), std::end(array), block);
+    }
+    SECTION("non-contiguous iterator")
+    {
+        std::list<int> list(std::begin(array), std::end(array));
+        end = uninitialized_copy_convert<double>(list.begin(), list.end(), block);
+    }
+    REQUIRE(end == block.end());
+
+    auto ptr = to_pointer<double>(block.begin());
+    REQUIRE(ptr[0] == -2.0);
+    REQUIRE(ptr[1] == 0.0);
+    REQUIRE(ptr[2] == 1.0);
+    REQUIRE(ptr[3] == 1000.0);
+}
+
 TEST_CASE("uninitialized_destructive_move", "[core]")
 {
     leak_checker checker;
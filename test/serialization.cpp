@@ -0,0 +1,312 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/array/serialization.hpp>
+
+#include <algorithm>
+#include <string>
+
+#include <catch.hpp>
+
+#include <foonathan/array/block_storage_sbo.hpp>
+
+#include "leak_checker.hpp"
+
+using namespace foonathan::array;
+
+namespace
+{
+    // writes the integers bitwise with the given flags, whether they are correct or not
+    void write_unchecked(memory_writer<>& writer, std::initializer_list<int> ints,
+                         std::uint32_t flags)
+    {
+        serialization_header header{ints.size(), sizeof(int), flags};
+        auto header_bytes = byte_view(block_view<const serialization_header>(&header, 1u));
+        writer.write(header_bytes.data(), header_bytes.size());
+
+        auto int_bytes = byte_view(block_view<const int>(ints.begin(), ints.size()));
+        writer.write(int_bytes.data(), int_bytes.size());
+    }
+
+    struct test_type : leak_tracked
+    {
+        int id;
+
+        test_type(int i) : id(i) {}
+    };
+
+    // a codec that writes integers as a single byte
+    struct narrow_codec
+    {
+        template <typename T>
+        static constexpr bool is_bitwise() noexcept
+        {
+            return false;
+        }
+
+        template <class Writer>
+        static void write(Writer& writer, int i)
+        {
+            auto b = byte(i);
+            writer.write(&b, 1u);
+        }
+
+        template <typename T, class Reader>
+        static T read(Reader& reader)
+        {
+            byte b;
+            reader.read(&b, 1u);
+            return T(b);
+        }
+    };
+
+    template <class Container>
+    Container round_trip(const Container& container)
+    {
+        memory_writer<> writer;
+        serialize(writer, container);
+
+        memory_reader reader(writer.bytes());
+        auto          result = deserialize<Container>(reader);
+        REQUIRE(reader.remaining() == 0u);
+        return result;
+    }
+} // namespace
+
+namespace foonathan
+{
+    namespace array
+    {
+        template <>
+        struct codec_default::customize_for<test_type>
+        {
+            template <class Writer>
+            static void write(Writer& writer, const test_type& obj)
+            {
+                codec_default::write(writer, obj.id);
+            }
+
+            template <class Reader>
+            static test_type read(Reader& reader)
+            {
+                return test_type(codec_default::read<int>(reader));
+            }
+        };
+    } // namespace array
+} // namespace foonathan
+
+TEST_CASE("serialization array", "[serialization]")
+{
+    array<int> arr;
+    for (auto i = 0; i != 100; ++i)
+        arr.push_back(i * 7 % 13);
+
+    memory_writer<> writer;
+    serialize(writer, arr);
+    REQUIRE(writer.bytes().size() == sizeof(serialization_header) + 100u * sizeof(int));
+
+    memory_reader reader(writer.bytes());
+    auto          result = deserialize<array<int>>(reader);
+    REQUIRE(reader.remaining() == 0u);
+    REQUIRE(std::equal(result.begin(), result.end(), arr.begin()));
+
+    SECTION("other block storage")
+    {
+        using sbo_array = array<int, block_storage_sbo<64, block_storage_default>>;
+
+        memory_reader sbo_reader(writer.bytes());
+        auto          sbo = deserialize<sbo_array>(sbo_reader);
+        REQUIRE(std::equal(sbo.begin(), sbo.end(), arr.begin()));
+
+        auto small = round_trip(sbo_array({1, 2, 3}));
+        REQUIRE(small.size() == 3u);
+        REQUIRE(small[2] == 3);
+    }
+    SECTION("empty")
+    {
+        auto empty = round_trip(array<int>());
+        REQUIRE(empty.empty());
+    }
+    SECTION("custom codec")
+    {
+        memory_writer<> narrow_writer;
+        serialize<narrow_codec>(narrow_writer, arr);
+        REQUIRE(narrow_writer.bytes().size() == sizeof(serialization_header) + 100u);
+
+        memory_reader narrow_reader(narrow_writer.bytes());
+        auto          narrow = deserialize<array<int>, narrow_codec>(narrow_reader);
+        REQUIRE(std::equal(narrow.begin(), narrow.end(), arr.begin()));
+
+        // element size doesn't match
+        memory_reader mismatch(narrow_writer.bytes());
+        REQUIRE_THROWS_AS(deserialize<array<int>>(mismatch), serialization_error);
+    }
+    SECTION("element size mismatch")
+    {
+        REQUIRE_THROWS_AS(deserialize<array<short>>(reader), serialization_error);
+    }
+    SECTION("truncated")
+    {
+        auto          bytes = array_view<const byte>(writer.bytes());
+        memory_reader truncated(array_view<const byte>(bytes.data(), bytes.size() - 1u));
+        REQUIRE_THROWS_AS(deserialize<array<int>>(truncated), serialization_error);
+    }
+}
+
+TEST_CASE("serialization per element", "[serialization]")
+{
+    leak_checker checker;
+
+    bag<test_type> b;
+    for (auto i = 0; i != 50; ++i)
+        b.emplace(i);
+
+    memory_writer<> writer;
+    serialize(writer, b);
+    REQUIRE(writer.bytes().size() == sizeof(serialization_header) + 50u * sizeof(int));
+
+    {
+        memory_reader reader(writer.bytes());
+        auto          result = deserialize<bag<test_type>>(reader);
+        REQUIRE(result.size() == 50u);
+        auto i = 0;
+        for (auto& element : result)
+            REQUIRE(element.id == i++);
+    }
+
+    // fails half-way through
+    auto          bytes = array_view<const byte>(writer.bytes());
+    memory_reader truncated(array_view<const byte>(bytes.data(), bytes.size() - 10u));
+    REQUIRE_THROWS_AS(deserialize<bag<test_type>>(truncated), serialization_error);
+}
+
+TEST_CASE("serialization flat_set", "[serialization]")
+{
+    flat_set<std::string> set;
+    for (auto i = 0; i != 50; ++i)
+        set.insert(std::to_string(i * 7 % 31));
+
+    auto result = round_trip(set);
+    REQUIRE(std::equal(result.begin(), result.end(), set.begin()));
+    REQUIRE(result.contains("3"));
+
+    SECTION("multiset")
+    {
+        flat_set<int, key_compare_default, block_storage_default, true> multi;
+        for (auto i = 0; i != 50; ++i)
+            multi.insert(i % 7);
+
+        auto multi_result = round_trip(multi);
+        REQUIRE(std::equal(multi_result.begin(), multi_result.end(), multi.begin()));
+        REQUIRE(multi_result.count(3) == 7u);
+
+        // not unique, so the set has to sort and remove duplicates
+        memory_writer<> writer;
+        serialize(writer, multi);
+        memory_reader reader(writer.bytes());
+        auto          unique = deserialize<flat_set<int>>(reader);
+        REQUIRE(unique.size() == 7u);
+    }
+    SECTION("unsorted")
+    {
+        memory_writer<> writer;
+        serialize(writer, array<int>({3, 1, 2, 1}));
+
+        memory_reader reader(writer.bytes());
+        auto          sorted = deserialize<flat_set<int>>(reader);
+        REQUIRE(sorted.size() == 3u);
+        REQUIRE(sorted.min() == 1);
+        REQUIRE(sorted.max() == 3);
+    }
+    SECTION("wrong flags")
+    {
+        // the header claims sorted and unique keys, but they aren't
+        memory_writer<> writer;
+        write_unchecked(writer, {3, 1, 2, 2}, serialization_sorted | serialization_unique);
+
+        memory_reader reader(writer.bytes());
+        auto          sorted = deserialize<flat_set<int>>(reader);
+        REQUIRE(sorted.size() == 3u);
+        REQUIRE(std::is_sorted(sorted.begin(), sorted.end()));
+        REQUIRE(sorted.contains(1));
+        REQUIRE(sorted.contains(2));
+        REQUIRE(sorted.contains(3));
+    }
+}
+
+TEST_CASE("serialization flat_map", "[serialization]")
+{
+    using map = flat_map<int, std::string>;
+    using aos_map =
+        flat_map<int, std::string, key_compare_default, block_storage_default, false,
+                 array_of_structs_layout>;
+    using single_map = flat_map<int, int, key_compare_default, block_storage_default, false,
+                                single_block_layout>;
+
+    map m;
+    for (auto i = 0; i != 50; ++i)
+        m.try_emplace(i * 7 % 31, std::to_string(i));
+
+    auto verify = [&](const map::key_type& key, const std::string& value) {
+        REQUIRE(m.lookup(key) == value);
+    };
+
+    auto result = round_trip(m);
+    REQUIRE(result.size() == m.size());
+    for (auto pair : result)
+        verify(pair.key, pair.value);
+
+    // same format for every layout
+    memory_writer<> writer;
+    serialize(writer, m);
+    memory_reader reader(writer.bytes());
+    auto          aos = deserialize<aos_map>(reader);
+    REQUIRE(aos.size() == m.size());
+    for (auto pair : aos)
+        verify(pair.key, pair.value);
+
+    memory_writer<> aos_writer;
+    serialize(aos_writer, aos);
+    REQUIRE(aos_writer.bytes().size() == writer.bytes().size());
+    REQUIRE(std::equal(aos_writer.bytes().begin(), aos_writer.bytes().end(),
+                       writer.bytes().begin()));
+
+    single_map single;
+    for (auto i = 0; i != 50; ++i)
+        single.try_emplace(i * 7 % 31, i);
+    auto single_result = round_trip(single);
+    REQUIRE(single_result.size() == single.size());
+    REQUIRE(std::equal(single_result.value_begin(), single_result.value_end(),
+                       single.value_begin()));
+
+    // keys without values
+    memory_writer<> keys_writer;
+    serialize(keys_writer, array<int>({1, 2, 3}));
+    memory_reader keys_reader(keys_writer.bytes());
+    REQUIRE_THROWS_AS(deserialize<map>(keys_reader), serialization_error);
+
+    // duplicate keys despite the unique flag
+    memory_writer<> dup_writer;
+    write_unchecked(dup_writer, {1, 2, 2, 3}, serialization_sorted | serialization_unique);
+    serialize(dup_writer, array<std::string>({"a", "b", "c", "d"}));
+    memory_reader dup_reader(dup_writer.bytes());
+    auto          dup = deserialize<map>(dup_reader);
+    REQUIRE(dup.size() == 3u);
+    REQUIRE(dup.lookup(2) == "b");
+    REQUIRE(dup.lookup(3) == "d");
+
+    // unsorted keys are sorted together with their values
+    memory_writer<> unsorted_writer;
+    serialize(unsorted_writer, array<int>({30, 10, 20, 10}));
+    serialize(unsorted_writer, array<std::string>({"c", "a", "b", "x"}));
+    memory_reader unsorted_reader(unsorted_writer.bytes());
+    auto          unsorted = deserialize<aos_map>(unsorted_reader);
+    REQUIRE(unsorted.size() == 3u);
+    REQUIRE(unsorted.nth(0u).key == 10);
+    REQUIRE(unsorted.nth(0u).value == "a");
+    REQUIRE(unsorted.nth(1u).key == 20);
+    REQUIRE(unsorted.nth(1u).value == "b");
+    REQUIRE(unsorted.nth(2u).key == 30);
+    REQUIRE(unsorted.nth(2u).value == "c");
+}